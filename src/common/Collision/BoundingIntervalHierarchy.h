@@ -104,6 +104,131 @@ public:
 
     template<typename RayCallback>
     void intersectRay(const G3D::Ray& r, RayCallback& intersectCallback, float& maxDist, bool stopAtFirstHit) const
+    {
+        auto leafCallback = [&](uint32 first, uint32 count) -> bool
+        {
+            for (uint32 slot = first; slot < first + count; ++slot)
+            {
+                bool hit = intersectCallback(r, objects[slot], maxDist, stopAtFirstHit);
+                if (stopAtFirstHit && hit)
+                    return true;
+            }
+            return false;
+        };
+        traverseRay(r, leafCallback, maxDist);
+    }
+
+    /** Same traversal as intersectRay, but the callback gets the objects of a leaf at once, as the range of slots
+        [firstSlot, firstSlot + count) of getObjectIndices():
+        bool leafCallback(const G3D::Ray& ray, uint32 firstSlot, uint32 count, float& maxDist, bool stopAtFirstHit)
+        Primitives stored in slot order can be tested with a packed kernel this way. */
+    template<typename LeafCallback>
+    void intersectRayLeaves(const G3D::Ray& r, LeafCallback& leafCallback, float& maxDist, bool stopAtFirstHit) const
+    {
+        auto callback = [&](uint32 first, uint32 count) -> bool
+        {
+            bool hit = leafCallback(r, first, count, maxDist, stopAtFirstHit);
+            return stopAtFirstHit && hit;
+        };
+        traverseRay(r, callback, maxDist);
+    }
+
+    //! object index of every slot, the objects of a leaf have consecutive slots
+    [[nodiscard]] const std::vector<uint32>& getObjectIndices() const { return objects; }
+
+    template<typename IsectCallback>
+    void intersectPoint(const G3D::Vector3& p, IsectCallback& intersectCallback) const
+    {
+        if (!bounds.contains(p))
+            return;
+
+        StackNode stack[MAX_STACK_SIZE];
+        int stackPos = 0;
+        int node = 0;
+
+        while (true)
+        {
+            while (true)
+            {
+                uint32 tn = tree[node];
+                uint32 axis = (tn & (3 << 30)) >> 30;
+                bool BVH2 = tn & (1 << 29);
+                int offset = tn & ~(7 << 29);
+                if (!BVH2)
+                {
+                    if (axis < 3)
+                    {
+                        // "normal" interior node
+                        float tl = intBitsToFloat(tree[node + 1]);
+                        float tr = intBitsToFloat(tree[node + 2]);
+                        // point is between clip zones
+                        if (tl < p[axis] && tr > p[axis])
+                            break;
+                        int right = offset + 3;
+                        node = right;
+                        // point is in right node only
+                        if (tl < p[axis])
+                        {
+                            continue;
+                        }
+                        node = offset; // left
+                        // point is in left node only
+                        if (tr > p[axis])
+                        {
+                            continue;
+                        }
+                        // point is in both nodes
+                        // push back right node
+                        stack[stackPos].node = right;
+                        stackPos++;
+                        continue;
+                    }
+                    else
+                    {
+                        // leaf - test some objects
+                        int n = tree[node + 1];
+                        while (n > 0)
+                        {
+                            intersectCallback(p, objects[offset]); // !!!
+                            --n;
+                            ++offset;
+                        }
+                        break;
+                    }
+                }
+                else // BVH2 node (empty space cut off left and right)
+                {
+                    if (axis > 2)
+                        return; // should not happen
+                    float tl = intBitsToFloat(tree[node + 1]);
+                    float tr = intBitsToFloat(tree[node + 2]);
+                    node = offset;
+                    if (tl > p[axis] || tr < p[axis])
+                        break;
+                    continue;
+                }
+            } // traversal loop
+
+            // stack is empty?
+            if (stackPos == 0)
+                return;
+            // move back up the stack
+            stackPos--;
+            node = stack[stackPos].node;
+        }
+    }
+
+    bool writeToFile(FILE* wf) const;
+    bool readFromFile(FILE* rf);
+
+protected:
+    std::vector<uint32> tree;
+    std::vector<uint32> objects;
+    G3D::AABox bounds;
+
+    // leafCallback(firstSlot, count) returns true to end the traversal
+    template<typename LeafCallback>
+    void traverseRay(const G3D::Ray& r, LeafCallback& leafCallback, float& maxDist) const
     {
         float intervalMin = -1.f;
         float intervalMax = -1.f;
@@ -204,13 +329,8 @@ public:
                     {
                         // leaf - test some objects
                         int n = tree[node + 1];
-                        while (n > 0)
-                        {
-                            bool hit = intersectCallback(r, objects[offset], maxDist, stopAtFirstHit);
-                            if (stopAtFirstHit && hit) return;
-                            --n;
-                            ++offset;
-                        }
+                        if (n > 0 && leafCallback(uint32(offset), uint32(n)))
+                            return;
                         break;
                     }
                 }
@@ -245,96 +365,6 @@ public:
         }
     }
 
-    template<typename IsectCallback>
-    void intersectPoint(const G3D::Vector3& p, IsectCallback& intersectCallback) const
-    {
-        if (!bounds.contains(p))
-            return;
-
-        StackNode stack[MAX_STACK_SIZE];
-        int stackPos = 0;
-        int node = 0;
-
-        while (true)
-        {
-            while (true)
-            {
-                uint32 tn = tree[node];
-                uint32 axis = (tn & (3 << 30)) >> 30;
-                bool BVH2 = tn & (1 << 29);
-                int offset = tn & ~(7 << 29);
-                if (!BVH2)
-                {
-                    if (axis < 3)
-                    {
-                        // "normal" interior node
-                        float tl = intBitsToFloat(tree[node + 1]);
-                        float tr = intBitsToFloat(tree[node + 2]);
-                        // point is between clip zones
-                        if (tl < p[axis] && tr > p[axis])
-                            break;
-                        int right = offset + 3;
-                        node = right;
-                        // point is in right node only
-                        if (tl < p[axis])
-                        {
-                            continue;
-                        }
-                        node = offset; // left
-                        // point is in left node only
-                        if (tr > p[axis])
-                        {
-                            continue;
-                        }
-                        // point is in both nodes
-                        // push back right node
-                        stack[stackPos].node = right;
-                        stackPos++;
-                        continue;
-                    }
-                    else
-                    {
-                        // leaf - test some objects
-                        int n = tree[node + 1];
-                        while (n > 0)
-                        {
-                            intersectCallback(p, objects[offset]); // !!!
-                            --n;
-                            ++offset;
-                        }
-                        break;
-                    }
-                }
-                else // BVH2 node (empty space cut off left and right)
-                {
-                    if (axis > 2)
-                        return; // should not happen
-                    float tl = intBitsToFloat(tree[node + 1]);
-                    float tr = intBitsToFloat(tree[node + 2]);
-                    node = offset;
-                    if (tl > p[axis] || tr < p[axis])
-                        break;
-                    continue;
-                }
-            } // traversal loop
-
-            // stack is empty?
-            if (stackPos == 0)
-                return;
-            // move back up the stack
-            stackPos--;
-            node = stack[stackPos].node;
-        }
-    }
-
-    bool writeToFile(FILE* wf) const;
-    bool readFromFile(FILE* rf);
-
-protected:
-    std::vector<uint32> tree;
-    std::vector<uint32> objects;
-    G3D::AABox bounds;
-
     struct buildData
     {
         uint32* indices;
@@ -8,6 +8,7 @@
 #define _IVMAPMANAGER_H
 
 #include <string>
+#include <vector>
 #include "Define.h"
 
 //===========================================================
@@ -29,6 +30,14 @@ namespace VMAP
 #define VMAP_INVALID_HEIGHT       -100000.0f            // for check
 #define VMAP_INVALID_HEIGHT_VALUE -200000.0f            // real assigned value in unknown height case
 
+    struct LineOfSightRay
+    {
+        float x1, y1, z1;
+        float x2, y2, z2;
+        uint32 phaseMask;       // not used by vmaps, for the gameobject check of Map::isInLineOfSight
+        bool inLineOfSight;
+    };
+
     //===========================================================
     class IVMapManager
     {
@@ -49,6 +58,10 @@ namespace VMAP
         virtual void unloadMap(unsigned int pMapId) = 0;
 
         virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2) = 0;
+        /**
+        line of sight of many rays on one map (area target selection), sets inLineOfSight of every ray
+        */
+        virtual void isInLineOfSight(unsigned int pMapId, std::vector<LineOfSightRay>& rays) = 0;
         virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
         /**
         test if we hit an object. return true if we hit one. rx, ry, rz will hold the hit position or the dest position, if no intersection was found
@@ -10,6 +10,24 @@
 
 namespace MMAP
 {
+    namespace
+    {
+        // query of the current thread, rebound whenever the thread works on another map
+        struct ThreadNavMeshQuery
+        {
+            ~ThreadNavMeshQuery()
+            {
+                if (query)
+                    dtFreeNavMeshQuery(query);
+            }
+
+            dtNavMeshQuery* query{nullptr};
+            dtNavMesh const* navMesh{nullptr};
+        };
+
+        thread_local ThreadNavMeshQuery t_navMeshQuery;
+    }
+
     // ######################## MMapManager ########################
     MMapManager::~MMapManager()
     {
@@ -289,40 +307,6 @@ namespace MMAP
         return true;
     }
 
-    bool MMapManager::unloadMapInstance(uint32 mapId, uint32 instanceId)
-    {
-        ACORE_WRITE_GUARD(ACE_RW_Thread_Mutex, MMapManagerLock);
-
-        // check if we have this map loaded
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
-        {
-            // file may not exist, therefore not loaded
-#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-            sLog->outDebug(LOG_FILTER_MAPS, "MMAP:unloadMapInstance: Asked to unload not loaded navmesh map %03u", mapId);
-#endif
-            return false;
-        }
-
-        MMapData* mmap = loadedMMaps[mapId];
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
-        {
-#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-            sLog->outDebug(LOG_FILTER_MAPS, "MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId %03u instanceId %u", mapId, instanceId);
-#endif
-            return false;
-        }
-
-        dtNavMeshQuery* query = mmap->navMeshQueries[instanceId];
-
-        dtFreeNavMeshQuery(query);
-        mmap->navMeshQueries.erase(instanceId);
-#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-        sLog->outDetail("MMAP:unloadMapInstance: Unloaded mapId %03u instanceId %u", mapId, instanceId);
-#endif
-
-        return true;
-    }
-
     dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
     {
         // pussywizard: moved to calling function
@@ -334,39 +318,35 @@ namespace MMAP
         return loadedMMaps[mapId]->navMesh;
     }
 
-    dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
+    dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId)
     {
         // pussywizard: moved to calling function
         //ACORE_READ_GUARD(ACE_RW_Thread_Mutex, MMapManagerLock);
 
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
+        MMapDataSet::const_iterator itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end())
             return nullptr;
 
-        MMapData* mmap = loadedMMaps[mapId];
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+        ThreadNavMeshQuery& threadQuery = t_navMeshQuery;
+        if (!threadQuery.query)
         {
-            // pussywizard: different instances of the same map shouldn't access this simultaneously
-            ACORE_WRITE_GUARD(ACE_RW_Thread_Mutex, GetMMapLock(mapId));
-            // check again after acquiring mutex
-            if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
-            {
-                // allocate mesh query
-                dtNavMeshQuery* query = dtAllocNavMeshQuery();
-                ASSERT(query);
-                if (DT_SUCCESS != query->init(mmap->navMesh, 1024))
-                {
-                    dtFreeNavMeshQuery(query);
-                    sLog->outError("MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-                    return nullptr;
-                }
+            threadQuery.query = dtAllocNavMeshQuery();
+            ASSERT(threadQuery.query);
+        }
 
-#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-                sLog->outDetail("MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-#endif
-                mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(instanceId, query));
+        // init keeps the node pools allocated, rebinding only clears them
+        if (threadQuery.navMesh != itr->second->navMesh)
+        {
+            if (DT_SUCCESS != threadQuery.query->init(itr->second->navMesh, 1024))
+            {
+                threadQuery.navMesh = nullptr;
+                sLog->outError("MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u", mapId);
+                return nullptr;
             }
+
+            threadQuery.navMesh = itr->second->navMesh;
         }
 
-        return mmap->navMeshQueries[instanceId];
+        return threadQuery.query;
     }
 }
@@ -155,6 +155,31 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::isInLineOfSight(unsigned int mapId, std::vector<LineOfSightRay>& rays)
+    {
+        for (LineOfSightRay& ray : rays)
+            ray.inLineOfSight = true;
+
+#if defined(ENABLE_EXTRAS) && defined(ENABLE_VMAP_CHECKS)
+        if (!isLineOfSightCalcEnabled() || DisableMgr::IsDisabledFor(DISABLE_TYPE_VMAP, mapId, nullptr, VMAP_DISABLE_LOS))
+            return;
+#endif
+
+        // one tree lookup for all rays, every ray still walks the tree on its own:
+        // rays of an area fan out in all directions, they do not share a traversal order
+        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        for (LineOfSightRay& ray : rays)
+        {
+            Vector3 pos1 = convertPositionToInternalRep(ray.x1, ray.y1, ray.z1);
+            Vector3 pos2 = convertPositionToInternalRep(ray.x2, ray.y2, ray.z2);
+            if (pos1 != pos2)
+                ray.inLineOfSight = instanceTree->second->isInLineOfSight(pos1, pos2);
+        }
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
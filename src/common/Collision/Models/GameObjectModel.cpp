@@ -8,6 +8,7 @@
 #include "VMapManager2.h"
 #include "VMapDefinitions.h"
 #include "WorldModel.h"
+#include "RayKernels.h"
 
 #include "GameObjectModel.h"
 #include "Log.h"
@@ -171,8 +172,7 @@ bool GameObjectModel::intersectRay(const G3D::Ray& ray, float& MaxDist, bool Sto
     if (!(phasemask & ph_mask) || !owner->isSpawned())
         return false;
 
-    float time = ray.intersectionTime(iBound);
-    if (time == G3D::inf())
+    if (!VMAP::IntersectRayAABox(ray, iBound, MaxDist))
         return false;
 
     // child bounds are defined in object space:
@@ -7,6 +7,7 @@
 #include "ModelInstance.h"
 #include "WorldModel.h"
 #include "MapTree.h"
+#include "RayKernels.h"
 #include "VMapDefinitions.h"
 
 using G3D::Vector3;
@@ -27,8 +28,7 @@ namespace VMAP
             //std::cout << "<object not loaded>\n";
             return false;
         }
-        float time = pRay.intersectionTime(iBound);
-        if (time == G3D::inf())
+        if (!IntersectRayAABox(pRay, iBound, pMaxDist))
         {
             //            std::cout << "Ray does not hit '" << name << "'\n";
 
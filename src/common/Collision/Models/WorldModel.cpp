@@ -245,7 +245,7 @@ namespace VMAP
 
     GroupModel::GroupModel(const GroupModel& other):
         iBound(other.iBound), iMogpFlags(other.iMogpFlags), iGroupWMOID(other.iGroupWMOID),
-        vertices(other.vertices), triangles(other.triangles), meshTree(other.meshTree), iLiquid(0)
+        vertices(other.vertices), triangles(other.triangles), meshTree(other.meshTree), packedTriangles(other.packedTriangles), iLiquid(0)
     {
         if (other.iLiquid)
             iLiquid = new WmoLiquid(*other.iLiquid);
@@ -257,6 +257,7 @@ namespace VMAP
         triangles.swap(tri);
         TriBoundFunc bFunc(vertices);
         meshTree.build(triangles, bFunc);
+        packedTriangles.build(vertices, triangles, meshTree.getObjectIndices());
     }
 
     bool GroupModel::writeToFile(FILE* wf)
@@ -313,6 +314,7 @@ namespace VMAP
         uint32 count = 0;
         triangles.clear();
         vertices.clear();
+        packedTriangles.clear();
         delete iLiquid;
         iLiquid = nullptr;
 
@@ -339,6 +341,7 @@ namespace VMAP
         // read mesh BIH
         if (result && !readChunk(rf, chunk, "MBIH", 4)) result = false;
         if (result) result = meshTree.readFromFile(rf);
+        if (result) packedTriangles.build(vertices, triangles, meshTree.getObjectIndices());
 
         // write liquid data
         if (result && !readChunk(rf, chunk, "LIQU", 4)) result = false;
@@ -363,11 +366,31 @@ namespace VMAP
         bool hit;
     };
 
+    struct GModelLeafCallback
+    {
+        GModelLeafCallback(const TrianglePack& tris): triangles(tris), hit(false) { }
+        bool operator()(const G3D::Ray& ray, uint32 firstSlot, uint32 count, float& distance, bool /*StopAtFirstHit*/)
+        {
+            bool result = triangles.intersectRay(ray, firstSlot, count, distance);
+            if (result)  hit = true;
+            return hit;
+        }
+        const TrianglePack& triangles;
+        bool hit;
+    };
+
     bool GroupModel::IntersectRay(const G3D::Ray& ray, float& distance, bool stopAtFirstHit) const
     {
         if (triangles.empty())
             return false;
 
+        if (GetRayKernel() != RAY_KERNEL_NONE && packedTriangles.size() == meshTree.primCount())
+        {
+            GModelLeafCallback callback(packedTriangles);
+            meshTree.intersectRayLeaves(ray, callback, distance, stopAtFirstHit);
+            return callback.hit;
+        }
+
         GModelRayCallback callback(triangles, vertices);
         meshTree.intersectRay(ray, callback, distance, stopAtFirstHit);
         return callback.hit;
@@ -12,6 +12,7 @@
 #include <G3D/AABox.h>
 #include <G3D/Ray.h>
 #include "BoundingIntervalHierarchy.h"
+#include "RayKernels.h"
 
 #include "Define.h"
 
@@ -87,6 +88,7 @@ namespace VMAP
         std::vector<G3D::Vector3> vertices;
         std::vector<MeshTriangle> triangles;
         BIH meshTree;
+        TrianglePack packedTriangles; //!< triangles in meshTree slot order, for ray tests of whole leaves
         WmoLiquid* iLiquid{nullptr};
     public:
         void getMeshData(std::vector<G3D::Vector3>& vertices, std::vector<MeshTriangle>& triangles, WmoLiquid*& liquid);
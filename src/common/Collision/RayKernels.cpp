@@ -0,0 +1,409 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "RayKernels.h"
+#include "WorldModel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VMAP_RAY_KERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define VMAP_TARGET_AVX
+#else
+#define VMAP_TARGET_AVX __attribute__((target("avx")))
+#endif
+#endif
+
+using G3D::Vector3;
+
+namespace VMAP
+{
+    namespace
+    {
+        // same epsilon as IntersectTriangle
+        float const TriangleEps = 1e-5f;
+
+        // whole vector loads may read this far past the last triangle
+        uint32 const PackPadding = 8;
+
+        typedef bool(*PackKernel)(const TrianglePack& pack, const G3D::Ray& ray, uint32 first, uint32 num, float& distance);
+
+        bool IntersectPackScalar(const TrianglePack& pack, const G3D::Ray& ray, uint32 first, uint32 num, float& distance)
+        {
+            const Vector3& org = ray.origin();
+            const Vector3& dir = ray.direction();
+            bool hit = false;
+
+            for (uint32 i = first; i < first + num; ++i)
+            {
+                const Vector3 v0(pack.component(TrianglePack::V0_X)[i], pack.component(TrianglePack::V0_Y)[i], pack.component(TrianglePack::V0_Z)[i]);
+                const Vector3 e1(pack.component(TrianglePack::E1_X)[i], pack.component(TrianglePack::E1_Y)[i], pack.component(TrianglePack::E1_Z)[i]);
+                const Vector3 e2(pack.component(TrianglePack::E2_X)[i], pack.component(TrianglePack::E2_Y)[i], pack.component(TrianglePack::E2_Z)[i]);
+
+                const Vector3 p(dir.cross(e2));
+                const float a = e1.dot(p);
+                if (fabs(a) < TriangleEps)
+                    continue;
+
+                const float f = 1.0f / a;
+                const Vector3 s(org - v0);
+                const float u = f * s.dot(p);
+                if ((u < 0.0f) || (u > 1.0f))
+                    continue;
+
+                const Vector3 q(s.cross(e1));
+                const float v = f * dir.dot(q);
+                if ((v < 0.0f) || ((u + v) > 1.0f))
+                    continue;
+
+                const float t = f * e2.dot(q);
+                if ((t > 0.0f) && (t < distance))
+                {
+                    distance = t;
+                    hit = true;
+                }
+            }
+
+            return hit;
+        }
+
+#ifdef VMAP_RAY_KERNELS_X86
+        inline float HorizontalMin(__m128 v)
+        {
+            v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+            v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+            return _mm_cvtss_f32(v);
+        }
+
+        inline float HorizontalMax(__m128 v)
+        {
+            v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+            v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+            return _mm_cvtss_f32(v);
+        }
+
+        // 4 triangles per step
+        bool IntersectPackSSE2(const TrianglePack& pack, const G3D::Ray& ray, uint32 first, uint32 num, float& distance)
+        {
+            __m128 const ox = _mm_set1_ps(ray.origin().x);
+            __m128 const oy = _mm_set1_ps(ray.origin().y);
+            __m128 const oz = _mm_set1_ps(ray.origin().z);
+            __m128 const dx = _mm_set1_ps(ray.direction().x);
+            __m128 const dy = _mm_set1_ps(ray.direction().y);
+            __m128 const dz = _mm_set1_ps(ray.direction().z);
+            __m128 const zero = _mm_setzero_ps();
+            __m128 const one = _mm_set1_ps(1.0f);
+            __m128 const eps = _mm_set1_ps(TriangleEps);
+            __m128 const absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+            __m128 const inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+            __m128i const laneIndex = _mm_setr_epi32(0, 1, 2, 3);
+
+            float best = distance;
+            bool hit = false;
+
+            for (uint32 i = 0; i < num; i += 4)
+            {
+                uint32 const slot = first + i;
+                __m128 const v0x = _mm_loadu_ps(pack.component(TrianglePack::V0_X) + slot);
+                __m128 const v0y = _mm_loadu_ps(pack.component(TrianglePack::V0_Y) + slot);
+                __m128 const v0z = _mm_loadu_ps(pack.component(TrianglePack::V0_Z) + slot);
+                __m128 const e1x = _mm_loadu_ps(pack.component(TrianglePack::E1_X) + slot);
+                __m128 const e1y = _mm_loadu_ps(pack.component(TrianglePack::E1_Y) + slot);
+                __m128 const e1z = _mm_loadu_ps(pack.component(TrianglePack::E1_Z) + slot);
+                __m128 const e2x = _mm_loadu_ps(pack.component(TrianglePack::E2_X) + slot);
+                __m128 const e2y = _mm_loadu_ps(pack.component(TrianglePack::E2_Y) + slot);
+                __m128 const e2z = _mm_loadu_ps(pack.component(TrianglePack::E2_Z) + slot);
+
+                // p = dir x e2, a = e1 . p
+                __m128 const px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+                __m128 const py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+                __m128 const pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+                __m128 const a = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+
+                // lanes past the leaf hold other (or padding) triangles
+                __m128 mask = _mm_castsi128_ps(_mm_cmplt_epi32(laneIndex, _mm_set1_epi32(int32(num - i))));
+                mask = _mm_and_ps(mask, _mm_cmpge_ps(_mm_and_ps(a, absMask), eps));
+
+                __m128 const f = _mm_div_ps(one, a);
+                __m128 const sx = _mm_sub_ps(ox, v0x);
+                __m128 const sy = _mm_sub_ps(oy, v0y);
+                __m128 const sz = _mm_sub_ps(oz, v0z);
+                __m128 const u = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)));
+                mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+
+                // q = s x e1
+                __m128 const qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+                __m128 const qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+                __m128 const qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+                __m128 const v = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)));
+                mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+
+                __m128 const t = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)));
+                mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpgt_ps(t, zero), _mm_cmplt_ps(t, _mm_set1_ps(best))));
+
+                if (_mm_movemask_ps(mask))
+                {
+                    best = HorizontalMin(_mm_or_ps(_mm_and_ps(mask, t), _mm_andnot_ps(mask, inf)));
+                    hit = true;
+                }
+            }
+
+            if (hit)
+                distance = best;
+            return hit;
+        }
+
+        // 8 triangles per step, only selected if the cpu and os support avx
+        VMAP_TARGET_AVX bool IntersectPackAVX(const TrianglePack& pack, const G3D::Ray& ray, uint32 first, uint32 num, float& distance)
+        {
+            __m256 const ox = _mm256_set1_ps(ray.origin().x);
+            __m256 const oy = _mm256_set1_ps(ray.origin().y);
+            __m256 const oz = _mm256_set1_ps(ray.origin().z);
+            __m256 const dx = _mm256_set1_ps(ray.direction().x);
+            __m256 const dy = _mm256_set1_ps(ray.direction().y);
+            __m256 const dz = _mm256_set1_ps(ray.direction().z);
+            __m256 const zero = _mm256_setzero_ps();
+            __m256 const one = _mm256_set1_ps(1.0f);
+            __m256 const eps = _mm256_set1_ps(TriangleEps);
+            __m256 const absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+            __m256 const inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+            __m256 const laneIndex = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+
+            float best = distance;
+            bool hit = false;
+
+            for (uint32 i = 0; i < num; i += 8)
+            {
+                uint32 const slot = first + i;
+                __m256 const v0x = _mm256_loadu_ps(pack.component(TrianglePack::V0_X) + slot);
+                __m256 const v0y = _mm256_loadu_ps(pack.component(TrianglePack::V0_Y) + slot);
+                __m256 const v0z = _mm256_loadu_ps(pack.component(TrianglePack::V0_Z) + slot);
+                __m256 const e1x = _mm256_loadu_ps(pack.component(TrianglePack::E1_X) + slot);
+                __m256 const e1y = _mm256_loadu_ps(pack.component(TrianglePack::E1_Y) + slot);
+                __m256 const e1z = _mm256_loadu_ps(pack.component(TrianglePack::E1_Z) + slot);
+                __m256 const e2x = _mm256_loadu_ps(pack.component(TrianglePack::E2_X) + slot);
+                __m256 const e2y = _mm256_loadu_ps(pack.component(TrianglePack::E2_Y) + slot);
+                __m256 const e2z = _mm256_loadu_ps(pack.component(TrianglePack::E2_Z) + slot);
+
+                __m256 const px = _mm256_sub_ps(_mm256_mul_ps(dy, e2z), _mm256_mul_ps(dz, e2y));
+                __m256 const py = _mm256_sub_ps(_mm256_mul_ps(dz, e2x), _mm256_mul_ps(dx, e2z));
+                __m256 const pz = _mm256_sub_ps(_mm256_mul_ps(dx, e2y), _mm256_mul_ps(dy, e2x));
+                __m256 const a = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)), _mm256_mul_ps(e1z, pz));
+
+                __m256 mask = _mm256_cmp_ps(laneIndex, _mm256_set1_ps(float(num - i)), _CMP_LT_OQ);
+                mask = _mm256_and_ps(mask, _mm256_cmp_ps(_mm256_and_ps(a, absMask), eps, _CMP_GE_OQ));
+
+                __m256 const f = _mm256_div_ps(one, a);
+                __m256 const sx = _mm256_sub_ps(ox, v0x);
+                __m256 const sy = _mm256_sub_ps(oy, v0y);
+                __m256 const sz = _mm256_sub_ps(oz, v0z);
+                __m256 const u = _mm256_mul_ps(f, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sx, px), _mm256_mul_ps(sy, py)), _mm256_mul_ps(sz, pz)));
+                mask = _mm256_and_ps(mask, _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GE_OQ), _mm256_cmp_ps(u, one, _CMP_LE_OQ)));
+
+                __m256 const qx = _mm256_sub_ps(_mm256_mul_ps(sy, e1z), _mm256_mul_ps(sz, e1y));
+                __m256 const qy = _mm256_sub_ps(_mm256_mul_ps(sz, e1x), _mm256_mul_ps(sx, e1z));
+                __m256 const qz = _mm256_sub_ps(_mm256_mul_ps(sx, e1y), _mm256_mul_ps(sy, e1x));
+                __m256 const v = _mm256_mul_ps(f, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, qx), _mm256_mul_ps(dy, qy)), _mm256_mul_ps(dz, qz)));
+                mask = _mm256_and_ps(mask, _mm256_and_ps(_mm256_cmp_ps(v, zero, _CMP_GE_OQ), _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ)));
+
+                __m256 const t = _mm256_mul_ps(f, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)), _mm256_mul_ps(e2z, qz)));
+                mask = _mm256_and_ps(mask, _mm256_and_ps(_mm256_cmp_ps(t, zero, _CMP_GT_OQ), _mm256_cmp_ps(t, _mm256_set1_ps(best), _CMP_LT_OQ)));
+
+                if (_mm256_movemask_ps(mask))
+                {
+                    __m256 const hits = _mm256_blendv_ps(inf, t, mask);
+                    best = HorizontalMin(_mm_min_ps(_mm256_castps256_ps128(hits), _mm256_extractf128_ps(hits, 1)));
+                    hit = true;
+                }
+            }
+
+            if (hit)
+                distance = best;
+            return hit;
+        }
+
+        bool CpuSupportsAVX()
+        {
+#if defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 1);
+            bool const osxsave = (info[2] & (1 << 27)) != 0;
+            bool const avx = (info[2] & (1 << 28)) != 0;
+            // the os has to save the ymm registers on context switches
+            return osxsave && avx && (_xgetbv(0) & 6) == 6;
+#else
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx");
+#endif
+        }
+#endif
+
+        PackKernel const Kernels[MAX_RAY_KERNELS] =
+        {
+            &IntersectPackScalar, // GroupModel does not use the pack at all, other callers get the scalar loop
+            &IntersectPackScalar,
+#ifdef VMAP_RAY_KERNELS_X86
+            &IntersectPackSSE2,
+            &IntersectPackAVX
+#else
+            nullptr,
+            nullptr
+#endif
+        };
+
+        RayKernel SelectBestKernel()
+        {
+#ifdef VMAP_RAY_KERNELS_X86
+            return CpuSupportsAVX() ? RAY_KERNEL_AVX : RAY_KERNEL_SSE2;
+#else
+            return RAY_KERNEL_SCALAR;
+#endif
+        }
+
+        RayKernel& ActiveKernel()
+        {
+            static RayKernel kernel = SelectBestKernel();
+            return kernel;
+        }
+    }
+
+    void TrianglePack::build(const std::vector<Vector3>& vertices, const std::vector<MeshTriangle>& triangles, const std::vector<uint32>& order)
+    {
+        count = order.size();
+        stride = count + PackPadding;
+        // padding stays zero, a degenerate triangle that never passes the determinant test
+        data.assign(size_t(MAX_COMPONENTS) * stride, 0.0f);
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            const MeshTriangle& tri = triangles[order[i]];
+            const Vector3& v0 = vertices[tri.idx0];
+            // same edge computation as IntersectTriangle
+            const Vector3 e1 = vertices[tri.idx1] - v0;
+            const Vector3 e2 = vertices[tri.idx2] - v0;
+
+            data[V0_X * stride + i] = v0.x;
+            data[V0_Y * stride + i] = v0.y;
+            data[V0_Z * stride + i] = v0.z;
+            data[E1_X * stride + i] = e1.x;
+            data[E1_Y * stride + i] = e1.y;
+            data[E1_Z * stride + i] = e1.z;
+            data[E2_X * stride + i] = e2.x;
+            data[E2_Y * stride + i] = e2.y;
+            data[E2_Z * stride + i] = e2.z;
+        }
+    }
+
+    void TrianglePack::clear()
+    {
+        data.clear();
+        count = 0;
+        stride = 0;
+    }
+
+    bool TrianglePack::intersectRay(const G3D::Ray& ray, uint32 first, uint32 num, float& distance) const
+    {
+        if (!num)
+            return false;
+
+        return Kernels[ActiveKernel()](*this, ray, first, num, distance);
+    }
+
+    bool IntersectRayAABox(const G3D::Ray& ray, const G3D::AABox& box, float maxDist)
+    {
+        const Vector3& org = ray.origin();
+        const Vector3& dir = ray.direction();
+
+#ifdef VMAP_RAY_KERNELS_X86
+        // x, y, z slabs in one vector, the 4th lane does not restrict the interval
+        __m128 const o = _mm_setr_ps(org.x, org.y, org.z, 0.0f);
+        __m128 const invDir = _mm_div_ps(_mm_set1_ps(1.0f), _mm_setr_ps(dir.x, dir.y, dir.z, 1.0f));
+        __m128 const lo = _mm_setr_ps(box.low().x, box.low().y, box.low().z, -std::numeric_limits<float>::infinity());
+        __m128 const hi = _mm_setr_ps(box.high().x, box.high().y, box.high().z, std::numeric_limits<float>::infinity());
+
+        __m128 const t1 = _mm_mul_ps(_mm_sub_ps(lo, o), invDir);
+        __m128 const t2 = _mm_mul_ps(_mm_sub_ps(hi, o), invDir);
+        // 0 * inf for an axis parallel ray starting on a slab border, such an axis does not restrict the interval
+        __m128 const valid = _mm_cmpord_ps(t1, t2);
+        __m128 const tNear = _mm_or_ps(_mm_and_ps(valid, _mm_min_ps(t1, t2)), _mm_andnot_ps(valid, _mm_set1_ps(-std::numeric_limits<float>::infinity())));
+        __m128 const tFar = _mm_or_ps(_mm_and_ps(valid, _mm_max_ps(t1, t2)), _mm_andnot_ps(valid, _mm_set1_ps(std::numeric_limits<float>::infinity())));
+
+        float const enter = HorizontalMax(tNear);
+        float const exit = HorizontalMin(tFar);
+#else
+        float enter = -std::numeric_limits<float>::infinity();
+        float exit = std::numeric_limits<float>::infinity();
+        for (int i = 0; i < 3; ++i)
+        {
+            if (dir[i] == 0.0f)
+            {
+                if (org[i] < box.low()[i] || org[i] > box.high()[i])
+                    return false;
+                continue;
+            }
+
+            float const invDir = 1.0f / dir[i];
+            float t1 = (box.low()[i] - org[i]) * invDir;
+            float t2 = (box.high()[i] - org[i]) * invDir;
+            if (t1 > t2)
+                std::swap(t1, t2);
+            enter = std::max(enter, t1);
+            exit = std::min(exit, t2);
+        }
+#endif
+
+        return exit >= std::max(enter, 0.0f) && enter <= maxDist;
+    }
+
+    bool IsRayKernelSupported(RayKernel kernel)
+    {
+        switch (kernel)
+        {
+            case RAY_KERNEL_NONE:
+            case RAY_KERNEL_SCALAR:
+                return true;
+#ifdef VMAP_RAY_KERNELS_X86
+            case RAY_KERNEL_SSE2:
+                return true;
+            case RAY_KERNEL_AVX:
+                return CpuSupportsAVX();
+#endif
+            default:
+                return false;
+        }
+    }
+
+    void SetRayKernel(RayKernel kernel)
+    {
+        if (IsRayKernelSupported(kernel))
+            ActiveKernel() = kernel;
+    }
+
+    RayKernel GetRayKernel()
+    {
+        return ActiveKernel();
+    }
+
+    const char* GetRayKernelName(RayKernel kernel)
+    {
+        switch (kernel)
+        {
+            case RAY_KERNEL_NONE:
+                return "none";
+            case RAY_KERNEL_SCALAR:
+                return "scalar";
+            case RAY_KERNEL_SSE2:
+                return "sse2";
+            case RAY_KERNEL_AVX:
+                return "avx";
+            default:
+                return "unknown";
+        }
+    }
+}
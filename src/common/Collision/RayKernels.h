@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _RAYKERNELS_H
+#define _RAYKERNELS_H
+
+#include "G3D/Vector3.h"
+#include "G3D/Ray.h"
+#include "G3D/AABox.h"
+
+#include "Define.h"
+
+#include <vector>
+
+namespace VMAP
+{
+    class MeshTriangle;
+
+    /*
+     * Triangles of a mesh in the order of its BIH object slots, stored as start vertex and two edges
+     * per coordinate (structure of arrays). The triangles of a BIH leaf are consecutive, so a leaf is
+     * tested with one packed ray-triangle kernel call instead of one call per triangle.
+     */
+    class TrianglePack
+    {
+    public:
+        TrianglePack() { }
+
+        void build(const std::vector<G3D::Vector3>& vertices, const std::vector<MeshTriangle>& triangles, const std::vector<uint32>& order);
+        void clear();
+
+        [[nodiscard]] bool empty() const { return !count; }
+        [[nodiscard]] uint32 size() const { return count; }
+
+        //! same contract as IntersectTriangle, for the triangles in slots [first, first + num)
+        bool intersectRay(const G3D::Ray& ray, uint32 first, uint32 num, float& distance) const;
+
+        enum Component
+        {
+            V0_X, V0_Y, V0_Z,
+            E1_X, E1_Y, E1_Z,
+            E2_X, E2_Y, E2_Z,
+            MAX_COMPONENTS
+        };
+
+        [[nodiscard]] const float* component(Component c) const { return &data[c * stride]; }
+
+    private:
+        std::vector<float> data; // MAX_COMPONENTS arrays of stride floats, padded for whole vector loads
+        uint32 count{0};
+        uint32 stride{0};
+    };
+
+    //! slab test, true if the ray enters the box before maxDist (also when starting inside)
+    bool IntersectRayAABox(const G3D::Ray& ray, const G3D::AABox& box, float maxDist);
+
+    enum RayKernel
+    {
+        RAY_KERNEL_NONE,    // no packs, every triangle of a leaf is tested on its own (IntersectTriangle)
+        RAY_KERNEL_SCALAR,
+        RAY_KERNEL_SSE2,    // 4 triangles per step
+        RAY_KERNEL_AVX,     // 8 triangles per step
+        MAX_RAY_KERNELS
+    };
+
+    //! the best kernel the cpu supports is selected by default, others are meant for comparison (vmapbenchmark)
+    bool IsRayKernelSupported(RayKernel kernel);
+    void SetRayKernel(RayKernel kernel);
+    RayKernel GetRayKernel();
+    const char* GetRayKernelName(RayKernel kernel);
+}
+
+#endif // _RAYKERNELS_H
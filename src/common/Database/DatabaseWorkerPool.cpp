@@ -318,10 +318,13 @@ void DatabaseWorkerPool<T>::DirectCommitTransaction(SQLTransaction& transaction)
     T* con = GetFreeConnection();
     if (con->ExecuteTransaction(transaction))
     {
+        transaction->SetCommitted(true);
         con->Unlock();      // OK, operation succesful
         return;
     }
 
+    bool committed = false;
+
     //! Handle MySQL Errno 1213 without extending deadlock to the core itself
     //! TODO: More elegant way
     if (con->GetLastError() == 1213)
@@ -330,12 +333,16 @@ void DatabaseWorkerPool<T>::DirectCommitTransaction(SQLTransaction& transaction)
         for (uint8 i = 0; i < loopBreaker; ++i)
         {
             if (con->ExecuteTransaction(transaction))
+            {
+                committed = true;
                 break;
+            }
         }
     }
 
     //! Clean up now.
     transaction->Cleanup();
+    transaction->SetCommitted(committed);
 
     con->Unlock();
 }
@@ -12,6 +12,7 @@
 
 #include <mysql.h>
 #include <array>
+#include <string_view>
 
 class Field
 {
@@ -38,8 +39,8 @@ public:
 #endif
 
         if (data.raw)
-            return *reinterpret_cast<uint8*>(data.value);
-        return static_cast<uint8>(atol((char*)data.value));
+            return *reinterpret_cast<uint8 const*>(data.value);
+        return static_cast<uint8>(atol((char const*)data.value));
     }
 
     [[nodiscard]] int8 GetInt8() const
@@ -56,8 +57,8 @@ public:
 #endif
 
         if (data.raw)
-            return *reinterpret_cast<int8*>(data.value);
-        return static_cast<int8>(atol((char*)data.value));
+            return *reinterpret_cast<int8 const*>(data.value);
+        return static_cast<int8>(atol((char const*)data.value));
     }
 
 #ifdef ELUNA
@@ -81,8 +82,8 @@ public:
 #endif
 
         if (data.raw)
-            return *reinterpret_cast<uint16*>(data.value);
-        return static_cast<uint16>(atol((char*)data.value));
+            return *reinterpret_cast<uint16 const*>(data.value);
+        return static_cast<uint16>(atol((char const*)data.value));
     }
 
     [[nodiscard]] int16 GetInt16() const
@@ -99,8 +100,8 @@ public:
 #endif
 
         if (data.raw)
-            return *reinterpret_cast<int16*>(data.value);
-        return static_cast<int16>(atol((char*)data.value));
+            return *reinterpret_cast<int16 const*>(data.value);
+        return static_cast<int16>(atol((char const*)data.value));
     }
 
     [[nodiscard]] uint32 GetUInt32() const
@@ -117,8 +118,8 @@ public:
 #endif
 
         if (data.raw)
-            return *reinterpret_cast<uint32*>(data.value);
-        return static_cast<uint32>(atol((char*)data.value));
+            return *reinterpret_cast<uint32 const*>(data.value);
+        return static_cast<uint32>(atol((char const*)data.value));
     }
 
     [[nodiscard]] int32 GetInt32() const
@@ -135,8 +136,8 @@ public:
 #endif
 
         if (data.raw)
-            return *reinterpret_cast<int32*>(data.value);
-        return static_cast<int32>(atol((char*)data.value));
+            return *reinterpret_cast<int32 const*>(data.value);
+        return static_cast<int32>(atol((char const*)data.value));
     }
 
     [[nodiscard]] uint64 GetUInt64() const
@@ -153,8 +154,8 @@ public:
 #endif
 
         if (data.raw)
-            return *reinterpret_cast<uint64*>(data.value);
-        return static_cast<uint64>(atol((char*)data.value));
+            return *reinterpret_cast<uint64 const*>(data.value);
+        return static_cast<uint64>(atol((char const*)data.value));
     }
 
     [[nodiscard]] int64 GetInt64() const
@@ -171,8 +172,8 @@ public:
 #endif
 
         if (data.raw)
-            return *reinterpret_cast<int64*>(data.value);
-        return static_cast<int64>(strtol((char*)data.value, nullptr, 10));
+            return *reinterpret_cast<int64 const*>(data.value);
+        return static_cast<int64>(strtol((char const*)data.value, nullptr, 10));
     }
 
     [[nodiscard]] float GetFloat() const
@@ -189,8 +190,8 @@ public:
 #endif
 
         if (data.raw)
-            return *reinterpret_cast<float*>(data.value);
-        return static_cast<float>(atof((char*)data.value));
+            return *reinterpret_cast<float const*>(data.value);
+        return static_cast<float>(atof((char const*)data.value));
     }
 
     [[nodiscard]] double GetDouble() const
@@ -207,8 +208,8 @@ public:
 #endif
 
         if (data.raw)
-            return *reinterpret_cast<double*>(data.value);
-        return static_cast<double>(atof((char*)data.value));
+            return *reinterpret_cast<double const*>(data.value);
+        return static_cast<double>(atof((char const*)data.value));
     }
 
     [[nodiscard]] char const* GetCString() const
@@ -231,14 +232,22 @@ public:
         if (!data.value)
             return "";
 
-        if (data.raw)
-        {
-            char const* string = GetCString();
-            if (!string)
-                string = "";
-            return std::string(string, data.length);
-        }
-        return std::string((char*)data.value);
+        char const* string = GetCString();
+        if (!string)
+            string = "";
+        return std::string(string, data.length);
+    }
+
+    // no copy, the view is valid as long as the result set (ad-hoc: the current row)
+    [[nodiscard]] std::string_view GetStringView() const
+    {
+        if (!data.value)
+            return std::string_view();
+
+        char const* string = GetCString();
+        if (!string)
+            return std::string_view();
+        return std::string_view(string, data.length);
     }
 
     [[nodiscard]] bool IsNull() const
@@ -257,7 +266,7 @@ public:
 
 protected:
     Field();
-    ~Field();
+    ~Field() = default;
 
 #if defined(__GNUC__)
 #pragma pack(1)
@@ -266,8 +275,8 @@ protected:
 #endif
     struct
     {
-        uint32 length;          // Length (prepared strings only)
-        void* value;            // Actual data in memory
+        uint32 length;          // Length (strings and binaries)
+        void const* value;      // Actual data in memory, owned by the result set
         enum_field_types type;  // Field type
         bool raw;               // Raw bytes? (Prepared statement or ad hoc)
     } data;
@@ -277,14 +286,8 @@ protected:
 #pragma pack(pop)
 #endif
 
-    void SetByteValue(void const* newValue, size_t const newSize, enum_field_types newType, uint32 length);
-    void SetStructuredValue(char* newValue, enum_field_types newType, uint32 length);
-
-    void CleanUp()
-    {
-        delete[] ((char*)data.value);
-        data.value = nullptr;
-    }
+    void SetByteValue(void const* newValue, enum_field_types newType, uint32 length);
+    void SetStructuredValue(char const* newValue, enum_field_types newType, uint32 length);
 
     static size_t SizeForType(MYSQL_FIELD* field)
     {
@@ -204,6 +204,44 @@ void PreparedStatement::setNull(const uint8 index)
     statement_data[index].type = TYPE_NULL;
 }
 
+size_t PreparedStatement::GetParametersSize() const
+{
+    size_t size = 0;
+    for (PreparedStatementData const& data : statement_data)
+    {
+        switch (data.type)
+        {
+            case TYPE_BOOL:
+            case TYPE_UI8:
+            case TYPE_I8:
+                size += 1;
+                break;
+            case TYPE_UI16:
+            case TYPE_I16:
+                size += 2;
+                break;
+            case TYPE_UI32:
+            case TYPE_I32:
+            case TYPE_FLOAT:
+                size += 4;
+                break;
+            case TYPE_UI64:
+            case TYPE_I64:
+            case TYPE_DOUBLE:
+                size += 8;
+                break;
+            case TYPE_STRING:
+            case TYPE_BINARY:
+                size += data.binary.size();
+                break;
+            case TYPE_NULL:
+                break;
+        }
+    }
+
+    return size;
+}
+
 MySQLPreparedStatement::MySQLPreparedStatement(MYSQL_STMT* stmt) :
     m_stmt(nullptr),
     m_Mstmt(stmt),
@@ -91,6 +91,9 @@ public:
     }
     void setNull(const uint8 index);
 
+    // bytes of bound parameter data, strings and binaries by their length
+    [[nodiscard]] size_t GetParametersSize() const;
+
 protected:
     void BindParameters();
 
@@ -17,7 +17,17 @@ ResultSet::ResultSet(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, ui
     ASSERT(_currentRow);
 }
 
+namespace
+{
+    // enough for most startup loads, text heavy tables get a few blocks
+    size_t const ArenaBlockSize = 256 * 1024;
+
+    // raw values are read through typed pointers
+    size_t const ArenaAlignment = 8;
+}
+
 PreparedResultSet::PreparedResultSet(MYSQL_STMT* stmt, MYSQL_RES* result, uint64 rowCount, uint32 fieldCount) :
+    m_rows(nullptr),
     m_rowCount(rowCount),
     m_rowPosition(0),
     m_fieldCount(fieldCount),
@@ -25,7 +35,9 @@ PreparedResultSet::PreparedResultSet(MYSQL_STMT* stmt, MYSQL_RES* result, uint64
     m_stmt(stmt),
     m_res(result),
     m_isNull(nullptr),
-    m_length(nullptr)
+    m_length(nullptr),
+    m_arenaFree(0),
+    m_arenaPos(nullptr)
 {
     if (!m_res)
         return;
@@ -86,37 +98,45 @@ PreparedResultSet::PreparedResultSet(MYSQL_STMT* stmt, MYSQL_RES* result, uint64
 
     m_rowCount = mysql_stmt_num_rows(m_stmt);
 
-    m_rows.resize(uint32(m_rowCount));
+    m_rows = new Field[size_t(m_rowCount) * m_fieldCount];
     while (_NextRow())
     {
-        m_rows[uint32(m_rowPosition)] = new Field[m_fieldCount];
-        for (uint64 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
+        Field* row = &m_rows[size_t(m_rowPosition) * m_fieldCount];
+        for (uint32 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
         {
-            if (!*m_rBind[fIndex].is_null)
-                m_rows[uint32(m_rowPosition)][fIndex].SetByteValue( m_rBind[fIndex].buffer,
-                        m_rBind[fIndex].buffer_length,
-                        m_rBind[fIndex].buffer_type,
-                        *m_rBind[fIndex].length );
-            else
-                switch (m_rBind[fIndex].buffer_type)
+            MYSQL_BIND const& bind = m_rBind[fIndex];
+            switch (bind.buffer_type)
+            {
+                case MYSQL_TYPE_TINY_BLOB:
+                case MYSQL_TYPE_MEDIUM_BLOB:
+                case MYSQL_TYPE_LONG_BLOB:
+                case MYSQL_TYPE_BLOB:
+                case MYSQL_TYPE_STRING:
+                case MYSQL_TYPE_VAR_STRING:
                 {
-                    case MYSQL_TYPE_TINY_BLOB:
-                    case MYSQL_TYPE_MEDIUM_BLOB:
-                    case MYSQL_TYPE_LONG_BLOB:
-                    case MYSQL_TYPE_BLOB:
-                    case MYSQL_TYPE_STRING:
-                    case MYSQL_TYPE_VAR_STRING:
-                        m_rows[uint32(m_rowPosition)][fIndex].SetByteValue( "",
-                                m_rBind[fIndex].buffer_length,
-                                m_rBind[fIndex].buffer_type,
-                                *m_rBind[fIndex].length );
+                    // null strings read as empty, only the used length is kept (plus terminator)
+                    uint32 length = *bind.is_null ? 0 : uint32(std::min<unsigned long>(*bind.length, bind.buffer_length));
+                    char* value = ArenaAllocate(length + 1);
+                    if (length)
+                        memcpy(value, bind.buffer, length);
+                    value[length] = '\0';
+                    row[fIndex].SetByteValue(value, bind.buffer_type, length);
+                    break;
+                }
+                default:
+                {
+                    if (*bind.is_null)
+                    {
+                        row[fIndex].SetByteValue(nullptr, bind.buffer_type, 0);
                         break;
-                    default:
-                        m_rows[uint32(m_rowPosition)][fIndex].SetByteValue( 0,
-                                m_rBind[fIndex].buffer_length,
-                                m_rBind[fIndex].buffer_type,
-                                *m_rBind[fIndex].length );
+                    }
+
+                    char* value = ArenaAllocate(bind.buffer_length);
+                    memcpy(value, bind.buffer, bind.buffer_length);
+                    row[fIndex].SetByteValue(value, bind.buffer_type, *bind.length);
+                    break;
                 }
+            }
         }
         m_rowPosition++;
     }
@@ -133,8 +153,24 @@ ResultSet::~ResultSet()
 
 PreparedResultSet::~PreparedResultSet()
 {
-    for (uint32 i = 0; i < uint32(m_rowCount); ++i)
-        delete[] m_rows[i];
+    delete[] m_rows;
+}
+
+char* PreparedResultSet::ArenaAllocate(size_t size)
+{
+    size = (size + ArenaAlignment - 1) & ~(ArenaAlignment - 1);
+    if (size > m_arenaFree)
+    {
+        size_t blockSize = std::max(size, ArenaBlockSize);
+        m_arena.emplace_back(new char[blockSize]);
+        m_arenaPos = m_arena.back().get();
+        m_arenaFree = blockSize;
+    }
+
+    char* result = m_arenaPos;
+    m_arenaPos += size;
+    m_arenaFree -= size;
+    return result;
 }
 
 bool ResultSet::NextRow()
@@ -158,6 +194,7 @@ bool ResultSet::NextRow()
         return false;
     }
 
+    // the fields point into the stored mysql result, rows stay there until it is freed
     for (uint32 i = 0; i < _fieldCount; i++)
         _currentRow[i].SetStructuredValue(row[i], _fields[i].type, lengths[i]);
 
@@ -11,6 +11,8 @@
 
 #include "Errors.h"
 #include "Field.h"
+#include <memory>
+#include <vector>
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -66,18 +68,19 @@ public:
     [[nodiscard]] Field* Fetch() const
     {
         ASSERT(m_rowPosition < m_rowCount);
-        return m_rows[uint32(m_rowPosition)];
+        return &m_rows[size_t(m_rowPosition) * m_fieldCount];
     }
 
     const Field& operator [] (uint32 index) const
     {
         ASSERT(m_rowPosition < m_rowCount);
         ASSERT(index < m_fieldCount);
-        return m_rows[uint32(m_rowPosition)][index];
+        return m_rows[size_t(m_rowPosition) * m_fieldCount + index];
     }
 
 protected:
-    std::vector<Field*> m_rows;
+    // all rows in one array (row after row), the values they point to live in m_arena
+    Field* m_rows;
     uint64 m_rowCount;
     uint64 m_rowPosition;
     uint32 m_fieldCount;
@@ -90,6 +93,12 @@ private:
     my_bool* m_isNull;
     unsigned long* m_length;
 
+    // bump allocated value storage, a few large blocks instead of one allocation per field
+    std::vector<std::unique_ptr<char[]>> m_arena;
+    size_t m_arenaFree;
+    char* m_arenaPos;
+
+    char* ArenaAllocate(size_t size);
     void FreeBindBuffer();
     void CleanUp();
     bool _NextRow();
@@ -36,6 +36,39 @@ void Transaction::Append(PreparedStatement* stmt)
     m_queries.push_back(data);
 }
 
+size_t Transaction::GetPayloadSize() const
+{
+    size_t size = 0;
+    for (SQLElementData const& data : m_queries)
+    {
+        switch (data.type)
+        {
+            case SQL_ELEMENT_PREPARED:
+                size += data.element.stmt->GetParametersSize();
+                break;
+            case SQL_ELEMENT_RAW:
+                size += strlen(data.element.query);
+                break;
+        }
+    }
+
+    return size;
+}
+
+SQLCommitState Transaction::GetCommitState()
+{
+    if (!_commitState)
+        _commitState = std::make_shared<std::atomic<uint8>>(TRANSACTION_PENDING);
+
+    return _commitState;
+}
+
+void Transaction::SetCommitted(bool committed)
+{
+    if (_commitState)
+        _commitState->store(committed ? TRANSACTION_COMMITTED : TRANSACTION_FAILED, std::memory_order_release);
+}
+
 void Transaction::Cleanup()
 {
     // This might be called by explicit calls to Cleanup or by the auto-destructor
@@ -64,18 +97,25 @@ void Transaction::Cleanup()
 bool TransactionTask::Execute()
 {
     if (m_conn->ExecuteTransaction(m_trans))
+    {
+        m_trans->SetCommitted(true);
         return true;
+    }
 
     if (m_conn->GetLastError() == 1213)
     {
         uint8 loopBreaker = 5;  // Handle MySQL Errno 1213 without extending deadlock to the core itself
         for (uint8 i = 0; i < loopBreaker; ++i)
             if (m_conn->ExecuteTransaction(m_trans))
+            {
+                m_trans->SetCommitted(true);
                 return true;
+            }
     }
 
     // Clean up now.
     m_trans->Cleanup();
+    m_trans->SetCommitted(false);
 
     return false;
 }
@@ -7,6 +7,8 @@
 #ifndef _TRANSACTION_H
 #define _TRANSACTION_H
 
+#include <atomic>
+#include <memory>
 #include <utility>
 
 #include "SQLOperation.h"
@@ -14,6 +16,15 @@
 //- Forward declare (don't include header to prevent circular includes)
 class PreparedStatement;
 
+enum TransactionCommitState : uint8
+{
+    TRANSACTION_PENDING,
+    TRANSACTION_COMMITTED,
+    TRANSACTION_FAILED,     // rolled back, none of its queries were applied
+};
+
+typedef std::shared_ptr<std::atomic<uint8>> SQLCommitState;
+
 /*! Transactions, high level class. */
 class Transaction
 {
@@ -32,13 +43,21 @@ public:
     void PAppend(const char* sql, ...);
 
     [[nodiscard]] size_t GetSize() const { return m_queries.size(); }
+    // bytes sent for the queued queries: the sql text of raw queries, only the bound parameters of prepared
+    // statements (their sql text is prepared once per connection and not sent again)
+    [[nodiscard]] size_t GetPayloadSize() const;
+
+    // set by the database thread once the transaction committed or failed for good, see TransactionCommitState
+    SQLCommitState GetCommitState();
 
 protected:
     void Cleanup();
+    void SetCommitted(bool committed);
     std::list<SQLElementData> m_queries;
 
 private:
     bool _cleanedUp{false};
+    SQLCommitState _commitState;
 };
 
 typedef std::shared_ptr<Transaction> SQLTransaction;
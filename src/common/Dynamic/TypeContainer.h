@@ -16,7 +16,7 @@
 #include <vector>
 #include "Define.h"
 #include "Dynamic/TypeList.h"
-#include "GridRefManager.h"
+#include "GridObjectList.h"
 
 /*
  * @class ContainerMapList is a mulit-type container for map elements
@@ -25,8 +25,7 @@
  */
 template<class OBJECT> struct ContainerMapList
 {
-    //std::map<OBJECT_HANDLE, OBJECT *> _element;
-    GridRefManager<OBJECT> _element;
+    GridObjectList<OBJECT> _element;
 };
 
 template<> struct ContainerMapList<TypeNull>                /* nothing is in type null */
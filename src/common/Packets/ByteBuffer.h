@@ -11,6 +11,7 @@
 #include "Errors.h"
 #include "Util.h"
 #include "ByteConverter.h"
+#include "PacketBufferPool.h"
 #include <exception>
 #include <list>
 #include <map>
@@ -436,12 +437,13 @@ public:
 
         if (_storage.capacity() < newsize) // pussywizard
         {
+            // steps are size classes of PacketBufferPool
             if (newsize < 100)
-                _storage.reserve(300);
+                _storage.reserve(256);
             else if (newsize < 750)
-                _storage.reserve(2500);
+                _storage.reserve(4096);
             else if (newsize < 6000)
-                _storage.reserve(10000);
+                _storage.reserve(16384);
             else
                 _storage.reserve(400000);
         }
@@ -516,7 +518,7 @@ public:
 
 protected:
     size_t _rpos{0}, _wpos{0};
-    std::vector<uint8> _storage;
+    std::vector<uint8, PacketBufferAllocator<uint8>> _storage;
 };
 
 template <typename T>
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "PacketBufferPool.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace
+{
+    // matches the reserve steps of ByteBuffer, WorldPacket (200) and ByteBuffer::DEFAULT_SIZE
+    constexpr size_t SizeClasses[] = { 64, 256, 1024, 4096, 16384, 65536 };
+    constexpr size_t MaxCachedBlocks[] = { 1024, 1024, 512, 256, 64, 16 };
+    constexpr size_t NumSizeClasses = sizeof(SizeClasses) / sizeof(SizeClasses[0]);
+
+    size_t GetSizeClass(size_t size)
+    {
+        for (size_t i = 0; i < NumSizeClasses; ++i)
+            if (size <= SizeClasses[i])
+                return i;
+
+        return NumSizeClasses;
+    }
+
+    struct ThreadPool;
+
+    struct PoolRegistry
+    {
+        std::mutex lock;
+        std::vector<ThreadPool*> pools;
+        PacketBufferPoolStats retired;
+    };
+
+    PoolRegistry& GetRegistry()
+    {
+        static PoolRegistry registry;
+        return registry;
+    }
+
+    struct ThreadPool
+    {
+        std::array<std::vector<void*>, NumSizeClasses> freeBlocks;
+
+        // only written by the owning thread, atomic so GetStats can read them
+        std::atomic<uint64> hits{0};
+        std::atomic<uint64> misses{0};
+        std::atomic<uint64> oversized{0};
+
+        ThreadPool()
+        {
+            for (size_t i = 0; i < NumSizeClasses; ++i)
+                freeBlocks[i].reserve(MaxCachedBlocks[i]);
+
+            PoolRegistry& registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.lock);
+            registry.pools.push_back(this);
+        }
+
+        ~ThreadPool();
+    };
+
+    // trivially destructible, still readable after the thread's pool is gone
+    thread_local bool t_poolDestroyed = false;
+
+    ThreadPool::~ThreadPool()
+    {
+        t_poolDestroyed = true;
+
+        for (auto& blocks : freeBlocks)
+            for (void* ptr : blocks)
+                ::operator delete(ptr);
+
+        PoolRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> guard(registry.lock);
+        registry.pools.erase(std::remove(registry.pools.begin(), registry.pools.end(), this), registry.pools.end());
+        registry.retired.hits += hits;
+        registry.retired.misses += misses;
+        registry.retired.oversized += oversized;
+    }
+
+    ThreadPool* GetThreadPool()
+    {
+        // buffers freed by static/thread_local destructors after the pool is gone go straight to the heap
+        if (t_poolDestroyed)
+            return nullptr;
+
+        thread_local ThreadPool pool;
+        return &pool;
+    }
+}
+
+void* PacketBufferPool::Allocate(size_t size)
+{
+    size_t sizeClass = GetSizeClass(size);
+    ThreadPool* pool = GetThreadPool();
+
+    if (sizeClass == NumSizeClasses)
+    {
+        if (pool)
+            pool->oversized.fetch_add(1, std::memory_order_relaxed);
+
+        return ::operator new(size);
+    }
+
+    if (pool)
+    {
+        std::vector<void*>& blocks = pool->freeBlocks[sizeClass];
+        if (!blocks.empty())
+        {
+            void* ptr = blocks.back();
+            blocks.pop_back();
+            pool->hits.fetch_add(1, std::memory_order_relaxed);
+            return ptr;
+        }
+
+        pool->misses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return ::operator new(SizeClasses[sizeClass]);
+}
+
+void PacketBufferPool::Deallocate(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    size_t sizeClass = GetSizeClass(size);
+    if (sizeClass < NumSizeClasses)
+    {
+        if (ThreadPool* pool = GetThreadPool())
+        {
+            std::vector<void*>& blocks = pool->freeBlocks[sizeClass];
+            if (blocks.size() < MaxCachedBlocks[sizeClass])
+            {
+                blocks.push_back(ptr);
+                return;
+            }
+        }
+    }
+
+    ::operator delete(ptr);
+}
+
+PacketBufferPoolStats PacketBufferPool::GetStats()
+{
+    PoolRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+
+    PacketBufferPoolStats stats = registry.retired;
+    for (ThreadPool* pool : registry.pools)
+    {
+        stats.hits += pool->hits.load(std::memory_order_relaxed);
+        stats.misses += pool->misses.load(std::memory_order_relaxed);
+        stats.oversized += pool->oversized.load(std::memory_order_relaxed);
+    }
+
+    return stats;
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PACKETBUFFERPOOL_H
+#define _PACKETBUFFERPOOL_H
+
+#include "Define.h"
+#include <cstddef>
+
+struct PacketBufferPoolStats
+{
+    uint64 hits{0};
+    uint64 misses{0};      // size class pool was empty
+    uint64 oversized{0};   // larger than the biggest size class, never pooled
+};
+
+/*
+ * Storage for ByteBuffer/WorldPacket.
+ * Blocks are rounded up to a size class and recycled through per-thread free lists,
+ * a block may be freed on another thread than the one it was allocated on.
+ */
+class PacketBufferPool
+{
+public:
+    static void* Allocate(size_t size);
+    static void Deallocate(void* ptr, size_t size);
+
+    // sum over all threads, including the ones that already exited
+    static PacketBufferPoolStats GetStats();
+};
+
+template<typename T>
+class PacketBufferAllocator
+{
+public:
+    typedef T value_type;
+
+    PacketBufferAllocator() = default;
+    template<typename U> PacketBufferAllocator(PacketBufferAllocator<U> const&) { }
+
+    T* allocate(size_t n) { return static_cast<T*>(PacketBufferPool::Allocate(n * sizeof(T))); }
+    void deallocate(T* ptr, size_t n) { PacketBufferPool::Deallocate(ptr, n * sizeof(T)); }
+
+    template<typename U> bool operator==(PacketBufferAllocator<U> const&) const { return true; }
+    template<typename U> bool operator!=(PacketBufferAllocator<U> const&) const { return false; }
+};
+
+#endif
@@ -9,6 +9,7 @@
 
 #include "Common.h"
 #include "ByteBuffer.h"
+#include <atomic>
 
 class WorldPacket : public ByteBuffer
 {
@@ -24,9 +25,20 @@ public:
     }
     /* requried as of C++ 11 */
 #if __cplusplus >= 201103L
-    WorldPacket(WorldPacket&&) = default;
-    WorldPacket& operator=(const WorldPacket&) = default;
-    WorldPacket& operator=(WorldPacket&&) = default;
+    // QueueLink belongs to the queue the packet is in, it is never copied
+    WorldPacket(WorldPacket&& packet) : ByteBuffer(std::move(packet)), m_opcode(packet.m_opcode) { }
+    WorldPacket& operator=(const WorldPacket& packet)
+    {
+        ByteBuffer::operator=(packet);
+        m_opcode = packet.m_opcode;
+        return *this;
+    }
+    WorldPacket& operator=(WorldPacket&& packet)
+    {
+        ByteBuffer::operator=(std::move(packet));
+        m_opcode = packet.m_opcode;
+        return *this;
+    }
 #endif
 
     void Initialize(uint16 opcode, size_t newres = 200)
@@ -39,6 +51,9 @@ public:
     [[nodiscard]] uint16 GetOpcode() const { return m_opcode; }
     void SetOpcode(uint16 opcode) { m_opcode = opcode; }
 
+    // link for the lock-free receive queue of WorldSession, see MPSCQueue
+    std::atomic<WorldPacket*> QueueLink{nullptr};
+
 protected:
     uint16 m_opcode{0};
 };
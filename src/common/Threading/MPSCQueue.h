@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+/*
+ * Unbounded lock-free queue for many producers and one consumer.
+ *
+ * The queue is intrusive, elements carry their own link (IntrusiveLink), so adding
+ * an element never allocates. Producers only do one atomic exchange, the consumer
+ * never blocks them.
+ *
+ * Only one thread may call Dequeue/Peek at a time, different threads may take turns
+ * as long as the handover is synchronized (e.g. by a mutex or a thread join).
+ * Elements still queued are deleted with the queue.
+ * Dequeue may report an empty queue while a producer is in the middle of Enqueue,
+ * the element becomes visible once that call returns.
+ */
+template<typename T, std::atomic<T*> T::* IntrusiveLink>
+class MPSCQueue
+{
+public:
+    MPSCQueue() : _dummyPtr(reinterpret_cast<T*>(std::addressof(_dummy))), _head(_dummyPtr), _tail(_dummyPtr), _peeked(nullptr)
+    {
+        // _dummy is never constructed as T (it might not be default constructible), only its link is used
+        std::atomic<T*>* dummyNext = new (&(_dummyPtr->*IntrusiveLink)) std::atomic<T*>();
+        dummyNext->store(nullptr, std::memory_order_relaxed);
+    }
+
+    ~MPSCQueue()
+    {
+        T* output;
+        while (Dequeue(output))
+            delete output;
+    }
+
+    MPSCQueue(MPSCQueue const&) = delete;
+    MPSCQueue& operator=(MPSCQueue const&) = delete;
+
+    void Enqueue(T* input)
+    {
+        (input->*IntrusiveLink).store(nullptr, std::memory_order_release);
+        T* prevHead = _head.exchange(input, std::memory_order_acq_rel);
+        (prevHead->*IntrusiveLink).store(input, std::memory_order_release);
+    }
+
+    bool Dequeue(T*& result)
+    {
+        if (_peeked)
+        {
+            result = _peeked;
+            _peeked = nullptr;
+            return true;
+        }
+
+        return Take(result);
+    }
+
+    // next element without removing it, stays at the front until Dequeue
+    T* Peek()
+    {
+        if (!_peeked)
+            Take(_peeked);
+
+        return _peeked;
+    }
+
+    bool Empty() { return !Peek(); }
+
+private:
+    bool Take(T*& result)
+    {
+        T* tail = _tail.load(std::memory_order_relaxed);
+        T* next = (tail->*IntrusiveLink).load(std::memory_order_acquire);
+        if (tail == _dummyPtr)
+        {
+            if (!next)
+                return false;
+
+            _tail.store(next, std::memory_order_relaxed);
+            tail = next;
+            next = (next->*IntrusiveLink).load(std::memory_order_acquire);
+        }
+
+        if (next)
+        {
+            _tail.store(next, std::memory_order_relaxed);
+            result = tail;
+            return true;
+        }
+
+        // tail is the last element, a producer may still be linking after it
+        T* head = _head.load(std::memory_order_acquire);
+        if (tail != head)
+            return false;
+
+        // put the dummy behind the last element so it can be unlinked
+        Enqueue(_dummyPtr);
+        next = (tail->*IntrusiveLink).load(std::memory_order_acquire);
+        if (next)
+        {
+            _tail.store(next, std::memory_order_relaxed);
+            result = tail;
+            return true;
+        }
+
+        return false;
+    }
+
+    std::aligned_storage_t<sizeof(T), alignof(T)> _dummy;
+    T* _dummyPtr;
+    alignas(64) std::atomic<T*> _head; // producers
+    alignas(64) std::atomic<T*> _tail; // consumer
+    T* _peeked;
+};
+
+#endif
@@ -23,7 +23,7 @@ public:
 
     void OnInitialize(WorldObject* obj, AreaTrigger const* at = nullptr);
     void GetScript();
-    void FillScript(SmartAIEventList e, WorldObject* obj, AreaTrigger const* at);
+    void FillScript(SmartAIEventList const& e, WorldObject* obj, AreaTrigger const* at);
 
     void ProcessEventsFor(SMART_EVENT e, Unit* unit = nullptr, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellInfo* spell = nullptr, GameObject* gob = nullptr);
     void ProcessEvent(SmartScriptHolder& e, Unit* unit = nullptr, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellInfo* spell = nullptr, GameObject* gob = nullptr);
@@ -259,6 +259,9 @@ private:
 
     SmartAIEventList mEvents;
     SmartAIEventList mInstallEvents;
+    // positions in mEvents grouped by event type, the events of type t are mEventIndex[mEventIndexOffsets[t], mEventIndexOffsets[t + 1])
+    std::vector<uint32> mEventIndex;
+    std::array<uint32, SMART_EVENT_AC_END + 1> mEventIndexOffsets;
     SmartAIEventList mTimedActionList;
     bool isProcessingTimedActionList;
     Creature* me;
@@ -293,6 +296,8 @@ private:
 
     SMARTAI_TEMPLATE mTemplate;
     void InstallEvents();
+    void BuildEventIndex();
+    ConditionList const& GetConditions(SmartScriptHolder& e);
 
     void RemoveStoredEvent (uint32 id)
     {
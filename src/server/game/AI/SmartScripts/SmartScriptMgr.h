@@ -8,6 +8,7 @@
 #define ACORE_SMARTSCRIPTMGR_H
 
 #include "Common.h"
+#include "ConditionMgr.h"
 #include "Creature.h"
 #include "CreatureAI.h"
 #include "Spell.h"
@@ -1679,7 +1680,7 @@ struct SmartScriptHolder
 {
     SmartScriptHolder() : entryOrGuid(0), source_type(SMART_SCRIPT_TYPE_CREATURE)
         , event_id(0), link(0), event(), action(), target(), timer(0), active(false), runOnce(false)
-        , enableTimed(false) {}
+        , enableTimed(false), conditions(nullptr), conditionsGeneration(0) {}
 
     int32 entryOrGuid;
     SmartScriptType source_type;
@@ -1700,6 +1701,10 @@ public:
     bool active;
     bool runOnce;
     bool enableTimed;
+
+    // conditions of the event, resolved on first use, see SmartScript::GetConditions
+    ConditionList const* conditions;
+    uint32 conditionsGeneration;
 };
 
 typedef std::unordered_map<uint32, WayPoint*> WPPath;
@@ -1798,18 +1803,20 @@ public:
 
     void LoadSmartAIFromDB();
 
-    SmartAIEventList GetScript(int32 entry, SmartScriptType type)
+    SmartAIEventList const& GetScript(int32 entry, SmartScriptType type) const
     {
-        SmartAIEventList temp;
-        if (mEventMap[uint32(type)].find(entry) != mEventMap[uint32(type)].end())
-            return mEventMap[uint32(type)][entry];
+        static SmartAIEventList const noEvents;
+
+        SmartAIEventMap::const_iterator itr = mEventMap[uint32(type)].find(entry);
+        if (itr != mEventMap[uint32(type)].end())
+            return itr->second;
         else
         {
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
             if (entry > 0) //first search is for guid (negative), do not drop error if not found
                 sLog->outDebug(LOG_FILTER_DATABASE_AI, "SmartAIMgr::GetScript: Could not load Script for Entry %d ScriptType %u.", entry, uint32(type));
 #endif
-            return temp;
+            return noEvents;
         }
     }
 
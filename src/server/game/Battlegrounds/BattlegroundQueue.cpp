@@ -20,6 +20,9 @@
 
 std::unordered_map<uint64, uint32> BGSpamProtection;
 
+// matchmaker ratings above are treated as equal when pairing rated arena teams
+static uint32 const MaxCountedMMR = 2500;
+
 /*********************************************************/
 /***            BATTLEGROUND QUEUE SYSTEM              ***/
 /*********************************************************/
@@ -176,7 +179,9 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, PvPDiffi
     }
 
     //add GroupInfo to m_QueuedGroups
-    m_QueuedGroups[bracketId][index].push_back(ginfo);
+    ginfo->_queueItr = m_QueuedGroups[bracketId][index].insert(m_QueuedGroups[bracketId][index].end(), ginfo);
+    if (isRated)
+        ginfo->_ratingItr = m_RatedGroups[bracketId].insert(std::make_pair(std::min(MatchmakerRating, MaxCountedMMR), ginfo));
 
     Battleground* bg = sBattlegroundMgr->GetBattlegroundTemplate(ginfo->BgTypeId);
     if (!bg)
@@ -264,22 +269,6 @@ void BattlegroundQueue::RemovePlayer(uint64 guid, bool sentToBg, uint32 playerQu
     uint32 _bracketId = groupInfo->_bracketId;
     uint32 _groupType = groupInfo->_groupType;
 
-    // find iterator
-    auto group_itr = m_QueuedGroups[_bracketId][_groupType].end();
-    for (auto k = m_QueuedGroups[_bracketId][_groupType].begin(); k != m_QueuedGroups[_bracketId][_groupType].end(); ++k)
-        if ((*k) == groupInfo)
-        {
-            group_itr = k;
-            break;
-        }
-
-    //player can't be in queue without group, but just in case
-    if (group_itr == m_QueuedGroups[_bracketId][_groupType].end())
-    {
-        ABORT();
-        return;
-    }
-
     // remove player from group queue info
     auto pitr = groupInfo->Players.find(guid);
     ASSERT(pitr != groupInfo->Players.end());
@@ -310,7 +299,9 @@ void BattlegroundQueue::RemovePlayer(uint64 guid, bool sentToBg, uint32 playerQu
     // remove group queue info no players left
     if (groupInfo->Players.empty())
     {
-        m_QueuedGroups[_bracketId][_groupType].erase(group_itr);
+        m_QueuedGroups[_bracketId][_groupType].erase(groupInfo->_queueItr);
+        if (groupInfo->IsRated)
+            m_RatedGroups[_bracketId].erase(groupInfo->_ratingItr);
         delete groupInfo;
         return;
     }
@@ -333,6 +324,14 @@ void BattlegroundQueue::RemovePlayer(uint64 guid, bool sentToBg, uint32 playerQu
     }
 }
 
+void BattlegroundQueue::MoveGroup(GroupQueueInfo* ginfo, uint8 groupType)
+{
+    GroupsQueueType& groups = m_QueuedGroups[ginfo->_bracketId][groupType];
+    m_QueuedGroups[ginfo->_bracketId][ginfo->_groupType].erase(ginfo->_queueItr);
+    ginfo->_groupType = groupType; // pussywizard: update GroupQueueInfo internal variable
+    ginfo->_queueItr = groups.insert(groups.begin(), ginfo);
+}
+
 void BattlegroundQueue::AddEvent(BasicEvent* Event, uint64 e_time)
 {
     m_events.AddEvent(Event, m_events.CalculateTime(e_time));
@@ -563,9 +562,7 @@ bool BattlegroundQueue::CheckPremadeMatch(BattlegroundBracketId bracket_id, uint
             {
                 if (!(*itr)->IsInvitedToBGInstanceGUID && ((*itr)->JoinTime < time_before || (*itr)->Players.size() < MinPlayersPerTeam))
                 {
-                    (*itr)->_groupType = BG_QUEUE_NORMAL_ALLIANCE + i; // pussywizard: update GroupQueueInfo internal variable
-                    m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].push_front((*itr));
-                    m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].erase(itr++);
+                    MoveGroup(*(itr++), BG_QUEUE_NORMAL_ALLIANCE + i);
                     continue;
                 }
                 ++itr;
@@ -629,20 +626,9 @@ bool BattlegroundQueue::CheckSkirmishForSameFaction(BattlegroundBracketId bracke
 
                                 for (auto pitr = m_SelectionPools[wrongTeamId].SelectedGroups.begin(); pitr != m_SelectionPools[wrongTeamId].SelectedGroups.end(); ++pitr)
                                 {
-                                    // update internal GroupQueueInfo data
+                                    // update internal GroupQueueInfo data and move it to the queue of the other faction
                                     (*pitr)->teamId = wrongTeamId;
-                                    (*pitr)->_groupType = BG_QUEUE_NORMAL_ALLIANCE + wrongTeamId;
-
-                                    // add GroupQueueInfo to new queue
-                                    m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + wrongTeamId].push_front(*pitr);
-
-                                    // remove GroupQueueInfo from old queue
-                                    for (auto qitr = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].begin(); qitr != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].end(); ++qitr)
-                                        if (*qitr == *pitr)
-                                        {
-                                            m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].erase(qitr);
-                                            break;
-                                        }
+                                    MoveGroup(*pitr, BG_QUEUE_NORMAL_ALLIANCE + wrongTeamId);
                                 }
 
                                 return true;
@@ -780,165 +766,150 @@ void BattlegroundQueue::BattlegroundQueueUpdate(BattlegroundBracketId bracket_id
     else if (bg_template->isArena())
     {
         // pussywizard: everything inside this section is mine, do NOT destroy!
+        // (opponents are looked up in m_RatedGroups by rating distance, see FindRatedArenaOpponent)
 
-        const uint32 currMSTime = World::GetGameTimeMS();
-        const uint32 discardTime = sBattlegroundMgr->GetRatingDiscardTimer();
-        const uint32 maxDefaultRatingDifference = (MaxPlayersPerTeam > 2 ? 300 : 200);
-        const uint32 maxCountedMMR = 2500;
-
-        // we need to find 2 teams which will play next game
-        GroupsQueueType::iterator itr_teams[BG_TEAMS_COUNT];
-
-        bool increaseItr = true;
-        bool reverse1 = urand(0, 1) != 0;
+        bool reverse = urand(0, 1) != 0;
         for (uint8 ii = BG_QUEUE_PREMADE_ALLIANCE; ii <= BG_QUEUE_PREMADE_HORDE; ii++)
         {
-            uint8 i = reverse1 ? (BG_QUEUE_PREMADE_HORDE - ii) : ii;
-            for (auto itr = m_QueuedGroups[bracket_id][i].begin(); itr != m_QueuedGroups[bracket_id][i].end(); (increaseItr ? ++itr : itr))
+            uint8 i = reverse ? (BG_QUEUE_PREMADE_HORDE - ii) : ii;
+            for (auto itr = m_QueuedGroups[bracket_id][i].begin(); itr != m_QueuedGroups[bracket_id][i].end(); )
             {
-                increaseItr = true;
+                GroupQueueInfo* ginfo = *(itr++);
 
                 // if arenaRatedTeamId is set - look for oponents only for one team, if not - pair every possible team
-                if (arenaRatedTeamId != 0 && arenaRatedTeamId != (*itr)->ArenaTeamId)
+                if (arenaRatedTeamId != 0 && arenaRatedTeamId != ginfo->ArenaTeamId)
                     continue;
-                if ((*itr)->IsInvitedToBGInstanceGUID)
+                if (ginfo->IsInvitedToBGInstanceGUID || !ginfo->IsRated)
                     continue;
 
-                uint32 MMR1 = std::min((*itr)->ArenaMatchmakerRating, maxCountedMMR);
-
-                GroupsQueueType::iterator oponentItr;
-                uint8 oponentQueue = BG_QUEUE_MAX;
-                uint32 minOponentMMRDiff = 0xffffffff;
-                uint8 oponentValid = 0;
-
-                bool reverse2 = urand(0, 1) != 0;
-                for (uint8 jj = BG_QUEUE_PREMADE_ALLIANCE; jj <= BG_QUEUE_PREMADE_HORDE; jj++)
+                GroupQueueInfo* oponent = FindRatedArenaOpponent(ginfo, MaxPlayersPerTeam);
+                if (!oponent)
                 {
-                    uint8 j = reverse2 ? (BG_QUEUE_PREMADE_HORDE - jj) : jj;
-                    bool brk = false;
-                    for (auto itr2 = m_QueuedGroups[bracket_id][j].begin(); itr2 != m_QueuedGroups[bracket_id][j].end(); ++itr2)
-                    {
-                        if ((*itr)->ArenaTeamId == (*itr2)->ArenaTeamId)
-                            continue;
-                        if ((*itr2)->IsInvitedToBGInstanceGUID)
-                            continue;
-                        uint32 MMR2 = std::min((*itr2)->ArenaMatchmakerRating, maxCountedMMR);
-                        uint32 MMRDiff = (MMR2 >= MMR1 ? MMR2 - MMR1 : MMR1 - MMR2);
-
-                        uint32 maxAllowedDiff = maxDefaultRatingDifference;
-                        uint32 shorterWaitTime, longerWaitTime;
-                        if (currMSTime - (*itr)->JoinTime <= currMSTime - (*itr2)->JoinTime)
-                        {
-                            shorterWaitTime = currMSTime - (*itr)->JoinTime;
-                            longerWaitTime = currMSTime - (*itr2)->JoinTime;
-                        }
-                        else
-                        {
-                            shorterWaitTime = currMSTime - (*itr2)->JoinTime;
-                            longerWaitTime = currMSTime - (*itr)->JoinTime;
-                        }
-                        if (longerWaitTime >= discardTime)
-                            maxAllowedDiff += 150;
-                        maxAllowedDiff += shorterWaitTime / 600; // increased by 100 for each minute
+                    if (arenaRatedTeamId)
+                        return;
+                    continue;
+                }
 
-                        // now check if this team is more appropriate than previous ones:
+                GroupQueueInfo* aTeam = i == BG_QUEUE_PREMADE_ALLIANCE ? ginfo : oponent;
+                GroupQueueInfo* hTeam = i == BG_QUEUE_PREMADE_ALLIANCE ? oponent : ginfo;
+                Battleground* arena = sBattlegroundMgr->CreateNewBattleground(m_bgTypeId, bracketEntry->minLevel, bracketEntry->maxLevel, m_arenaType, true);
+                if (!arena)
+                    return;
 
-                        if (currMSTime - (*itr)->JoinTime >= 20 * MINUTE * IN_MILLISECONDS && (oponentValid < 3 || MMRDiff < minOponentMMRDiff)) // after 20 minutes of waiting, pair with closest mmr, regardless the difference
-                        {
-                            oponentValid = 3;
-                            minOponentMMRDiff = MMRDiff;
-                            oponentItr = itr2;
-                            oponentQueue = j;
-                        }
-                        else if (MMR1 >= 2000 && MMR2 >= 2000 && longerWaitTime >= 2 * discardTime && (oponentValid < 2 || MMRDiff < minOponentMMRDiff)) // after 6 minutes of waiting, pair any 2000+ vs 2000+
-                        {
-                            oponentValid = 2;
-                            minOponentMMRDiff = MMRDiff;
-                            oponentItr = itr2;
-                            oponentQueue = j;
-                        }
-                        else if (oponentValid < 2 && MMRDiff < minOponentMMRDiff)
-                        {
-                            if (!oponentValid)
-                            {
-                                minOponentMMRDiff = MMRDiff;
-                                oponentItr = itr2;
-                                oponentQueue = j;
-                                if (MMRDiff <= maxAllowedDiff)
-                                    oponentValid = 1;
-                            }
-                            if ((MMR1 < 1800 || MMR2 < 1800) && MaxPlayersPerTeam == 2 && MMRDiff <= maxDefaultRatingDifference) // in 2v2 below 1800 mmr - priority for default allowed difference
-                            {
-                                minOponentMMRDiff = MMRDiff;
-                                oponentItr = itr2;
-                                oponentQueue = j;
-                                brk = true;
-                                break;
-                            }
-                        }
-                    }
-                    if (brk)
-                        break;
-                }
+                aTeam->OpponentsTeamRating = hTeam->ArenaTeamRating;
+                hTeam->OpponentsTeamRating = aTeam->ArenaTeamRating;
+                aTeam->OpponentsMatchmakerRating = hTeam->ArenaMatchmakerRating;
+                hTeam->OpponentsMatchmakerRating = aTeam->ArenaMatchmakerRating;
 
-                if (oponentQueue != BG_QUEUE_MAX)
+                // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
+                if (aTeam->teamId != TEAM_ALLIANCE)
                 {
-                    if (oponentValid)
-                    {
-                        itr_teams[i] = itr;
-                        itr_teams[i == 0 ? 1 : 0] = oponentItr;
+                    MoveGroup(aTeam, BG_QUEUE_PREMADE_ALLIANCE);
+                    itr = m_QueuedGroups[bracket_id][i].begin();
+                }
+                if (hTeam->teamId != TEAM_HORDE)
+                {
+                    MoveGroup(hTeam, BG_QUEUE_PREMADE_HORDE);
+                    itr = m_QueuedGroups[bracket_id][i].begin();
+                }
 
-                        {
-                            GroupQueueInfo* aTeam = *itr_teams[TEAM_ALLIANCE];
-                            GroupQueueInfo* hTeam = *itr_teams[TEAM_HORDE];
-                            Battleground* arena = sBattlegroundMgr->CreateNewBattleground(m_bgTypeId, bracketEntry->minLevel, bracketEntry->maxLevel, m_arenaType, true);
-                            if (!arena)
-                                return;
-
-                            aTeam->OpponentsTeamRating = hTeam->ArenaTeamRating;
-                            hTeam->OpponentsTeamRating = aTeam->ArenaTeamRating;
-                            aTeam->OpponentsMatchmakerRating = hTeam->ArenaMatchmakerRating;
-                            hTeam->OpponentsMatchmakerRating = aTeam->ArenaMatchmakerRating;
-
-                            // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
-                            if (aTeam->teamId != TEAM_ALLIANCE)
-                            {
-                                aTeam->_groupType = BG_QUEUE_PREMADE_ALLIANCE;
-                                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].push_front(aTeam);
-                                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].erase(itr_teams[TEAM_ALLIANCE]);
-                                increaseItr = false;
-                                itr = m_QueuedGroups[bracket_id][i].begin();
-                            }
-                            if (hTeam->teamId != TEAM_HORDE)
-                            {
-                                hTeam->_groupType = BG_QUEUE_PREMADE_HORDE;
-                                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].push_front(hTeam);
-                                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].erase(itr_teams[TEAM_HORDE]);
-                                increaseItr = false;
-                                itr = m_QueuedGroups[bracket_id][i].begin();
-                            }
+                arena->SetArenaMatchmakerRating(TEAM_ALLIANCE, aTeam->ArenaMatchmakerRating);
+                arena->SetArenaMatchmakerRating(TEAM_HORDE, hTeam->ArenaMatchmakerRating);
+                BattlegroundMgr::InviteGroupToBG(aTeam, arena, TEAM_ALLIANCE);
+                BattlegroundMgr::InviteGroupToBG(hTeam, arena, TEAM_HORDE);
 
-                            arena->SetArenaMatchmakerRating(TEAM_ALLIANCE, aTeam->ArenaMatchmakerRating);
-                            arena->SetArenaMatchmakerRating(TEAM_HORDE, hTeam->ArenaMatchmakerRating);
-                            BattlegroundMgr::InviteGroupToBG(aTeam, arena, TEAM_ALLIANCE);
-                            BattlegroundMgr::InviteGroupToBG(hTeam, arena, TEAM_HORDE);
+                arena->StartBattleground();
 
-                            arena->StartBattleground();
-                        }
-
-                        if (arenaRatedTeamId)
-                            return;
-                        else
-                            continue;
-                    }
-                    else if (arenaRatedTeamId)
-                        return;
-                }
+                if (arenaRatedTeamId)
+                    return;
             }
         }
     }
 }
 
+// calls check for the groups of the index by increasing rating difference to from (excluded), down to minRating and up to maxDiff,
+// returns the first group check accepts
+template<class Check>
+static GroupQueueInfo* FindClosestRatedGroup(std::multimap<uint32, GroupQueueInfo*> const& index, std::multimap<uint32, GroupQueueInfo*>::const_iterator from, uint32 minRating, uint32 maxDiff, Check check)
+{
+    uint32 rating = from->first;
+    auto up = std::next(from);
+    auto down = std::make_reverse_iterator(from); // the group before from
+
+    for (;;)
+    {
+        bool hasUp = up != index.end() && up->first - rating <= maxDiff;
+        bool hasDown = down != index.rend() && down->first >= minRating && rating - down->first <= maxDiff;
+        if (!hasUp && !hasDown)
+            return nullptr;
+
+        // equal distance: the one waiting longer
+        GroupQueueInfo* candidate;
+        uint32 diff;
+        if (hasUp && (!hasDown || up->first - rating < rating - down->first || (up->first - rating == rating - down->first && up->second->JoinTime <= down->second->JoinTime)))
+        {
+            diff = up->first - rating;
+            candidate = (up++)->second;
+        }
+        else
+        {
+            diff = rating - down->first;
+            candidate = (down++)->second;
+        }
+
+        if (check(candidate, diff))
+            return candidate;
+    }
+}
+
+// pussywizard's rules, in order of priority:
+// - after 20 minutes of waiting, pair with closest mmr, regardless the difference
+// - after 6 minutes (2 * discard time) of waiting of either team, pair any 2000+ vs 2000+, closest mmr
+// - closest mmr within the allowed difference, which grows with the waiting time of both teams
+//   (in 2v2 below 1800 the default difference has priority, it is the closest one anyway)
+GroupQueueInfo* BattlegroundQueue::FindRatedArenaOpponent(GroupQueueInfo const* ginfo, uint32 maxPlayersPerTeam) const
+{
+    RatedGroupsIndex const& index = m_RatedGroups[ginfo->_bracketId];
+    uint32 const currMSTime = World::GetGameTimeMS();
+    uint32 const discardTime = sBattlegroundMgr->GetRatingDiscardTimer();
+    uint32 const maxDefaultRatingDifference = (maxPlayersPerTeam > 2 ? 300 : 200);
+    uint32 const mmr = ginfo->_ratingItr->first;
+    uint32 const waitTime = currMSTime - ginfo->JoinTime;
+
+    auto available = [ginfo](GroupQueueInfo const* oponent)
+    {
+        return oponent->ArenaTeamId != ginfo->ArenaTeamId && !oponent->IsInvitedToBGInstanceGUID;
+    };
+
+    if (waitTime >= 20 * MINUTE * IN_MILLISECONDS)
+        return FindClosestRatedGroup(index, ginfo->_ratingItr, 0, MaxCountedMMR, [&](GroupQueueInfo const* oponent, uint32 /*diff*/)
+        {
+            return available(oponent);
+        });
+
+    if (mmr >= 2000)
+        if (GroupQueueInfo* oponent = FindClosestRatedGroup(index, ginfo->_ratingItr, 2000, MaxCountedMMR, [&](GroupQueueInfo const* oponent, uint32 /*diff*/)
+            {
+                return available(oponent) && std::max(waitTime, currMSTime - oponent->JoinTime) >= 2 * discardTime;
+            }))
+            return oponent;
+
+    // the opponent waited at least as long as the team or less, the allowed difference cannot exceed this
+    uint32 maxAllowedDiff = maxDefaultRatingDifference + 150 + waitTime / 600;
+    return FindClosestRatedGroup(index, ginfo->_ratingItr, 0, maxAllowedDiff, [&](GroupQueueInfo const* oponent, uint32 diff)
+    {
+        if (!available(oponent))
+            return false;
+
+        uint32 oponentWaitTime = currMSTime - oponent->JoinTime;
+        uint32 allowedDiff = maxDefaultRatingDifference;
+        if (std::max(waitTime, oponentWaitTime) >= discardTime)
+            allowedDiff += 150;
+        allowedDiff += std::min(waitTime, oponentWaitTime) / 600; // increased by 100 for each minute
+        return diff <= allowedDiff;
+    });
+}
+
 uint32 BattlegroundQueue::GetPlayersCountInGroupsQueue(BattlegroundBracketId bracketId, BattlegroundQueueGroupTypes bgqueue)
 {
     uint32 playersCount = 0;
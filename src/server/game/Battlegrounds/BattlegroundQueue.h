@@ -12,6 +12,7 @@
 #include "DBCEnums.h"
 #include "EventProcessor.h"
 #include <deque>
+#include <map>
 
 #define COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME 10
 
@@ -35,6 +36,8 @@ struct GroupQueueInfo                                       // stores informatio
     // pussywizard: for internal use
     uint8 _bracketId;
     uint8 _groupType;
+    std::list<GroupQueueInfo*>::iterator _queueItr;                 // position in m_QueuedGroups[_bracketId][_groupType], see BattlegroundQueue::MoveGroup
+    std::multimap<uint32, GroupQueueInfo*>::iterator _ratingItr;    // position in m_RatedGroups[_bracketId], rated only
 };
 
 enum BattlegroundQueueGroupTypes
@@ -115,6 +118,14 @@ public:
     ArenaType GetArenaType() { return m_arenaType; }
     BattlegroundTypeId GetBGTypeID() { return m_bgTypeId; }
 private:
+    // rated groups of both factions by matchmaker rating (capped, see AddGroup), queue order for equal ratings
+    typedef std::multimap<uint32, GroupQueueInfo*> RatedGroupsIndex;
+
+    // moves a queued group to the front of another list of its bracket
+    void MoveGroup(GroupQueueInfo* ginfo, uint8 groupType);
+    GroupQueueInfo* FindRatedArenaOpponent(GroupQueueInfo const* ginfo, uint32 maxPlayersPerTeam) const;
+
+    RatedGroupsIndex m_RatedGroups[MAX_BATTLEGROUND_BRACKETS];
     BattlegroundTypeId m_bgTypeId;
     ArenaType m_arenaType;
     uint32 m_WaitTimes[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS][COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME];
@@ -222,6 +222,80 @@ Unit* HostileReference::GetSourceUnit()
     return (GetSource()->GetOwner());
 }
 
+//============================================================
+//============== HostileReferenceList ========================
+//============================================================
+
+HostileReferenceList::const_iterator HostileReferenceList::begin() const
+{
+    uint32 index = 0;
+    while (index < _entries.size() && _entries[index].removed)
+        ++index;
+
+    return const_iterator(this, index);
+}
+
+void HostileReferenceList::push_back(HostileReference* ref)
+{
+    _entries.push_back({ ref, ref->getUnitGuid(), false });
+    ++_live;
+}
+
+void HostileReferenceList::remove(HostileReference* ref)
+{
+    for (Entry& entry : _entries)
+    {
+        if (entry.removed || entry.ref != ref)
+            continue;
+
+        entry.removed = true;
+        --_live;
+    }
+}
+
+HostileReference* HostileReferenceList::find(uint64 guid) const
+{
+    for (Entry const& entry : _entries)
+        if (entry.guid == guid && !entry.removed)
+            return entry.ref;
+
+    return nullptr;
+}
+
+void HostileReferenceList::compact()
+{
+    if (_live == _entries.size() || _iterators)
+        return;
+
+    _entries.erase(std::remove_if(_entries.begin(), _entries.end(), [](Entry const& entry) { return entry.removed; }), _entries.end());
+}
+
+void HostileReferenceList::sortByThreat()
+{
+    ASSERT(!_iterators);
+    compact();
+
+    // the order of the last call mostly holds, insertion sort only moves the references whose threat changed
+    // far enough to pass others; long lists (world bosses) fall back to a merge sort
+    if (_entries.size() > 64)
+    {
+        std::stable_sort(_entries.begin(), _entries.end(), [](Entry const& left, Entry const& right) { return left.ref->getThreat() > right.ref->getThreat(); });
+        return;
+    }
+
+    for (size_t i = 1; i < _entries.size(); ++i)
+    {
+        Entry entry = _entries[i];
+        float threat = entry.ref->getThreat();
+
+        size_t j = i;
+        for (; j > 0 && threat > _entries[j - 1].ref->getThreat(); --j)
+            _entries[j] = _entries[j - 1];
+
+        _entries[j] = entry;
+    }
+}
+
 //============================================================
 //================ ThreatContainer ===========================
 //============================================================
@@ -244,15 +318,7 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* victim) const
     if (!victim)
         return nullptr;
 
-    uint64 const guid = victim->GetGUID();
-    for (ThreatContainer::StorageType::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-    {
-        HostileReference* ref = (*i);
-        if (ref && ref->getUnitGuid() == guid)
-            return ref;
-    }
-
-    return nullptr;
+    return iThreatList.find(victim->GetGUID());
 }
 
 //============================================================
@@ -279,8 +345,14 @@ void ThreatContainer::modifyThreatPercent(Unit* victim, int32 percent)
 
 void ThreatContainer::update()
 {
+    // a walk over the list is still running up the stack, sort once it is done
+    if (iThreatList.isIterated())
+        return;
+
     if (iDirty && iThreatList.size() > 1)
-        iThreatList.sort(acore::ThreatOrderPred());
+        iThreatList.sortByThreat();
+    else
+        iThreatList.compact();              // only does something if references were removed
 
     iDirty = false;
 }
@@ -293,6 +365,9 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* attacker, HostileR
 {
     // pussywizard: pretty much remade this whole function
 
+    if (iThreatList.empty())
+        return nullptr;
+
     HostileReference* currentRef = nullptr;
     bool found = false;
     bool noPriorityTargetFound = false;
@@ -307,6 +382,10 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* attacker, HostileR
             currentVictim = nullptr;
     }
 
+    // threat another target needs to pull aggro, in melee range (110%) and anywhere (130%)
+    float const meleePullThreat = currentVictim ? 1.1f * currentVictim->getThreat() : 0.0f;
+    float const rangedPullThreat = currentVictim ? 1.3f * currentVictim->getThreat() : 0.0f;
+
     ThreatContainer::StorageType::const_iterator lastRef = iThreatList.end();
     --lastRef;
 
@@ -347,12 +426,12 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* attacker, HostileR
                 }
 
                 // pussywizard: implement 110% threat rule for targets in melee range and 130% rule for targets in ranged distances
-                if (currentRef->getThreat() > 1.3f * currentVictim->getThreat()) // pussywizard: enough in all cases, end
+                if (currentRef->getThreat() > rangedPullThreat) // pussywizard: enough in all cases, end
                 {
                     found = true;
                     break;
                 }
-                else if (currentRef->getThreat() > 1.1f * currentVictim->getThreat()) // pussywizard: enought only if target in melee range
+                else if (currentRef->getThreat() > meleePullThreat) // pussywizard: enought only if target in melee range
                 {
                     if (attacker->IsWithinMeleeRange(target))
                     {
@@ -590,6 +669,12 @@ bool ThreatManager::isNeedUpdateToClient(uint32 time)
     return false;
 }
 
+void ThreatManager::compactThreatLists()
+{
+    iThreatContainer.compact();
+    iThreatOfflineContainer.compact();
+}
+
 // Reset all aggro without modifying the threatlist.
 void ThreatManager::resetAllAggro()
 {
@@ -11,7 +11,9 @@
 #include "LinkedReference/Reference.h"
 #include "SharedDefines.h"
 #include "UnitEvents.h"
+#include <iterator>
 #include <list>
+#include <vector>
 
 //==============================================================
 
@@ -117,6 +119,134 @@ private:
     bool iOnline;
 };
 
+//==============================================================
+// HostileReferences of a ThreatContainer, stored contiguously with the guid of their target.
+// Like the std::list it replaces, it may be modified while it is iterated (adding threat can create
+// references and move them between the online and offline containers): iterators are indexes, so
+// appended references are still visited and removed references are only marked and skipped.
+// Marked slots are dropped by compact(), at the points where the list used to be sorted, but never
+// while an iterator of the list exists: the indexes of a walk higher up the stack must stay valid.
+
+class HostileReferenceList
+{
+    struct Entry
+    {
+        HostileReference* ref;
+        uint64 guid;
+        bool removed;
+    };
+
+public:
+    class const_iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef HostileReference* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef HostileReference* const* pointer;
+        typedef HostileReference* const& reference;
+
+        const_iterator() : _list(nullptr), _index(0) { }
+        const_iterator(const_iterator const& right) : _list(right._list), _index(right._index) { Acquire(); }
+        ~const_iterator() { Release(); }
+
+        const_iterator& operator=(const_iterator const& right)
+        {
+            if (_list != right._list)
+            {
+                Release();
+                _list = right._list;
+                Acquire();
+            }
+
+            _index = right._index;
+            return *this;
+        }
+
+        reference operator*() const { return _list->_entries[_index].ref; }
+        pointer operator->() const { return &_list->_entries[_index].ref; }
+
+        const_iterator& operator++()
+        {
+            do
+                ++_index;
+            while (_index < _list->_entries.size() && _list->_entries[_index].removed);
+            return *this;
+        }
+
+        const_iterator& operator--()
+        {
+            do
+                --_index;
+            while (_index > 0 && _list->_entries[_index].removed);
+            return *this;
+        }
+
+        const_iterator operator++(int) { const_iterator itr = *this; ++(*this); return itr; }
+        const_iterator operator--(int) { const_iterator itr = *this; --(*this); return itr; }
+
+        bool operator==(const_iterator const& right) const { return _index == right._index; }
+        bool operator!=(const_iterator const& right) const { return _index != right._index; }
+
+    private:
+        friend class HostileReferenceList;
+        const_iterator(HostileReferenceList const* list, uint32 index) : _list(list), _index(index) { Acquire(); }
+
+        void Acquire() { if (_list) ++_list->_iterators; }
+        void Release() { if (_list) --_list->_iterators; }
+
+        HostileReferenceList const* _list;
+        uint32 _index;
+    };
+
+    typedef const_iterator iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef const_reverse_iterator reverse_iterator;
+    typedef HostileReference* value_type;
+    typedef std::size_t size_type;
+
+    HostileReferenceList() : _live(0), _iterators(0) { }
+    // copies (scripts keep their own threat list) are not iterated yet
+    HostileReferenceList(HostileReferenceList const& right) : _entries(right._entries), _live(right._live), _iterators(0) { }
+    HostileReferenceList& operator=(HostileReferenceList const& right)
+    {
+        _entries = right._entries;
+        _live = right._live;
+        return *this;
+    }
+
+    // begin and end are evaluated on every call: references appended during an iteration are part of it
+    [[nodiscard]] const_iterator begin() const;
+    [[nodiscard]] const_iterator end() const { return const_iterator(this, uint32(_entries.size())); }
+    [[nodiscard]] const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    [[nodiscard]] const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    [[nodiscard]] bool empty() const { return !_live; }
+    [[nodiscard]] size_type size() const { return _live; }
+    [[nodiscard]] HostileReference* front() const { return *begin(); }
+    [[nodiscard]] HostileReference* back() const { return *(--end()); }
+
+    void push_back(HostileReference* ref);
+    void remove(HostileReference* ref);
+    void clear() { _entries.clear(); _live = 0; }
+
+    // linear search over the guids, no reference is dereferenced
+    [[nodiscard]] HostileReference* find(uint64 guid) const;
+
+    [[nodiscard]] bool isIterated() const { return _iterators != 0; }
+
+    // drops the slots of removed references, does nothing while the list is iterated
+    void compact();
+    // by threat, highest first, stable like std::list::sort; cheap when only a few references moved since the last call.
+    // Must not be called while the list is iterated.
+    void sortByThreat();
+
+private:
+    std::vector<Entry> _entries;
+    uint32 _live;
+    mutable uint32 _iterators;      // const_iterators of this list alive, compact() waits until they are gone
+};
+
 //==============================================================
 class ThreatManager;
 
@@ -125,7 +255,7 @@ class ThreatContainer
     friend class ThreatManager;
 
 public:
-    typedef std::list<HostileReference*> StorageType;
+    typedef HostileReferenceList StorageType;
 
     ThreatContainer() { }
 
@@ -171,6 +301,8 @@ private:
     // Sort the list if necessary
     void update();
 
+    void compact() { iThreatList.compact(); }
+
     StorageType iThreatList;
     bool iDirty{false};
 };
@@ -218,6 +350,9 @@ public:
 
     void setDirty(bool isDirty) { iThreatContainer.setDirty(isDirty); }
 
+    // drops the slots of removed references, nothing may iterate the lists meanwhile (Unit::Update)
+    void compactThreatLists();
+
     // Reset all aggro without modifying the threadlist.
     void resetAllAggro();
 
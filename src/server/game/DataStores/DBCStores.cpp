@@ -5,13 +5,16 @@
  */
 
 #include "BattlegroundMgr.h"
+#include "DatabaseEnv.h"
 #include "DBCFileLoader.h"
 #include "DBCfmt.h"
+#include "DBCImage.h"
 #include "DBCStores.h"
 #include "Errors.h"
 #include "Log.h"
 #include "SharedDefines.h"
 #include "SpellMgr.h"
+#include "StringFormat.h"
 #include "TransportMgr.h"
 #include "World.h"
 #include <fstream>
@@ -181,6 +184,9 @@ typedef std::list<std::string> StoreProblemList;
 
 uint32 DBCFileCount = 0;
 
+// mapped for the lifetime of the server when DBC.CacheFile is set, image backed stores point into it
+static DBCImage sDBCImage;
+
 static bool LoadDBC_assert_print(uint32 fsize, uint32 rsize, const std::string& filename)
 {
     sLog->outError("Size of '%s' set by format string (%u) not equal size of C++ structure (%u).", filename.c_str(), fsize, rsize);
@@ -238,16 +244,11 @@ inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCSt
     }
 }
 
-void LoadDBCStores(const std::string& dataPath)
+// calls visit(storage, dbc file, override table) for every store loaded at startup
+template<class Visitor>
+static void VisitDBCStores(Visitor&& visit)
 {
-    uint32 oldMSTime = getMSTime();
-
-    std::string dbcPath = dataPath + "dbc/";
-
-    StoreProblemList bad_dbc_files;
-    uint32 availableDbcLocales = 0xFFFFFFFF;
-
-#define LOAD_DBC(store, file, dbtable) LoadDBC(availableDbcLocales, bad_dbc_files, store, dbcPath, file, dbtable)
+#define LOAD_DBC(store, file, dbtable) visit(store, file, dbtable)
 
     LOAD_DBC(sAreaTableStore,                       "AreaTable.dbc",                        "areatable_dbc");
     LOAD_DBC(sAchievementStore,                     "Achievement.dbc",                      "achievement_dbc");
@@ -355,6 +356,83 @@ void LoadDBCStores(const std::string& dataPath)
     LOAD_DBC(sWorldMapOverlayStore,                 "WorldMapOverlay.dbc",                  "worldmapoverlay_dbc");
 
 #undef LOAD_DBC
+}
+
+// sources of a DBC cache: formats and dbc files of the stores (all locales) and the contents of the override tables
+static uint64 GetDBCImageSourceHash(std::string const& dbcPath)
+{
+    DBCImageHash hash;
+    std::string tables;
+
+    VisitDBCStores([&](DBCStorageBase& storage, char const* filename, char const* dbTable)
+    {
+        hash.Add(std::string(filename));
+        hash.Add(std::string(storage.GetFormat()));
+        hash.AddFile(dbcPath + filename);
+        for (uint8 i = 0; i < TOTAL_LOCALES; ++i)
+            hash.AddFile(dbcPath + localeNames[i] + '/' + filename);
+
+        if (dbTable)
+        {
+            if (!tables.empty())
+                tables += ", ";
+            tables += acore::StringFormat("`%s`", dbTable);
+        }
+    });
+
+    // computed by the database server, missing tables have a NULL checksum
+    if (QueryResult result = WorldDatabase.Query(("CHECKSUM TABLE " + tables).c_str()))
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            hash.Add(fields[0].GetString());
+            hash.Add(fields[1].IsNull() ? uint64(0) : fields[1].GetUInt64());
+        } while (result->NextRow());
+    }
+
+    return hash.GetValue();
+}
+
+void LoadDBCStores(const std::string& dataPath, std::string const& cacheFile)
+{
+    uint32 oldMSTime = getMSTime();
+
+    std::string dbcPath = dataPath + "dbc/";
+
+    StoreProblemList bad_dbc_files;
+    uint32 availableDbcLocales = 0xFFFFFFFF;
+
+    uint64 imageHash = 0;
+    bool useImage = false;
+    std::unique_ptr<DBCImageWriter> imageWriter;
+    if (!cacheFile.empty())
+    {
+        imageHash = GetDBCImageSourceHash(dbcPath);
+        useImage = sDBCImage.Open(cacheFile, imageHash);
+        if (!useImage)
+            imageWriter = std::make_unique<DBCImageWriter>();
+    }
+
+    uint32 imageStores = 0;
+    VisitDBCStores([&](auto& storage, char const* filename, char const* dbTable)
+    {
+        if (useImage && storage.LoadFromImage(sDBCImage, filename))
+        {
+            ++DBCFileCount;
+            ++imageStores;
+            return;
+        }
+
+        LoadDBC(availableDbcLocales, bad_dbc_files, storage, dbcPath, filename, dbTable);
+
+        // copied before the fixups below, they are done again on the mapped stores
+        if (imageWriter && storage.GetNumRows())
+            storage.WriteToImage(*imageWriter, filename);
+    });
+
+    if (imageStores)
+        sLog->outString(">> Mapped %u data stores from DBC cache %s%s", imageStores, cacheFile.c_str(), sDBCImage.IsRelocated() ? " (relocated)" : "");
 
     for (CharStartOutfitEntry const* outfit : sCharStartOutfitStore)
         sCharStartOutfitMap[outfit->Race | (outfit->Class << 8) | (outfit->Gender << 16)] = outfit;
@@ -590,6 +668,14 @@ void LoadDBCStores(const std::string& dataPath)
         exit(1);
     }
 
+    if (imageWriter)
+    {
+        if (imageWriter->Write(cacheFile, imageHash))
+            sLog->outString(">> Wrote %u data stores to DBC cache %s", imageWriter->GetStoreCount(), cacheFile.c_str());
+        else
+            sLog->outError("Could not write DBC cache %s", cacheFile.c_str());
+    }
+
     LoadM2Cameras(dataPath);
 
     sLog->outString(">> Initialized %d data stores in %u ms", DBCFileCount, GetMSTimeDiffToNow(oldMSTime));
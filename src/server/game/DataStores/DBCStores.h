@@ -165,7 +165,7 @@ extern DBCStorage <WMOAreaTableEntry>            sWMOAreaTableStore;
 extern DBCStorage <WorldMapOverlayEntry>         sWorldMapOverlayStore;
 extern std::unordered_map<uint32, FlyByCameraCollection> sFlyByCameraStore;
 
-void LoadDBCStores(const std::string& dataPath);
+void LoadDBCStores(const std::string& dataPath, std::string const& cacheFile);
 void LoadM2Cameras(const std::string& dataPath);
 
 #endif
@@ -321,12 +321,23 @@ namespace lfg
         else if (task == 1)
         {
             this->lastProposalId = m_lfgProposalId; // pussywizard: task 2 is done independantly, store previous value in LFGMgr for future use
-            uint8 newGroupsProcessed = 0;
+            uint32 newGroupsProcessed = 0;
+            uint32 matchTimeBudget = sWorld->getIntConfig(CONFIG_LFG_MATCH_TIME_BUDGET);
+            uint32 startTime = getMSTime();
             // Check if a proposal can be formed with the new groups being added
-            for (LfgQueueContainer::iterator it = QueuesStore.begin(); it != QueuesStore.end(); ++it)
+            // more than one group is matched only within the time budget, and never after a proposal was created (task 2 handles only one)
+            for (;;)
             {
-                newGroupsProcessed += it->second.FindGroups();
-                if (newGroupsProcessed)
+                uint8 processed = 0;
+                for (LfgQueueContainer::iterator it = QueuesStore.begin(); it != QueuesStore.end(); ++it)
+                {
+                    processed = it->second.FindGroups();
+                    if (processed)
+                        break;
+                }
+
+                newGroupsProcessed += processed;
+                if (!processed || lastProposalId != m_lfgProposalId || GetMSTimeDiffToNow(startTime) >= matchTimeBudget)
                     break;
             }
 
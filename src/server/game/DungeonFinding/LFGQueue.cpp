@@ -25,10 +25,50 @@
 #include "ObjectDefines.h"
 #include "ObjectMgr.h"
 #include "World.h"
+#include <chrono>
 
 namespace lfg
 {
 
+    std::atomic<uint64> LFGQueue::_matches[LFG_MATCH_STATS_BUCKETS];
+    std::atomic<uint64> LFGQueue::_matchTime[LFG_MATCH_STATS_BUCKETS];
+    std::atomic<uint64> LFGQueue::_matchChecks(0);
+    std::atomic<uint32> LFGQueue::_maxMatchTime(0);
+    std::atomic<uint32> LFGQueue::_maxMatchTimeQueued(0);
+    std::atomic<uint32> LFGQueue::_maxMatchTimeCompatibles(0);
+
+    void LfgQueueData::BuildMatchData()
+    {
+        dungeonMask.reset();
+        dungeonMaskComplete = true;
+        for (LfgDungeonSet::const_iterator it = dungeons.begin(); it != dungeons.end(); ++it)
+        {
+            if (*it < LFG_DUNGEON_MASK_SIZE)
+                dungeonMask.set(*it);
+            else
+                dungeonMaskComplete = false;
+        }
+
+        onlyTanks = 0;
+        onlyHealers = 0;
+        onlyDps = 0;
+        for (LfgRolesMap::const_iterator it = roles.begin(); it != roles.end(); ++it)
+        {
+            switch (it->second & ~PLAYER_ROLE_LEADER)
+            {
+                case PLAYER_ROLE_TANK:
+                    ++onlyTanks;
+                    break;
+                case PLAYER_ROLE_HEALER:
+                    ++onlyHealers;
+                    break;
+                case PLAYER_ROLE_DAMAGE:
+                    ++onlyDps;
+                    break;
+            }
+        }
+    }
+
     void LFGQueue::AddToQueue(uint64 guid, bool failedProposal)
     {
         //sLog->outString("ADD AddToQueue: %u, failed proposal: %u", GUID_LOPART(guid), failedProposal ? 1 : 0);
@@ -145,12 +185,19 @@ namespace lfg
     void LFGQueue::RemoveFromCompatibles(uint64 guid)
     {
         //sLog->outString("COMPATIBLES REMOVE for: %u", GUID_LOPART(guid));
-        for (LfgCompatibleContainer::iterator it = CompatibleList.begin(); it != CompatibleList.end(); ++it)
-            if (it->hasGuid(guid))
+        LfgCompatibleIndex::iterator itIndex = CompatiblesByGuid.find(guid);
+        if (itIndex != CompatiblesByGuid.end())
+        {
+            for (LfgCompatibleContainer::iterator it : itIndex->second)
             {
                 //sLog->outString("Removed Compatible: %s, because of guid: %u", it->toString().c_str(), GUID_LOPART(guid));
+                for (uint8 i = 0; i < 5 && it->guid[i]; ++i)
+                    if (it->guid[i] != guid)
+                        UnindexCompatible(it->guid[i], it);
                 it->clear(); // set to 0, this will be removed while iterating in FindNewGroups
             }
+            CompatiblesByGuid.erase(itIndex);
+        }
         for (LfgCompatibleContainer::iterator itr = CompatibleTempList.begin(); itr != CompatibleTempList.end(); )
         {
             LfgCompatibleContainer::iterator it = itr++;
@@ -168,6 +215,38 @@ namespace lfg
         CompatibleTempList.push_back(key);
     }
 
+    // called before CompatibleTempList is spliced into CompatibleList, the iterators stay valid
+    void LFGQueue::IndexNewCompatibles(bool front)
+    {
+        if (front)
+        {
+            for (LfgCompatibleContainer::reverse_iterator itr = CompatibleTempList.rbegin(); itr != CompatibleTempList.rend(); ++itr)
+                for (uint8 i = 0; i < 5 && itr->guid[i]; ++i)
+                {
+                    std::vector<LfgCompatibleContainer::iterator>& compatibles = CompatiblesByGuid[itr->guid[i]];
+                    compatibles.insert(compatibles.begin(), std::prev(itr.base()));
+                }
+        }
+        else
+        {
+            for (LfgCompatibleContainer::iterator itr = CompatibleTempList.begin(); itr != CompatibleTempList.end(); ++itr)
+                for (uint8 i = 0; i < 5 && itr->guid[i]; ++i)
+                    CompatiblesByGuid[itr->guid[i]].push_back(itr);
+        }
+    }
+
+    void LFGQueue::UnindexCompatible(uint64 guid, LfgCompatibleContainer::iterator itr)
+    {
+        LfgCompatibleIndex::iterator itIndex = CompatiblesByGuid.find(guid);
+        if (itIndex == CompatiblesByGuid.end())
+            return;
+
+        std::vector<LfgCompatibleContainer::iterator>& compatibles = itIndex->second;
+        compatibles.erase(std::remove(compatibles.begin(), compatibles.end(), itr), compatibles.end());
+        if (compatibles.empty())
+            CompatiblesByGuid.erase(itIndex);
+    }
+
     uint8 LFGQueue::FindGroups()
     {
         //sLog->outString("FIND GROUPS!");
@@ -180,17 +259,53 @@ namespace lfg
             //sLog->outString("newToQueueStore guid: %u, front: %u", GUID_LOPART(newGuid), pushCompatiblesToFront ? 1 : 0);
             RemoveFromNewQueue(newGuid);
 
-            FindNewGroups(newGuid);
+            uint32 queued = uint32(QueueDataStore.size());
+            uint32 compatibles = uint32(CompatibleList.size());
+            uint32 checks = 0;
+            auto startTime = std::chrono::steady_clock::now();
+
+            FindNewGroups(newGuid, checks);
 
+            IndexNewCompatibles(pushCompatiblesToFront);
             CompatibleList.splice((pushCompatiblesToFront ? CompatibleList.begin() : CompatibleList.end()), CompatibleTempList);
             CompatibleTempList.clear();
 
-            return newGroupsProcessed; // pussywizard: only one per update, shouldn't be a problem
+            uint32 matchTime = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count());
+            uint8 bucket = queued < 100 ? 0 : queued < 250 ? 1 : queued < 500 ? 2 : queued < 1000 ? 3 : 4;
+            _matches[bucket].fetch_add(1, std::memory_order_relaxed);
+            _matchTime[bucket].fetch_add(matchTime, std::memory_order_relaxed);
+            _matchChecks.fetch_add(checks, std::memory_order_relaxed);
+            // only one queue is matched at a time (lfg update task), no need for compare exchange
+            if (matchTime > _maxMatchTime.load(std::memory_order_relaxed))
+            {
+                _maxMatchTime.store(matchTime, std::memory_order_relaxed);
+                _maxMatchTimeQueued.store(queued, std::memory_order_relaxed);
+                _maxMatchTimeCompatibles.store(compatibles, std::memory_order_relaxed);
+            }
+
+            sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::FindGroups: [" UI64FMTD "] checked against %u of %u compatibles, %u queued, %uus", newGuid, checks, compatibles, queued, matchTime);
+
+            return newGroupsProcessed;
         }
         return newGroupsProcessed;
     }
 
-    LfgCompatibility LFGQueue::FindNewGroups(const uint64& newGuid)
+    LfgMatchStats LFGQueue::GetMatchStats()
+    {
+        LfgMatchStats stats;
+        for (uint8 i = 0; i < LFG_MATCH_STATS_BUCKETS; ++i)
+        {
+            stats.matches[i] = _matches[i].load(std::memory_order_relaxed);
+            stats.time[i] = _matchTime[i].load(std::memory_order_relaxed);
+        }
+        stats.checks = _matchChecks.load(std::memory_order_relaxed);
+        stats.maxTime = _maxMatchTime.load(std::memory_order_relaxed);
+        stats.maxTimeQueued = _maxMatchTimeQueued.load(std::memory_order_relaxed);
+        stats.maxTimeCompatibles = _maxMatchTimeCompatibles.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    LfgCompatibility LFGQueue::FindNewGroups(const uint64& newGuid, uint32& checks)
     {
         // each combination of dps+heal+tank (tank*8 + heal+4 + dps) has a value assigned 0..15
         // first 16 bits of the mask are for marking if such combination was found once, second 16 bits for marking second occurence of that combination, etc
@@ -202,19 +317,15 @@ namespace lfg
         // we have to take into account that FindNewGroups is called every X minutes if number of compatibles is low!
         // build set of already present compatibles for this guid
         std::set<Lfg5Guids> currentCompatibles;
-        for (Lfg5GuidsList::iterator it = CompatibleList.begin(); it != CompatibleList.end(); ++it)
-            if (it->hasGuid(newGuid))
-            {
-                // unset roles here so they are not copied, restore after insertion
-                LfgRolesMap* r = it->roles;
-                it->roles = nullptr;
-                currentCompatibles.insert(*it);
-                it->roles = r;
-            }
+        LfgCompatibleIndex::const_iterator itIndex = CompatiblesByGuid.find(newGuid);
+        if (itIndex != CompatiblesByGuid.end())
+            for (LfgCompatibleContainer::iterator it : itIndex->second)
+                currentCompatibles.insert(Lfg5Guids(*it, false)); // roles are not needed
 
         LfgCompatibility selfCompatibility = LFG_COMPATIBILITY_PENDING;
         if (currentCompatibles.empty())
         {
+            ++checks;
             selfCompatibility = CheckCompatibility(Lfg5Guids(), newGuid, foundMask, foundCount, currentCompatibles);
             if (selfCompatibility != LFG_COMPATIBLES_WITH_LESS_PLAYERS) // group is already compatible (a party of 5 players)
                 return selfCompatibility;
@@ -229,6 +340,7 @@ namespace lfg
                 CompatibleList.erase(itr);
                 continue;
             }
+            ++checks;
             LfgCompatibility compatibility = CheckCompatibility(*itr, newGuid, foundMask, foundCount, currentCompatibles);
             if (compatibility == LFG_COMPATIBLES_MATCH)
                 return LFG_COMPATIBLES_MATCH;
@@ -260,6 +372,7 @@ namespace lfg
         uint8 numLfgGroups = 0;
         uint64 guid;
         uint64 addToFoundMask = 0;
+        LfgQueueData const* queues[5] = { };
 
         for (uint8 i = 0; i < 5 && (guid = check.guid[i]) != 0 && numLfgGroups < 2 && numPlayers <= MAXGROUPSIZE; ++i)
         {
@@ -270,6 +383,7 @@ namespace lfg
                 RemoveFromQueue(guid);
                 return LFG_COMPATIBILITY_PENDING;
             }
+            queues[i] = &itQueue->second;
 
             // Store group so we don't need to call Mgr to get it later (if it's player group will be 0 otherwise would have joined as group)
             for (LfgRolesMap::const_iterator it2 = itQueue->second.roles.begin(); it2 != itQueue->second.roles.end(); ++it2)
@@ -309,9 +423,30 @@ namespace lfg
         // If it's single group no need to check for duplicate players, ignores, bad roles or bad dungeons as it's been checked before joining
         if (check.size() > 1)
         {
+            // cheap rejections first, most combinations fail here: no common dungeon or too many players for a role they are limited to
+            LfgDungeonMask dungeonMask = queues[0]->dungeonMask;
+            bool dungeonMaskComplete = queues[0]->dungeonMaskComplete;
+            uint8 onlyTanks = queues[0]->onlyTanks;
+            uint8 onlyHealers = queues[0]->onlyHealers;
+            uint8 onlyDps = queues[0]->onlyDps;
+            for (uint8 i = 1; i < 5 && queues[i]; ++i)
+            {
+                dungeonMask &= queues[i]->dungeonMask;
+                dungeonMaskComplete = dungeonMaskComplete && queues[i]->dungeonMaskComplete;
+                onlyTanks += queues[i]->onlyTanks;
+                onlyHealers += queues[i]->onlyHealers;
+                onlyDps += queues[i]->onlyDps;
+            }
+
+            if (dungeonMaskComplete && dungeonMask.none())
+                return LFG_INCOMPATIBLES_NO_DUNGEONS;
+
+            if (onlyTanks > LFG_TANKS_NEEDED || onlyHealers > LFG_HEALERS_NEEDED || onlyDps > LFG_DPS_NEEDED)
+                return LFG_INCOMPATIBLES_NO_ROLES;
+
             for (uint8 i = 0; i < 5 && check.guid[i]; ++i)
             {
-                const LfgRolesMap& roles = QueueDataStore[check.guid[i]].roles;
+                const LfgRolesMap& roles = queues[i]->roles;
                 for (LfgRolesMap::const_iterator itRoles = roles.begin(); itRoles != roles.end(); ++itRoles)
                 {
                     LfgRolesMap::const_iterator itPlayer;
@@ -364,22 +499,34 @@ namespace lfg
             else
                 addToFoundMask |= (((uint64)1) << (roleCheckResult - 1));
 
-            proposalDungeons = QueueDataStore[check.front()].dungeons;
-            for (uint8 i = 1; i < 5 && check.guid[i]; ++i)
+            // the common dungeons are only needed to create a proposal, the mask told there are some
+            if (numPlayers == MAXGROUPSIZE || !dungeonMaskComplete)
             {
-                LfgDungeonSet temporal;
-                LfgDungeonSet& dungeons = QueueDataStore[check.guid[i]].dungeons;
-                std::set_intersection(proposalDungeons.begin(), proposalDungeons.end(), dungeons.begin(), dungeons.end(), std::inserter(temporal, temporal.begin()));
-                proposalDungeons = temporal;
-            }
+                if (dungeonMaskComplete)
+                {
+                    for (LfgDungeonSet::const_iterator it = queues[0]->dungeons.begin(); it != queues[0]->dungeons.end(); ++it)
+                        if (dungeonMask.test(*it))
+                            proposalDungeons.insert(proposalDungeons.end(), *it);
+                }
+                else
+                {
+                    proposalDungeons = queues[0]->dungeons;
+                    for (uint8 i = 1; i < 5 && queues[i]; ++i)
+                    {
+                        LfgDungeonSet temporal;
+                        LfgDungeonSet const& dungeons = queues[i]->dungeons;
+                        std::set_intersection(proposalDungeons.begin(), proposalDungeons.end(), dungeons.begin(), dungeons.end(), std::inserter(temporal, temporal.begin()));
+                        proposalDungeons = temporal;
+                    }
+                }
 
-            if (proposalDungeons.empty())
-                return LFG_INCOMPATIBLES_NO_DUNGEONS;
+                if (proposalDungeons.empty())
+                    return LFG_INCOMPATIBLES_NO_DUNGEONS;
+            }
         }
         else
         {
-            uint64 gguid = check.front();
-            const LfgQueueData& queue = QueueDataStore[gguid];
+            const LfgQueueData& queue = *queues[0];
             proposalDungeons = queue.dungeons;
             proposalRoles = queue.roles;
             LFGMgr::CheckGroupRoles(proposalRoles);          // assing new roles
@@ -550,14 +697,13 @@ namespace lfg
 
     uint32 LFGQueue::FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue)
     {
-        uint32 numOfCompatibles = 0;
-        for (LfgCompatibleContainer::const_iterator itr = CompatibleList.begin(); itr != CompatibleList.end(); ++itr)
-            if (itr->hasGuid(itrQueue->first))
-            {
-                ++numOfCompatibles;
-                UpdateBestCompatibleInQueue(itrQueue, *itr);
-            }
-        return numOfCompatibles;
+        LfgCompatibleIndex::const_iterator itIndex = CompatiblesByGuid.find(itrQueue->first);
+        if (itIndex == CompatiblesByGuid.end())
+            return 0;
+
+        for (LfgCompatibleContainer::iterator itr : itIndex->second)
+            UpdateBestCompatibleInQueue(itrQueue, *itr);
+        return uint32(itIndex->second.size());
     }
 
     void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, Lfg5Guids const& key)
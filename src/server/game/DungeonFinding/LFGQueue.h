@@ -8,10 +8,21 @@
 #define _LFGQUEUE_H
 
 #include "LFG.h"
+#include <atomic>
+#include <bitset>
+#include <unordered_map>
 
 namespace lfg
 {
 
+    enum LfgMatchEnum
+    {
+        LFG_DUNGEON_MASK_SIZE                          = 512,  // above the highest LFGDungeons.dbc id
+        LFG_MATCH_STATS_BUCKETS                        = 5     // queue sizes below 100, 250, 500, 1000 and above
+    };
+
+    typedef std::bitset<LFG_DUNGEON_MASK_SIZE> LfgDungeonMask;
+
     enum LfgCompatibility
     {
         LFG_COMPATIBILITY_PENDING,
@@ -35,7 +46,12 @@ namespace lfg
         LfgQueueData(time_t _joinTime, LfgDungeonSet const& _dungeons, LfgRolesMap const& _roles):
             joinTime(_joinTime), lastRefreshTime(_joinTime), tanks(LFG_TANKS_NEEDED), healers(LFG_HEALERS_NEEDED),
             dps(LFG_DPS_NEEDED), dungeons(_dungeons), roles(_roles)
-        { }
+        {
+            BuildMatchData();
+        }
+
+        /// Fills the fields below used to reject combinations before the full check
+        void BuildMatchData();
 
         time_t joinTime;                                       ///< Player queue join time (to calculate wait times)
         time_t lastRefreshTime;                                ///< pussywizard
@@ -45,6 +61,22 @@ namespace lfg
         LfgDungeonSet dungeons;                                ///< Selected Player/Group Dungeon/s
         LfgRolesMap roles;                                     ///< Selected Player Role/s
         Lfg5Guids bestCompatible;                              ///< Best compatible combination of people queued
+        LfgDungeonMask dungeonMask;                            ///< Bits of the ids in dungeons
+        bool dungeonMaskComplete = true;                       ///< False if an id in dungeons does not fit in dungeonMask
+        uint8 onlyTanks = 0;                                   ///< Players who selected no other role than tank
+        uint8 onlyHealers = 0;                                 ///< Players who selected no other role than healer
+        uint8 onlyDps = 0;                                     ///< Players who selected no other role than dps
+    };
+
+    /// Time spent by LFGQueue::FindGroups, by size of the queue
+    struct LfgMatchStats
+    {
+        uint64 matches[LFG_MATCH_STATS_BUCKETS];               ///< Calls of FindGroups
+        uint64 time[LFG_MATCH_STATS_BUCKETS];                  ///< Their total time, in microseconds
+        uint64 checks;                                         ///< Combinations checked by all calls
+        uint32 maxTime;                                        ///< Slowest call, in microseconds
+        uint32 maxTimeQueued;                                  ///< Queued groups at the slowest call
+        uint32 maxTimeCompatibles;                             ///< Compatible combinations at the slowest call
     };
 
     struct LfgWaitTime
@@ -57,6 +89,7 @@ namespace lfg
     typedef std::map<uint32, LfgWaitTime> LfgWaitTimesContainer;
     typedef std::map<uint64, LfgQueueData> LfgQueueDataContainer;
     typedef std::list<Lfg5Guids> LfgCompatibleContainer;
+    typedef std::unordered_map<uint64, std::vector<LfgCompatibleContainer::iterator>> LfgCompatibleIndex;
 
     /**
         Stores all data related to queue
@@ -83,6 +116,8 @@ namespace lfg
         // Find new group
         uint8 FindGroups();
 
+        static LfgMatchStats GetMatchStats();
+
     private:
         void SetQueueUpdateData(std::string const& strGuids, LfgRolesMap const& proposalRoles);
 
@@ -91,11 +126,13 @@ namespace lfg
 
         void RemoveFromCompatibles(uint64 guid);
         void AddToCompatibles(Lfg5Guids const& key);
+        void IndexNewCompatibles(bool front);
+        void UnindexCompatible(uint64 guid, LfgCompatibleContainer::iterator itr);
 
         uint32 FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue);
         void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, Lfg5Guids const& key);
 
-        LfgCompatibility FindNewGroups(const uint64& newGuid);
+        LfgCompatibility FindNewGroups(const uint64& newGuid, uint32& checks);
         LfgCompatibility CheckCompatibility(Lfg5Guids const& checkWith, const uint64& newGuid, uint64& foundMask, uint32& foundCount, const std::set<Lfg5Guids>& currentCompatibles);
 
         // Queue
@@ -103,6 +140,7 @@ namespace lfg
         LfgQueueDataContainer QueueDataStore;              ///< Queued groups
         LfgCompatibleContainer CompatibleList;             ///< Compatible dungeons
         LfgCompatibleContainer CompatibleTempList;         ///< new compatibles are added to this container while main one is being iterated
+        LfgCompatibleIndex CompatiblesByGuid;              ///< Compatibles of CompatibleList containing each guid, in list order
 
         LfgWaitTimesContainer waitTimesAvgStore;           ///< Average wait time to find a group queuing as multiple roles
         LfgWaitTimesContainer waitTimesTankStore;          ///< Average wait time to find a group queuing as tank
@@ -110,6 +148,13 @@ namespace lfg
         LfgWaitTimesContainer waitTimesDpsStore;           ///< Average wait time to find a group queuing as dps
         LfgGuidList newToQueueStore;                       ///< New groups to add to queue
         LfgGuidList restoredAfterProposal;
+
+        static std::atomic<uint64> _matches[LFG_MATCH_STATS_BUCKETS];
+        static std::atomic<uint64> _matchTime[LFG_MATCH_STATS_BUCKETS];
+        static std::atomic<uint64> _matchChecks;
+        static std::atomic<uint32> _maxMatchTime;
+        static std::atomic<uint32> _maxMatchTimeQueued;
+        static std::atomic<uint32> _maxMatchTimeCompatibles;
     };
 
 } // namespace lfg
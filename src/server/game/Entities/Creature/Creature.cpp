@@ -215,7 +215,10 @@ void Creature::AddToWorld()
         Motion_Initialize();
 
         if (GetZoneScript())
+        {
+            auto guard = GetMap()->GuardIslandUpdate();
             GetZoneScript()->OnCreatureCreate(this);
+        }
 
         sObjectAccessor->AddObject(this);
         Unit::AddToWorld();
@@ -237,7 +240,10 @@ void Creature::RemoveFromWorld()
         sEluna->OnRemoveFromWorld(this);
 #endif
         if (GetZoneScript())
+        {
+            auto guard = GetMap()->GuardIslandUpdate();
             GetZoneScript()->OnCreatureRemove(this);
+        }
         if (m_formation)
             sFormationMgr->RemoveCreatureFromGroup(m_formation, this);
         if (Transport* transport = GetTransport())
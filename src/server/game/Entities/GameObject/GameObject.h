@@ -732,7 +732,8 @@ public:
     explicit GameObject();
     ~GameObject() override;
 
-    void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+    void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target, TargetFieldList* targetFields = nullptr) const override;
+    [[nodiscard]] uint32 GetValuesUpdateFieldForTarget(uint16 index, uint8 updatetype, Player* target) const override;
 
     void AddToWorld() override;
     void RemoveFromWorld() override;
@@ -467,7 +467,7 @@ void Object::BuildMovementUpdate(ByteBuffer* data, uint16 flags) const
         *data << int64(ToGameObject()->GetPackedWorldRotation());
 }
 
-void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) const
+void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target, TargetFieldList* /*targetFields*/) const
 {
     if (!target)
         return;
@@ -506,7 +506,7 @@ void Object::ClearUpdateMask(bool remove)
     }
 }
 
-void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) const
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, ValuesUpdateCache* cache) const
 {
     UpdateDataMapType::iterator iter = data_map.find(player);
 
@@ -517,7 +517,49 @@ void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) cons
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    if (!cache)
+    {
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+        return;
+    }
+
+    // the update mask and most values depend only on the visible flags, build them once per flag combination
+    uint32* flags = nullptr;
+    uint32 visibleFlag = GetUpdateFieldData(player, flags);
+
+    ValuesUpdateCacheEntry* entry = nullptr;
+    for (ValuesUpdateCacheEntry& cached : *cache)
+        if (cached.visibleFlag == visibleFlag)
+        {
+            entry = &cached;
+            break;
+        }
+
+    if (!entry)
+    {
+        cache->push_back({ visibleFlag, ByteBuffer(500), TargetFieldList() });
+        entry = &cache->back();
+
+        entry->block << (uint8) UPDATETYPE_VALUES;
+        entry->block.append(GetPackGUID());
+
+        BuildValuesUpdate(UPDATETYPE_VALUES, &entry->block, player, &entry->targetFields);
+
+        iter->second.AddUpdateBlock(entry->block);
+        return;
+    }
+
+    if (entry->targetFields.empty())
+    {
+        iter->second.AddUpdateBlock(entry->block);
+        return;
+    }
+
+    ByteBuffer buf(entry->block);
+    for (auto const& field : entry->targetFields)
+        buf.put<uint32>(field.first, GetValuesUpdateFieldForTarget(field.second, UPDATETYPE_VALUES, player));
+
+    iter->second.AddUpdateBlock(buf);
 }
 
 uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
@@ -1162,19 +1204,9 @@ bool WorldObject::IsWithinLOS(float ox, float oy, float oz, LineOfSightChecks ch
 {
     if (IsInWorld())
     {
-        oz += GetCollisionHeight();
-        float x, y, z;
-        if (GetTypeId() == TYPEID_PLAYER)
-        {
-            GetPosition(x, y, z);
-            z += GetCollisionHeight();
-        }
-        else
-        {
-            GetHitSpherePointFor({ ox, oy, oz }, x, y, z);
-        }
-
-        return GetMap()->isInLineOfSight(x, y, z, ox, oy, oz, GetPhaseMask(), checks);
+        VMAP::LineOfSightRay ray;
+        GetLineOfSightRay(ox, oy, oz, ray);
+        return GetMap()->isInLineOfSight(ray.x1, ray.y1, ray.z1, ray.x2, ray.y2, ray.z2, ray.phaseMask, checks);
     }
     return true;
 }
@@ -1184,25 +1216,48 @@ bool WorldObject::IsWithinLOSInMap(const WorldObject* obj, LineOfSightChecks che
    if (!IsInMap(obj))
         return false;
 
-    float ox, oy, oz;
+    VMAP::LineOfSightRay ray;
+    GetLineOfSightRay(obj, ray);
+    return GetMap()->isInLineOfSight(ray.x1, ray.y1, ray.z1, ray.x2, ray.y2, ray.z2, ray.phaseMask, checks);
+}
+
+void WorldObject::GetLineOfSightRay(float ox, float oy, float oz, VMAP::LineOfSightRay& ray) const
+{
+    ray.x2 = ox;
+    ray.y2 = oy;
+    ray.z2 = oz + GetCollisionHeight();
+    if (GetTypeId() == TYPEID_PLAYER)
+    {
+        GetPosition(ray.x1, ray.y1, ray.z1);
+        ray.z1 += GetCollisionHeight();
+    }
+    else
+        GetHitSpherePointFor({ ray.x2, ray.y2, ray.z2 }, ray.x1, ray.y1, ray.z1);
+
+    ray.phaseMask = GetPhaseMask();
+    ray.inLineOfSight = true;
+}
+
+void WorldObject::GetLineOfSightRay(WorldObject const* obj, VMAP::LineOfSightRay& ray) const
+{
     if (obj->GetTypeId() == TYPEID_PLAYER)
     {
-        obj->GetPosition(ox, oy, oz);
-        oz += obj->GetCollisionHeight();
+        obj->GetPosition(ray.x2, ray.y2, ray.z2);
+        ray.z2 += obj->GetCollisionHeight();
     }
     else
-        obj->GetHitSpherePointFor({ GetPositionX(), GetPositionY(), GetPositionZ() + GetCollisionHeight() }, ox, oy, oz);
+        obj->GetHitSpherePointFor({ GetPositionX(), GetPositionY(), GetPositionZ() + GetCollisionHeight() }, ray.x2, ray.y2, ray.z2);
 
-    float x, y, z;
     if (GetTypeId() == TYPEID_PLAYER)
     {
-        GetPosition(x, y, z);
-        z += GetCollisionHeight();
+        GetPosition(ray.x1, ray.y1, ray.z1);
+        ray.z1 += GetCollisionHeight();
     }
     else
-        GetHitSpherePointFor({ obj->GetPositionX(), obj->GetPositionY(), obj->GetPositionZ() + obj->GetCollisionHeight() }, x, y, z);
+        GetHitSpherePointFor({ obj->GetPositionX(), obj->GetPositionY(), obj->GetPositionZ() + obj->GetCollisionHeight() }, ray.x1, ray.y1, ray.z1);
 
-    return GetMap()->isInLineOfSight(x, y, z, ox, oy, oz, GetPhaseMask(), checks);
+    ray.phaseMask = GetPhaseMask();
+    ray.inLineOfSight = true;
 }
 
 void WorldObject::GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z) const
@@ -2955,6 +3010,7 @@ struct WorldObjectChangeAccumulator
     UpdateDataMapType& i_updateDatas;
     UpdatePlayerSet& i_playerSet;
     WorldObject& i_object;
+    ValuesUpdateCache i_valuesCache;
     WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d, UpdatePlayerSet& p) : i_updateDatas(d), i_playerSet(p), i_object(obj)
     {
         i_playerSet.clear();
@@ -3015,12 +3071,12 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (i_playerSet.find(player->GetGUIDLow()) == i_playerSet.end() && player->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(player, i_updateDatas);
+            i_object.BuildFieldsUpdate(player, i_updateDatas, &i_valuesCache);
             i_playerSet.insert(player->GetGUIDLow());
         }
     }
 
-    template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
+    template<class SKIP> void Visit(GridObjectList<SKIP>&) {}
 };
 
 void WorldObject::BuildUpdate(UpdateDataMapType& data_map, UpdatePlayerSet& player_set)
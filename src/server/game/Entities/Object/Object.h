@@ -10,7 +10,7 @@
 #include "Common.h"
 #include "DataMap.h"
 #include "GridDefines.h"
-#include "GridReference.h"
+#include "GridObjectList.h"
 #include "Map.h"
 #include "ObjectDefines.h"
 #include "UpdateData.h"
@@ -96,9 +96,27 @@ class Transport;
 class StaticTransport;
 class MotionTransport;
 
+namespace VMAP
+{
+    struct LineOfSightRay;
+}
+
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 typedef std::unordered_set<uint32> UpdatePlayerSet;
 
+// offset in the block and index of a field whose value depends on the receiver, not only on its visible flags
+typedef std::vector<std::pair<uint32, uint16>> TargetFieldList;
+
+// values update block of one object, shared by all receivers with the same visible flags during one BuildUpdate
+struct ValuesUpdateCacheEntry
+{
+    uint32 visibleFlag;
+    ByteBuffer block;
+    TargetFieldList targetFields;
+};
+
+typedef std::vector<ValuesUpdateCacheEntry> ValuesUpdateCache;
+
 class Object
 {
 public:
@@ -281,7 +299,7 @@ public:
     [[nodiscard]] virtual bool hasQuest(uint32 /* quest_id */) const { return false; }
     [[nodiscard]] virtual bool hasInvolvedQuest(uint32 /* quest_id */) const { return false; }
     virtual void BuildUpdate(UpdateDataMapType&, UpdatePlayerSet&) {}
-    void BuildFieldsUpdate(Player*, UpdateDataMapType&) const;
+    void BuildFieldsUpdate(Player*, UpdateDataMapType&, ValuesUpdateCache* cache = nullptr) const;
 
     void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; }
     void RemoveFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags &= ~flag; }
@@ -318,7 +336,9 @@ protected:
     uint32 GetUpdateFieldData(Player const* target, uint32*& flags) const;
 
     void BuildMovementUpdate(ByteBuffer* data, uint16 flags) const;
-    virtual void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const;
+    // targetFields, if given, receives the fields written with GetValuesUpdateFieldForTarget
+    virtual void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target, TargetFieldList* targetFields = nullptr) const;
+    [[nodiscard]] virtual uint32 GetValuesUpdateFieldForTarget(uint16 index, uint8 /*updatetype*/, Player* /*target*/) const { return m_uint32Values[index]; }
 
     uint16 m_objectType;
 
@@ -687,17 +707,6 @@ public:
     uint32 m_mapId;
 };
 
-template<class T>
-class GridObject
-{
-public:
-    [[nodiscard]] bool IsInGrid() const { return _gridRef.isValid(); }
-    void AddToGrid(GridRefManager<T>& m) { ASSERT(!IsInGrid()); _gridRef.link(&m, (T*)this); }
-    void RemoveFromGrid() { ASSERT(IsInGrid()); _gridRef.unlink(); }
-private:
-    GridReference<T> _gridRef;
-};
-
 template <class T_VALUES, class T_FLAGS, class FLAG_TYPE, uint8 ARRAY_SIZE>
 class FlaggedValuesArray32
 {
@@ -896,6 +905,9 @@ public:
     }
     [[nodiscard]] bool IsWithinLOS(float x, float y, float z, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS) const;
     bool IsWithinLOSInMap(WorldObject const* obj, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS) const;
+    // the ray IsWithinLOS and IsWithinLOSInMap test, for checking many objects at once (Map::isInLineOfSight)
+    void GetLineOfSightRay(float x, float y, float z, VMAP::LineOfSightRay& ray) const;
+    void GetLineOfSightRay(WorldObject const* obj, VMAP::LineOfSightRay& ray) const;
     [[nodiscard]] Position GetHitSpherePointFor(Position const& dest) const;
     void GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z) const;
     bool GetDistanceOrder(WorldObject const* obj1, WorldObject const* obj2, bool is3D = true) const;
@@ -12,6 +12,8 @@
 #include "World.h"
 #include "WorldPacket.h"
 #include "zlib.h"
+#include <atomic>
+#include <chrono>
 
 UpdateData::UpdateData() : m_blockCount(0)
 {
@@ -35,29 +37,84 @@ void UpdateData::AddUpdateBlock(const UpdateData& block)
     m_blockCount += block.m_blockCount;
 }
 
-void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+namespace
 {
-    z_stream c_stream;
+    // deflate state is ~256KB, keep one per thread and reset it instead of init/end for every packet.
+    // One per level, deflateParams on a reused stream may flush into the previous packet's buffer.
+    struct UpdateDataCompressor
+    {
+        z_stream stream;
+        bool initialized{false};
+
+        ~UpdateDataCompressor()
+        {
+            if (initialized)
+                deflateEnd(&stream);
+        }
 
-    c_stream.zalloc = (alloc_func)0;
-    c_stream.zfree = (free_func)0;
-    c_stream.opaque = (voidpf)0;
+        bool Prepare(int level)
+        {
+            if (!initialized)
+            {
+                stream.zalloc = (alloc_func)0;
+                stream.zfree = (free_func)0;
+                stream.opaque = (voidpf)0;
+
+                int z_res = deflateInit(&stream, level);
+                if (z_res != Z_OK)
+                {
+                    sLog->outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+                    return false;
+                }
+
+                initialized = true;
+                return true;
+            }
+
+            int z_res = deflateReset(&stream);
+            if (z_res != Z_OK)
+            {
+                sLog->outError("Can't compress update packet (zlib: deflateReset) Error code: %i (%s)", z_res, zError(z_res));
+                return false;
+            }
+
+            return true;
+        }
+    };
 
-    // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld->getIntConfig(CONFIG_COMPRESSION));
-    if (z_res != Z_OK)
+    // indexed by level, CONFIG_COMPRESSION is 1..9, only the levels in use get a stream
+    thread_local UpdateDataCompressor t_compressors[Z_BEST_COMPRESSION + 1];
+
+    std::atomic<uint64> s_compressedPackets(0);
+    std::atomic<uint64> s_uncompressedPackets(0);
+    std::atomic<uint64> s_bytesIn(0);
+    std::atomic<uint64> s_bytesOut(0);
+    std::atomic<uint64> s_compressTime(0);
+}
+
+void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+{
+    // default Z_BEST_SPEED (1), the cheapest level while the world update is lagging
+    int level = sWorld->getIntConfig(CONFIG_COMPRESSION);
+    uint32 adaptiveDiff = sWorld->getIntConfig(CONFIG_COMPRESSION_ADAPTIVE_DIFF);
+    if (adaptiveDiff && sWorld->GetUpdateTime() > adaptiveDiff)
+        level = Z_BEST_SPEED;
+
+    UpdateDataCompressor& compressor = t_compressors[level];
+    if (!compressor.Prepare(level))
     {
-        sLog->outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
         *dst_size = 0;
         return;
     }
 
+    z_stream& c_stream = compressor.stream;
+
     c_stream.next_out = (Bytef*)dst;
     c_stream.avail_out = *dst_size;
     c_stream.next_in = (Bytef*)src;
     c_stream.avail_in = (uInt)src_size;
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
+    int z_res = deflate(&c_stream, Z_NO_FLUSH);
     if (z_res != Z_OK)
     {
         sLog->outError("Can't compress update packet (zlib: deflate) Error code: %i (%s)", z_res, zError(z_res));
@@ -80,14 +137,6 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        sLog->outError("Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
     *dst_size = c_stream.total_out;
 }
 
@@ -114,8 +163,10 @@ bool UpdateData::BuildPacket(WorldPacket* packet)
 
     size_t pSize = buf.wpos();                              // use real used data size
 
-    if (pSize > 100)                                       // compress large packets
+    if (pSize > sWorld->getIntConfig(CONFIG_COMPRESSION_MIN_SIZE)) // compress large packets
     {
+        auto startTime = std::chrono::steady_clock::now();
+
         uint32 destsize = compressBound(pSize);
         packet->resize(destsize + sizeof(uint32));
 
@@ -124,18 +175,46 @@ bool UpdateData::BuildPacket(WorldPacket* packet)
         if (destsize == 0)
             return false;
 
+        s_compressTime.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count(), std::memory_order_relaxed);
+
+        // didn't pay off, spare the client the inflate
+        if (destsize + sizeof(uint32) >= pSize)
+        {
+            packet->clear();
+            packet->append(buf);
+            packet->SetOpcode(SMSG_UPDATE_OBJECT);
+            s_uncompressedPackets.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
         packet->resize(destsize + sizeof(uint32));
         packet->SetOpcode(SMSG_COMPRESSED_UPDATE_OBJECT);
+
+        s_compressedPackets.fetch_add(1, std::memory_order_relaxed);
+        s_bytesIn.fetch_add(pSize, std::memory_order_relaxed);
+        s_bytesOut.fetch_add(destsize + sizeof(uint32), std::memory_order_relaxed);
     }
     else                                                    // send small packets without compression
     {
         packet->append(buf);
         packet->SetOpcode(SMSG_UPDATE_OBJECT);
+        s_uncompressedPackets.fetch_add(1, std::memory_order_relaxed);
     }
 
     return true;
 }
 
+UpdateCompressionStats UpdateData::GetCompressionStats()
+{
+    UpdateCompressionStats stats;
+    stats.compressedPackets = s_compressedPackets.load(std::memory_order_relaxed);
+    stats.uncompressedPackets = s_uncompressedPackets.load(std::memory_order_relaxed);
+    stats.bytesIn = s_bytesIn.load(std::memory_order_relaxed);
+    stats.bytesOut = s_bytesOut.load(std::memory_order_relaxed);
+    stats.compressTime = s_compressTime.load(std::memory_order_relaxed);
+    return stats;
+}
+
 void UpdateData::Clear()
 {
     m_data.clear();
@@ -36,6 +36,15 @@ enum OBJECT_UPDATE_FLAGS
     UPDATEFLAG_ROTATION             = 0x0200
 };
 
+struct UpdateCompressionStats
+{
+    uint64 compressedPackets{0};
+    uint64 uncompressedPackets{0};  // below Compression.MinSize or not worth it
+    uint64 bytesIn{0};              // of the compressed packets
+    uint64 bytesOut{0};
+    uint64 compressTime{0};         // microseconds, includes the attempts that didn't pay off
+};
+
 class UpdateData
 {
 public:
@@ -48,6 +57,9 @@ public:
     [[nodiscard]] bool HasData() const { return m_blockCount > 0 || !m_outOfRangeGUIDs.empty(); }
     void Clear();
 
+    // totals since startup, over all threads
+    static UpdateCompressionStats GetCompressionStats();
+
 protected:
     uint32 m_blockCount;
     std::vector<uint64> m_outOfRangeGUIDs;
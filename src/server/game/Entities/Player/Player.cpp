@@ -753,6 +753,8 @@ Player::Player(WorldSession* session): Unit(true), m_mover(this)
     m_nextSave = SavingSystemMgr::IncreaseSavingMaxValue(1);
     m_additionalSaveTimer = 0;
     m_additionalSaveMask = 0;
+    m_saveUnchangedTables = 0;
+    m_savedAurasKnown = false;
     m_hostileReferenceCheckTimer = 15000;
 
     clearResurrectRequestData();
@@ -2342,7 +2344,8 @@ bool Player::TeleportTo(uint32 mapid, float x, float y, float z, float orientati
         SetHasDelayedTeleport(false); // pussywizard: current teleport cancels stored one
         //if teleport spell is casted in Unit::Update() func
         //then we need to delay it until update process will be finished
-        if (MustDelayTeleport())
+        //same while the continent is updated in islands, they must not move players between each other
+        if (MustDelayTeleport() || (FindMap() && FindMap()->IsUpdatingIslands()))
         {
             SetHasDelayedTeleport(true);
             SetSemaphoreTeleportNear(time(nullptr));
@@ -2404,7 +2407,7 @@ bool Player::TeleportTo(uint32 mapid, float x, float y, float z, float orientati
             SetHasDelayedTeleport(false); // pussywizard: current teleport cancels stored one
             //if teleport spell is casted in Unit::Update() func
             //then we need to delay it until update process will be finished
-            if (MustDelayTeleport())
+            if (MustDelayTeleport() || (FindMap() && FindMap()->IsUpdatingIslands()))
             {
                 SetHasDelayedTeleport(true);
                 SetSemaphoreTeleportFar(time(nullptr));
@@ -5494,8 +5497,10 @@ void Player::SpawnCorpseBones()
             stmt->setUInt32(0, GetGUIDLow());
             trans->Append(stmt);
 
+            CheckSnapshotSaves();
             _SaveAuras(trans, false);
 
+            TrackSnapshotSave(trans);
             CharacterDatabase.CommitTransaction(trans);
         }
 }
@@ -20192,6 +20197,8 @@ void Player::SaveToDB(bool create, bool logout)
         sScriptMgr->OnPlayerSave(this);
 
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
+    m_saveUnchangedTables = 0;
+    CheckSnapshotSaves();
 
     _SaveCharacter(create, trans);
 
@@ -20223,6 +20230,12 @@ void Player::SaveToDB(bool create, bool logout)
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
         _SaveStats(trans);
 
+    uint32 statements = trans->GetSize();
+    uint32 bytes = trans->GetPayloadSize();
+    SavingSystemMgr::RecordPlayerSave(statements, bytes, m_saveUnchangedTables);
+    sLog->outDebug(LOG_FILTER_PLAYER_LOADING, "Player::SaveToDB: %s (GUID: %u) saved, %u statements, %u bytes, %u tables unchanged", GetName().c_str(), GetGUIDLow(), statements, bytes, m_saveUnchangedTables);
+
+    TrackSnapshotSave(trans);
     CharacterDatabase.CommitTransaction(trans);
 
     // save pet (hunter pet level and experience and all type pets health/mana).
@@ -20305,9 +20318,8 @@ void Player::_SaveActions(SQLTransaction& trans)
 
 void Player::_SaveAuras(SQLTransaction& trans, bool logout)
 {
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
-    stmt->setUInt32(0, GetGUIDLow());
-    trans->Append(stmt);
+    // row values of every aura saved now, every value is numeric so nothing needs escaping
+    SavedAuraMap auras;
 
     for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
     {
@@ -20339,26 +20351,85 @@ void Player::_SaveAuras(SQLTransaction& trans, bool logout)
             }
         }
 
-        uint8 index = 0;
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_AURA);
-        stmt->setUInt32(index++, GetGUIDLow());
-        stmt->setUInt64(index++, itr->second->GetCasterGUID());
-        stmt->setUInt64(index++, itr->second->GetCastItemGUID());
-        stmt->setUInt32(index++, itr->second->GetId());
-        stmt->setUInt8(index++, effMask);
-        stmt->setUInt8(index++, recalculateMask);
-        stmt->setUInt8(index++, itr->second->GetStackAmount());
-        stmt->setInt32(index++, damage[0]);
-        stmt->setInt32(index++, damage[1]);
-        stmt->setInt32(index++, damage[2]);
-        stmt->setInt32(index++, baseDamage[0]);
-        stmt->setInt32(index++, baseDamage[1]);
-        stmt->setInt32(index++, baseDamage[2]);
-        stmt->setInt32(index++, itr->second->GetMaxDuration());
-        stmt->setInt32(index++, itr->second->GetDuration());
-        stmt->setUInt8(index, itr->second->GetCharges());
+        std::ostringstream ss;
+        ss << '(' << GetGUIDLow() << ',' << aura->GetCasterGUID() << ',' << aura->GetCastItemGUID() << ',' << aura->GetId() << ','
+            << uint32(effMask) << ',' << uint32(recalculateMask) << ',' << uint32(aura->GetStackAmount()) << ','
+            << damage[0] << ',' << damage[1] << ',' << damage[2] << ',' << baseDamage[0] << ',' << baseDamage[1] << ',' << baseDamage[2] << ','
+            << aura->GetMaxDuration() << ',' << aura->GetDuration() << ',' << uint32(aura->GetCharges()) << ')';
+
+        auras[std::make_tuple(aura->GetCasterGUID(), aura->GetCastItemGUID(), aura->GetId(), effMask)] = ss.str();
+    }
+
+    // rows of new and changed auras, all in one statement
+    std::ostringstream rows;
+    uint32 rowCount = 0;
+
+    // the first save rewrites the table, it may hold rows of an older save
+    if (!m_savedAurasKnown)
+    {
+        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
+        stmt->setUInt32(0, GetGUIDLow());
         trans->Append(stmt);
+
+        for (SavedAuraMap::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
+            rows << (rowCount++ ? "," : "") << itr->second;
+    }
+    else
+    {
+        std::ostringstream removed;
+        uint32 removedCount = 0;
+        for (SavedAuraMap::const_iterator itr = m_lastSavedAuras.begin(); itr != m_lastSavedAuras.end(); ++itr)
+            if (auras.find(itr->first) == auras.end())
+                removed << (removedCount++ ? "," : "") << '(' << std::get<0>(itr->first) << ',' << std::get<1>(itr->first) << ','
+                    << std::get<2>(itr->first) << ',' << uint32(std::get<3>(itr->first)) << ')';
+
+        for (SavedAuraMap::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
+        {
+            SavedAuraMap::const_iterator saved = m_lastSavedAuras.find(itr->first);
+            if (saved == m_lastSavedAuras.end() || saved->second != itr->second)
+                rows << (rowCount++ ? "," : "") << itr->second;
+        }
+
+        if (removedCount)
+        {
+            std::ostringstream ss;
+            ss << "DELETE FROM character_aura WHERE guid = " << GetGUIDLow() << " AND (casterGuid, itemGuid, spell, effectMask) IN (" << removed.str() << ')';
+            trans->Append(ss.str().c_str());
+        }
+
+        if (!removedCount && !rowCount)
+            ++m_saveUnchangedTables;
     }
+
+    if (rowCount)
+    {
+        std::ostringstream ss;
+        ss << "REPLACE INTO character_aura (guid, casterGuid, itemGuid, spell, effectMask, recalculateMask, stackcount, amount0, amount1, amount2, "
+            "base_amount0, base_amount1, base_amount2, maxDuration, remainTime, remainCharges) VALUES " << rows.str();
+        trans->Append(ss.str().c_str());
+    }
+
+    m_lastSavedAuras.swap(auras);
+    m_savedAurasKnown = true;
+}
+
+void Player::CheckSnapshotSaves()
+{
+    bool valid = true;
+    for (SQLCommitState const& state : m_snapshotSaves)
+        if (state->load(std::memory_order_acquire) != TRANSACTION_COMMITTED)
+            valid = false;
+
+    m_snapshotSaves.clear();
+    if (valid)
+        return;
+
+    // the database may still hold anything from before these saves
+    m_lastSavedStats.clear();
+    m_lastSavedEntryPoint.clear();
+    m_lastSavedInstanceResetTimes.clear();
+    m_lastSavedAuras.clear();
+    m_savedAurasKnown = false;
 }
 
 void Player::_SaveInventory(SQLTransaction& trans)
@@ -20861,6 +20932,39 @@ void Player::_SaveStats(SQLTransaction& trans)
     if (!sWorld->getIntConfig(CONFIG_MIN_LEVEL_STAT_SAVE) || getLevel() < sWorld->getIntConfig(CONFIG_MIN_LEVEL_STAT_SAVE))
         return;
 
+    // column values in statement order, float fields by their raw bits
+    std::vector<uint32> stats;
+    stats.reserve(1 + MAX_POWERS + MAX_STATS + MAX_SPELL_SCHOOL + 10);
+    stats.push_back(GetMaxHealth());
+
+    for (uint8 i = 0; i < MAX_POWERS; ++i)
+        stats.push_back(GetMaxPower(Powers(i)));
+
+    for (uint8 i = 0; i < MAX_STATS; ++i)
+        stats.push_back(GetStat(Stats(i)));
+
+    for (int i = 0; i < MAX_SPELL_SCHOOL; ++i)
+        stats.push_back(GetResistance(SpellSchools(i)));
+
+    size_t firstFloat = stats.size();
+    stats.push_back(GetUInt32Value(PLAYER_BLOCK_PERCENTAGE));
+    stats.push_back(GetUInt32Value(PLAYER_DODGE_PERCENTAGE));
+    stats.push_back(GetUInt32Value(PLAYER_PARRY_PERCENTAGE));
+    stats.push_back(GetUInt32Value(PLAYER_CRIT_PERCENTAGE));
+    stats.push_back(GetUInt32Value(PLAYER_RANGED_CRIT_PERCENTAGE));
+    stats.push_back(GetUInt32Value(PLAYER_SPELL_CRIT_PERCENTAGE1));
+    size_t lastFloat = stats.size();
+    stats.push_back(GetUInt32Value(UNIT_FIELD_ATTACK_POWER));
+    stats.push_back(GetUInt32Value(UNIT_FIELD_RANGED_ATTACK_POWER));
+    stats.push_back(GetBaseSpellPowerBonus());
+    stats.push_back(GetUInt32Value(PLAYER_FIELD_COMBAT_RATING_1 + CR_CRIT_TAKEN_SPELL));
+
+    if (stats == m_lastSavedStats)
+    {
+        ++m_saveUnchangedTables;
+        return;
+    }
+
     PreparedStatement* stmt = nullptr;
 
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_STATS);
@@ -20871,29 +20975,22 @@ void Player::_SaveStats(SQLTransaction& trans)
 
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_STATS);
     stmt->setUInt32(index++, GetGUIDLow());
-    stmt->setUInt32(index++, GetMaxHealth());
-
-    for (uint8 i = 0; i < MAX_POWERS; ++i)
-        stmt->setUInt32(index++, GetMaxPower(Powers(i)));
 
-    for (uint8 i = 0; i < MAX_STATS; ++i)
-        stmt->setUInt32(index++, GetStat(Stats(i)));
-
-    for (int i = 0; i < MAX_SPELL_SCHOOL; ++i)
-        stmt->setUInt32(index++, GetResistance(SpellSchools(i)));
-
-    stmt->setFloat(index++, GetFloatValue(PLAYER_BLOCK_PERCENTAGE));
-    stmt->setFloat(index++, GetFloatValue(PLAYER_DODGE_PERCENTAGE));
-    stmt->setFloat(index++, GetFloatValue(PLAYER_PARRY_PERCENTAGE));
-    stmt->setFloat(index++, GetFloatValue(PLAYER_CRIT_PERCENTAGE));
-    stmt->setFloat(index++, GetFloatValue(PLAYER_RANGED_CRIT_PERCENTAGE));
-    stmt->setFloat(index++, GetFloatValue(PLAYER_SPELL_CRIT_PERCENTAGE1));
-    stmt->setUInt32(index++, GetUInt32Value(UNIT_FIELD_ATTACK_POWER));
-    stmt->setUInt32(index++, GetUInt32Value(UNIT_FIELD_RANGED_ATTACK_POWER));
-    stmt->setUInt32(index++, GetBaseSpellPowerBonus());
-    stmt->setUInt32(index++, GetUInt32Value(PLAYER_FIELD_COMBAT_RATING_1 + CR_CRIT_TAKEN_SPELL));
+    for (size_t i = 0; i < stats.size(); ++i)
+    {
+        if (i >= firstFloat && i < lastFloat)
+        {
+            float value;
+            memcpy(&value, &stats[i], sizeof(value));
+            stmt->setFloat(index++, value);
+        }
+        else
+            stmt->setUInt32(index++, stats[i]);
+    }
 
     trans->Append(stmt);
+
+    m_lastSavedStats.swap(stats);
 }
 
 void Player::outDebugValues() const
@@ -26882,6 +26979,37 @@ void Player::_SaveEntryPoint(SQLTransaction& trans)
     if (!mEntry)
         return;
 
+    // stored fields, the position by the raw bits of its floats
+    std::vector<uint32> entryPoint;
+    entryPoint.reserve(6 + m_entryPointData.taxiPath.size());
+    entryPoint.push_back(m_entryPointData.joinPos.GetMapId());
+
+    float const position[4] = { m_entryPointData.joinPos.GetPositionX(), m_entryPointData.joinPos.GetPositionY(),
+        m_entryPointData.joinPos.GetPositionZ(), m_entryPointData.joinPos.GetOrientation() };
+    for (float value : position)
+    {
+        uint32 bits;
+        memcpy(&bits, &value, sizeof(bits));
+        entryPoint.push_back(bits);
+    }
+
+    entryPoint.push_back(m_entryPointData.mountSpell);
+    if (m_entryPointData.HasTaxiPath())
+        entryPoint.insert(entryPoint.end(), m_entryPointData.taxiPath.begin(), m_entryPointData.taxiPath.end());
+
+    if (entryPoint == m_lastSavedEntryPoint)
+    {
+        ++m_saveUnchangedTables;
+        return;
+    }
+
+    std::ostringstream ss("");
+    if (m_entryPointData.HasTaxiPath())
+    {
+        for (size_t i = 0; i < m_entryPointData.taxiPath.size(); ++i)
+            ss << m_entryPointData.taxiPath[i] << ' '; // xinef: segment is stored as last point
+    }
+
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PLAYER_ENTRY_POINT);
     stmt->setUInt32(0, GetGUIDLow());
     trans->Append(stmt);
@@ -26892,17 +27020,11 @@ void Player::_SaveEntryPoint(SQLTransaction& trans)
     stmt->setFloat (3, m_entryPointData.joinPos.GetPositionZ());
     stmt->setFloat (4, m_entryPointData.joinPos.GetOrientation());
     stmt->setUInt32(5, m_entryPointData.joinPos.GetMapId());
-
-    std::ostringstream ss("");
-    if (m_entryPointData.HasTaxiPath())
-    {
-        for (size_t i = 0; i < m_entryPointData.taxiPath.size(); ++i)
-            ss << m_entryPointData.taxiPath[i] << ' '; // xinef: segment is stored as last point
-    }
-
     stmt->setString(6, ss.str());
     stmt->setUInt32(7, m_entryPointData.mountSpell);
     trans->Append(stmt);
+
+    m_lastSavedEntryPoint.swap(entryPoint);
 }
 
 void Player::DeleteEquipmentSet(uint64 setGuid)
@@ -28082,18 +28204,29 @@ void Player::_SaveInstanceTimeRestrictions(SQLTransaction& trans)
     if (_instanceResetTimes.empty())
         return;
 
+    if (_instanceResetTimes == m_lastSavedInstanceResetTimes)
+    {
+        ++m_saveUnchangedTables;
+        return;
+    }
+
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ACCOUNT_INSTANCE_LOCK_TIMES);
     stmt->setUInt32(0, GetSession()->GetAccountId());
     trans->Append(stmt);
 
+    std::ostringstream ss;
+    ss << "INSERT INTO account_instance_times (accountId, instanceId, releaseTime) VALUES ";
     for (InstanceTimeMap::const_iterator itr = _instanceResetTimes.begin(); itr != _instanceResetTimes.end(); ++itr)
     {
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_ACCOUNT_INSTANCE_LOCK_TIMES);
-        stmt->setUInt32(0, GetSession()->GetAccountId());
-        stmt->setUInt32(1, itr->first);
-        stmt->setUInt64(2, itr->second);
-        trans->Append(stmt);
+        if (itr != _instanceResetTimes.begin())
+            ss << ',';
+
+        ss << '(' << GetSession()->GetAccountId() << ',' << itr->first << ',' << uint64(itr->second) << ')';
     }
+
+    trans->Append(ss.str().c_str());
+
+    m_lastSavedInstanceResetTimes = _instanceResetTimes;
 }
 
 bool Player::IsInWhisperWhiteList(uint64 guid)
@@ -21,6 +21,7 @@
 #include "Unit.h"
 #include "WorldSession.h"
 #include <string>
+#include <tuple>
 #include <vector>
 
 struct CreatureTemplate;
@@ -2740,6 +2741,23 @@ protected:
     void _SaveCharacter(bool create, SQLTransaction& trans);
     void _SaveInstanceTimeRestrictions(SQLTransaction& trans);
 
+    // state written by the last save of the full-rewrite tables, these are skipped while unchanged
+    std::vector<uint32> m_lastSavedStats;
+    std::vector<uint32> m_lastSavedEntryPoint;
+    InstanceTimeMap m_lastSavedInstanceResetTimes;
+    uint32 m_saveUnchangedTables;
+
+    // character_aura rows written so far by primary key (casterGuid, itemGuid, spell, effectMask), only differences are saved
+    typedef std::map<std::tuple<uint64, uint64, uint32, uint8>, std::string> SavedAuraMap;
+    SavedAuraMap m_lastSavedAuras;
+    bool m_savedAurasKnown;             // false until the first save rewrote the table
+
+    // transactions the snapshots above were taken for. They describe the database only once all of them committed,
+    // a failed or still running one makes the next save write everything again.
+    std::vector<SQLCommitState> m_snapshotSaves;
+    void CheckSnapshotSaves();
+    void TrackSnapshotSave(SQLTransaction& trans) { m_snapshotSaves.push_back(trans->GetCommitState()); }
+
     /*********************************************************/
     /***              ENVIRONMENTAL SYSTEM                 ***/
     /*********************************************************/
@@ -7,6 +7,7 @@
 #ifndef __UNIT_H
 #define __UNIT_H
 
+#include "AuraEffectArray.h"
 #include "EventProcessor.h"
 #include "FollowerReference.h"
 #include "FollowerRefManager.h"
@@ -1394,7 +1395,7 @@ public:
     typedef std::multimap<AuraStateType,  AuraApplication*> AuraStateAurasMap;
     typedef std::pair<AuraStateAurasMap::const_iterator, AuraStateAurasMap::const_iterator> AuraStateAurasMapBounds;
 
-    typedef std::list<AuraEffect*> AuraEffectList;
+    typedef AuraEffectArray AuraEffectList;
     typedef std::list<Aura*> AuraList;
     typedef std::list<AuraApplication*> AuraApplicationList;
     typedef std::list<DiminishingReturn> Diminishing;
@@ -1402,6 +1403,15 @@ public:
 
     typedef std::map<uint8, AuraApplication*> VisibleAuraMap;
 
+    // applied aura that can proc from ProcDamageAndSpellFor, with the proc flags it reacts to
+    struct ProcAuraEntry
+    {
+        uint32 spellId;
+        uint32 procFlags;
+        AuraApplication* aurApp;
+    };
+    typedef std::vector<ProcAuraEntry> ProcAuraIndex;
+
     ~Unit() override;
 
     UnitAI* GetAI() { return i_AI; }
@@ -1951,6 +1961,7 @@ public:
     void _RemoveNoStackAurasDueToAura(Aura* aura);
     bool _IsNoStackAuraDueToAura(Aura* appliedAura, Aura* existingAura) const;
     void _RegisterAuraEffect(AuraEffect* aurEff, bool apply);
+    void _InvalidateAuraEffectTotals(AuraType type) { m_modAuras[type].InvalidateTotals(); }
 
     // m_ownedAuras container management
     AuraMap&       GetOwnedAuras()       { return m_ownedAuras; }
@@ -2494,7 +2505,8 @@ public:
 protected:
     explicit Unit (bool isWorldObject);
 
-    void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+    void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target, TargetFieldList* targetFields = nullptr) const override;
+    [[nodiscard]] uint32 GetValuesUpdateFieldForTarget(uint16 index, uint8 updatetype, Player* target) const override;
 
     UnitAI* i_AI, *i_disabledAI;
 
@@ -2535,6 +2547,9 @@ protected:
     uint32 m_removedAurasCount;
 
     AuraEffectList m_modAuras[TOTAL_AURAS];
+    std::vector<AuraType> m_modAurasToCompact;          // types with effects removed since the last update, see AuraEffectArray
+    ProcAuraIndex m_procAuras;                          // applied auras with proc flags, in the order of m_appliedAuras
+    uint32 m_procAurasGeneration;                       // SpellMgr::GetProcDataGeneration the index was built with
     AuraList m_scAuras;                        // casted singlecast auras
     AuraApplicationList m_interruptableAuras;             // auras which have interrupt mask applied on unit
     AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
@@ -2574,6 +2589,9 @@ protected:
     bool _instantCast;
 
 private:
+    void _AddToProcIndex(AuraApplication* aurApp);
+    void _RemoveFromProcIndex(AuraApplication* aurApp);
+    void _RebuildProcIndex();
     bool IsTriggeredAtSpellProcEvent(Unit* victim, Aura* aura, SpellInfo const* procSpell, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, bool isVictim, bool active, SpellProcEventEntry const*& spellProcEvent, ProcEventInfo const& eventInfo);
     bool HandleDummyAuraProc(Unit* victim, uint32 damage, AuraEffect* triggeredByAura, SpellInfo const* procSpell, uint32 procFlag, uint32 procEx, uint32 cooldown);
     bool HandleAuraProc(Unit* victim, uint32 damage, Aura* triggeredByAura, SpellInfo const* procSpell, uint32 procFlag, uint32 procEx, uint32 cooldown, bool* handled);
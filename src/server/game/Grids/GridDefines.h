@@ -47,11 +47,11 @@ class Player;
 typedef TYPELIST_5(GameObject, Player, Creature/*pets*/, Corpse/*resurrectable*/, DynamicObject/*farsight target*/) AllWorldObjectTypes;
 typedef TYPELIST_4(GameObject, Creature/*except pets*/, DynamicObject, Corpse/*Bones*/) AllGridObjectTypes;
 
-typedef GridRefManager<Corpse>          CorpseMapType;
-typedef GridRefManager<Creature>        CreatureMapType;
-typedef GridRefManager<DynamicObject>   DynamicObjectMapType;
-typedef GridRefManager<GameObject>      GameObjectMapType;
-typedef GridRefManager<Player>          PlayerMapType;
+typedef GridObjectList<Corpse>          CorpseMapType;
+typedef GridObjectList<Creature>        CreatureMapType;
+typedef GridObjectList<DynamicObject>   DynamicObjectMapType;
+typedef GridObjectList<GameObject>      GameObjectMapType;
+typedef GridObjectList<Player>          PlayerMapType;
 
 enum GridMapTypeMask
 {
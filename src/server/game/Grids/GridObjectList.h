@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _GRIDOBJECTLIST_H
+#define _GRIDOBJECTLIST_H
+
+#include "Define.h"
+#include "Errors.h"
+#include <vector>
+
+template<class OBJECT>
+class GridObject;
+
+/*
+ * Objects of one type stored in a grid cell.
+ *
+ * The objects are kept in a dense array, every object remembers its slot (see GridObject)
+ * so removing it is a swap with the last element. Walking a cell reads one contiguous
+ * array instead of following a link stored inside every object.
+ *
+ * Iteration goes from the back, like the linked list it replaces (newest first), and
+ * tolerates changes of the list while visiting: objects added meanwhile are not visited,
+ * objects removed meanwhile leave an empty slot that is skipped, so the order of the other
+ * objects stays the same and none is visited twice. The slots are compacted once the last
+ * iterator of the list is gone.
+ */
+template<class OBJECT>
+class GridObjectList
+{
+    friend class GridObject<OBJECT>;
+
+public:
+    class iterator
+    {
+    public:
+        iterator(GridObjectList* list, size_t position) : _list(list), _position(list->Skip(position)) { ++_list->_iterators; }
+        iterator(iterator const& right) : _list(right._list), _position(right._position) { ++_list->_iterators; }
+        ~iterator() { _list->ReleaseIterator(); }
+
+        iterator& operator=(iterator const& right)
+        {
+            if (this != &right)
+            {
+                ++right._list->_iterators;
+                _list->ReleaseIterator();
+                _list = right._list;
+                _position = right._position;
+            }
+            return *this;
+        }
+
+        OBJECT* GetSource() const { return _list->_objects[_position - 1]; }
+
+        // keeps iter->GetSource() of the reference iterator working
+        iterator const* operator->() const { return this; }
+        OBJECT* operator*() const { return GetSource(); }
+
+        iterator& operator++()
+        {
+            _position = _list->Skip(_position - 1);
+            return *this;
+        }
+
+        bool operator==(iterator const& right) const { return _position == right._position; }
+        bool operator!=(iterator const& right) const { return _position != right._position; }
+
+    private:
+        GridObjectList* _list;
+        size_t _position; // one past the current element
+    };
+
+    GridObjectList() = default;
+    ~GridObjectList()
+    {
+        for (OBJECT* object : _objects)
+            if (object)
+                Link(object)._gridList = nullptr;
+    }
+
+    GridObjectList(GridObjectList const&) = delete;
+    GridObjectList& operator=(GridObjectList const&) = delete;
+
+    iterator begin() { return iterator(this, _objects.size()); }
+    iterator end() { return iterator(this, 0); }
+
+    [[nodiscard]] bool isEmpty() const { return getSize() == 0; }
+    [[nodiscard]] uint32 getSize() const { return uint32(_objects.size() - _removed); }
+
+private:
+    static GridObject<OBJECT>& Link(OBJECT* object) { return *static_cast<GridObject<OBJECT>*>(object); }
+
+    // position of the first object at or before position, empty slots of removed objects are passed over
+    size_t Skip(size_t position) const
+    {
+        while (position && !_objects[position - 1])
+            --position;
+        return position;
+    }
+
+    void insert(OBJECT* object)
+    {
+        GridObject<OBJECT>& link = Link(object);
+        link._gridList = this;
+        link._gridIndex = uint32(_objects.size());
+        _objects.push_back(object);
+    }
+
+    void remove(GridObject<OBJECT>& link)
+    {
+        ASSERT(link._gridList == this && link._gridIndex < _objects.size());
+
+        link._gridList = nullptr;
+
+        // iterated right now, the other objects must keep their slots
+        if (_iterators)
+        {
+            _objects[link._gridIndex] = nullptr;
+            ++_removed;
+            return;
+        }
+
+        OBJECT* last = _objects.back();
+        if (&Link(last) != &link)
+        {
+            _objects[link._gridIndex] = last;
+            Link(last)._gridIndex = link._gridIndex;
+        }
+
+        _objects.pop_back();
+    }
+
+    void ReleaseIterator()
+    {
+        if (--_iterators || !_removed)
+            return;
+
+        // drop the empty slots left by removals while iterating, the order is kept
+        size_t count = 0;
+        for (OBJECT* object : _objects)
+        {
+            if (!object)
+                continue;
+
+            Link(object)._gridIndex = uint32(count);
+            _objects[count++] = object;
+        }
+
+        _objects.resize(count);
+        _removed = 0;
+    }
+
+    std::vector<OBJECT*> _objects;
+    uint32 _iterators{0};   // live iterators, removals only leave an empty slot while there are any
+    uint32 _removed{0};     // empty slots
+};
+
+// Base of the objects stored in grid cells, holds the slot in the cell's GridObjectList
+template<class OBJECT>
+class GridObject
+{
+    friend class GridObjectList<OBJECT>;
+
+public:
+    GridObject() : _gridList(nullptr), _gridIndex(0) { }
+    ~GridObject() { if (IsInGrid()) _gridList->remove(*this); }
+
+    GridObject(GridObject const&) = delete;
+    GridObject& operator=(GridObject const&) = delete;
+
+    [[nodiscard]] bool IsInGrid() const { return _gridList != nullptr; }
+    void AddToGrid(GridObjectList<OBJECT>& m) { ASSERT(!IsInGrid()); m.insert(static_cast<OBJECT*>(this)); }
+    void RemoveFromGrid() { ASSERT(IsInGrid()); _gridList->remove(*this); }
+
+private:
+    GridObjectList<OBJECT>* _gridList;
+    uint32 _gridIndex;
+};
+
+#endif
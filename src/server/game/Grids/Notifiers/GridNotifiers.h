@@ -14,6 +14,7 @@
 #include "Object.h"
 #include "ObjectGridLoader.h"
 #include "Player.h"
+#include "SharedPacket.h"
 #include "Spell.h"
 #include "Unit.h"
 #include "UpdateData.h"
@@ -40,7 +41,7 @@ namespace acore
         }
 
         void Visit(GameObjectMapType&);
-        template<class T> void Visit(GridRefManager<T>& m);
+        template<class T> void Visit(GridObjectList<T>& m);
         void SendToSelf(void);
     };
 
@@ -49,7 +50,7 @@ namespace acore
         WorldObject& i_object;
 
         explicit VisibleChangesNotifier(WorldObject& object) : i_object(object) {}
-        template<class T> void Visit(GridRefManager<T>&) {}
+        template<class T> void Visit(GridObjectList<T>&) {}
         void Visit(PlayerMapType&);
         void Visit(CreatureMapType&);
         void Visit(DynamicObjectMapType&);
@@ -59,7 +60,7 @@ namespace acore
     {
         PlayerRelocationNotifier(Player& player, bool largeOnly) : VisibleNotifier(player, false, largeOnly) {}
 
-        template<class T> void Visit(GridRefManager<T>& m) { VisibleNotifier::Visit(m); }
+        template<class T> void Visit(GridObjectList<T>& m) { VisibleNotifier::Visit(m); }
         void Visit(PlayerMapType&);
     };
 
@@ -67,7 +68,7 @@ namespace acore
     {
         Creature& i_creature;
         CreatureRelocationNotifier(Creature& c) : i_creature(c) {}
-        template<class T> void Visit(GridRefManager<T>&) {}
+        template<class T> void Visit(GridObjectList<T>&) {}
         void Visit(PlayerMapType&);
     };
 
@@ -76,14 +77,14 @@ namespace acore
         Unit& i_unit;
         bool isCreature;
         explicit AIRelocationNotifier(Unit& unit) : i_unit(unit), isCreature(unit.GetTypeId() == TYPEID_UNIT)  {}
-        template<class T> void Visit(GridRefManager<T>&) {}
+        template<class T> void Visit(GridObjectList<T>&) {}
         void Visit(CreatureMapType&);
     };
 
     struct MessageDistDeliverer
     {
         WorldObject* i_source;
-        WorldPacket* i_message;
+        SharedPacket i_message;
         uint32 i_phaseMask;
         float i_distSq;
         TeamId teamId;
@@ -97,7 +98,7 @@ namespace acore
         void Visit(PlayerMapType& m);
         void Visit(CreatureMapType& m);
         void Visit(DynamicObjectMapType& m);
-        template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
+        template<class SKIP> void Visit(GridObjectList<SKIP>&) {}
 
         void SendPacket(Player* player)
         {
@@ -115,7 +116,7 @@ namespace acore
     struct MessageDistDelivererToHostile
     {
         Unit* i_source;
-        WorldPacket* i_message;
+        SharedPacket i_message;
         uint32 i_phaseMask;
         float i_distSq;
         MessageDistDelivererToHostile(Unit* src, WorldPacket* msg, float dist)
@@ -125,7 +126,7 @@ namespace acore
         void Visit(PlayerMapType& m);
         void Visit(CreatureMapType& m);
         void Visit(DynamicObjectMapType& m);
-        template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
+        template<class SKIP> void Visit(GridObjectList<SKIP>&) {}
 
         void SendPacket(Player* player)
         {
@@ -142,7 +143,7 @@ namespace acore
         uint32 i_timeDiff;
         bool i_largeOnly;
         explicit ObjectUpdater(const uint32 diff, bool largeOnly) : i_timeDiff(diff), i_largeOnly(largeOnly) {}
-        template<class T> void Visit(GridRefManager<T>& m);
+        template<class T> void Visit(GridObjectList<T>& m);
         void Visit(PlayerMapType&) {}
         void Visit(CorpseMapType&) {}
     };
@@ -168,7 +169,7 @@ namespace acore
         void Visit(CorpseMapType& m);
         void Visit(DynamicObjectMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Check>
@@ -188,7 +189,7 @@ namespace acore
         void Visit(CorpseMapType& m);
         void Visit(DynamicObjectMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Check>
@@ -208,7 +209,7 @@ namespace acore
         void Visit(GameObjectMapType& m);
         void Visit(DynamicObjectMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Do>
@@ -265,7 +266,7 @@ namespace acore
                     i_do(itr->GetSource());
         }
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     // Gameobject searchers
@@ -282,7 +283,7 @@ namespace acore
 
         void Visit(GameObjectMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     // Last accepted by Check GO if any (Check can change requirements at each call)
@@ -298,7 +299,7 @@ namespace acore
 
         void Visit(GameObjectMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Check>
@@ -313,7 +314,7 @@ namespace acore
 
         void Visit(GameObjectMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Functor>
@@ -329,7 +330,7 @@ namespace acore
                     _func(itr->GetSource());
         }
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
 
     private:
         Functor& _func;
@@ -352,7 +353,7 @@ namespace acore
         void Visit(CreatureMapType& m);
         void Visit(PlayerMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     // Last accepted by Check Unit if any (Check can change requirements at each call)
@@ -369,7 +370,7 @@ namespace acore
         void Visit(CreatureMapType& m);
         void Visit(PlayerMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     // All accepted by Check units if any
@@ -386,7 +387,7 @@ namespace acore
         void Visit(PlayerMapType& m);
         void Visit(CreatureMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     // Creature searchers
@@ -403,7 +404,7 @@ namespace acore
 
         void Visit(CreatureMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     // Last accepted by Check Creature if any (Check can change requirements at each call)
@@ -419,7 +420,7 @@ namespace acore
 
         void Visit(CreatureMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Check>
@@ -434,7 +435,7 @@ namespace acore
 
         void Visit(CreatureMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Do>
@@ -453,7 +454,7 @@ namespace acore
                     i_do(itr->GetSource());
         }
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     // Player searchers
@@ -470,7 +471,7 @@ namespace acore
 
         void Visit(PlayerMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Check>
@@ -485,7 +486,7 @@ namespace acore
 
         void Visit(PlayerMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Check>
@@ -501,7 +502,7 @@ namespace acore
         void Visit(PlayerMapType& m);
         void Visit(CreatureMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Check>
@@ -517,7 +518,7 @@ namespace acore
 
         void Visit(PlayerMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Do>
@@ -536,7 +537,7 @@ namespace acore
                     i_do(itr->GetSource());
         }
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Do>
@@ -556,7 +557,7 @@ namespace acore
                     i_do(itr->GetSource());
         }
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     // CHECKS && DO classes
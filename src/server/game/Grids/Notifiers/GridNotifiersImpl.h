@@ -17,13 +17,13 @@
 #include "WorldPacket.h"
 
 template<class T>
-inline void acore::VisibleNotifier::Visit(GridRefManager<T>& m)
+inline void acore::VisibleNotifier::Visit(GridObjectList<T>& m)
 {
     // Xinef: Update gameobjects only
     if (i_gobjOnly)
         return;
 
-    for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
+    for (typename GridObjectList<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         if (i_largeOnly != iter->GetSource()->IsVisibilityOverridden())
             continue;
@@ -28,7 +28,7 @@ public:
 
     void Visit(CorpseMapType& m);
 
-    template<class T> void Visit(GridRefManager<T>&) { }
+    template<class T> void Visit(GridObjectList<T>&) { }
 
 private:
     Cell i_cell;
@@ -55,7 +55,7 @@ template<> void ObjectGridLoader::SetObjectCell(GameObject* obj, CellCoord const
 }
 
 template <class T>
-void AddObjectHelper(CellCoord& cell, GridRefManager<T>& m, uint32& count, Map* /*map*/, T* obj)
+void AddObjectHelper(CellCoord& cell, GridObjectList<T>& m, uint32& count, Map* /*map*/, T* obj)
 {
     obj->AddToGrid(m);
     ObjectGridLoader::SetObjectCell(obj, cell);
@@ -88,7 +88,7 @@ void AddObjectHelper(CellCoord& cell, GameObjectMapType& m, uint32& count, Map*
 }
 
 template <class T>
-void LoadHelper(CellGuidSet const& guid_set, CellCoord& cell, GridRefManager<T>& m, uint32& count, Map* map)
+void LoadHelper(CellGuidSet const& guid_set, CellCoord& cell, GridObjectList<T>& m, uint32& count, Map* map)
 {
     for (CellGuidSet::const_iterator i_guid = guid_set.begin(); i_guid != guid_set.end(); ++i_guid)
     {
@@ -106,7 +106,7 @@ void LoadHelper(CellGuidSet const& guid_set, CellCoord& cell, GridRefManager<T>&
 }
 
 template <>
-void LoadHelper(CellGuidSet const& guid_set, CellCoord& cell, GridRefManager<GameObject>& m, uint32& count, Map* map)
+void LoadHelper(CellGuidSet const& guid_set, CellCoord& cell, GridObjectList<GameObject>& m, uint32& count, Map* map)
 {
     for (CellGuidSet::const_iterator i_guid = guid_set.begin(); i_guid != guid_set.end(); ++i_guid)
     {
@@ -212,11 +212,11 @@ void ObjectGridLoader::LoadN(void)
 }
 
 template<class T>
-void ObjectGridUnloader::Visit(GridRefManager<T>& m)
+void ObjectGridUnloader::Visit(GridObjectList<T>& m)
 {
     while (!m.isEmpty())
     {
-        T* obj = m.getFirst()->GetSource();
+        T* obj = m.begin()->GetSource();
         // if option set then object already saved at this moment
         //if (!sWorld->getBoolConfig(CONFIG_SAVE_RESPAWN_TIME_IMMEDIATELY))
         //    obj->SaveRespawnTime();
@@ -231,9 +231,9 @@ void ObjectGridUnloader::Visit(GridRefManager<T>& m)
 }
 
 template<class T>
-void ObjectGridCleaner::Visit(GridRefManager<T>& m)
+void ObjectGridCleaner::Visit(GridObjectList<T>& m)
 {
-    for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
+    for (typename GridObjectList<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
         iter->GetSource()->CleanupsBeforeDelete();
 }
 
@@ -46,13 +46,13 @@ private:
 class ObjectGridCleaner
 {
 public:
-    template<class T> void Visit(GridRefManager<T>&);
+    template<class T> void Visit(GridObjectList<T>&);
 };
 
 //Delete objects before deleting NGrid
 class ObjectGridUnloader
 {
 public:
-    template<class T> void Visit(GridRefManager<T>& m);
+    template<class T> void Visit(GridObjectList<T>& m);
 };
 #endif
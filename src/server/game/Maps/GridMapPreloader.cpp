@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "GridMapPreloader.h"
+#include "Map.h"
+#include "MapTree.h"
+#include <chrono>
+#include <cstdio>
+
+namespace
+{
+    // requests beyond this are dropped, players far ahead of the loaders would only queue stale grids
+    size_t const MaxQueuedJobs = 128;
+}
+
+GridMapPreloader::GridMapPreloader() : _stop(false), _requested(0), _used(0), _discarded(0), _preloadTime(0), _syncLoads(0), _syncLoadTime(0)
+{
+}
+
+GridMapPreloader::~GridMapPreloader()
+{
+    Stop();
+}
+
+GridMapPreloader* GridMapPreloader::instance()
+{
+    static GridMapPreloader instance;
+    return &instance;
+}
+
+void GridMapPreloader::Start(uint32 threads, std::string const& dataPath)
+{
+    _dataPath = dataPath;
+    _stop = false;
+
+    for (uint32 i = 0; i < threads; ++i)
+        _workerThreads.push_back(std::thread(&GridMapPreloader::WorkerThread, this));
+}
+
+void GridMapPreloader::Stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _stop = true;
+        _condition.notify_all();
+    }
+
+    for (auto& thread : _workerThreads)
+        thread.join();
+
+    _workerThreads.clear();
+
+    for (auto& finished : _finished)
+        for (Result& result : finished.second)
+            delete result.gridMap;
+
+    _finished.clear();
+    _jobs.clear();
+    _queued.clear();
+}
+
+void GridMapPreloader::Request(uint32 mapId, int gx, int gy)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    if (_stop || _jobs.size() >= MaxQueuedJobs || !_queued.insert(MakeKey(mapId, gx, gy)).second)
+        return;
+
+    _jobs.push_back({ mapId, gx, gy });
+    _requested.fetch_add(1, std::memory_order_relaxed);
+    _condition.notify_one();
+}
+
+void GridMapPreloader::TakeFinished(uint32 mapId, std::vector<Result>& results)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    auto itr = _finished.find(mapId);
+    if (itr == _finished.end() || itr->second.empty())
+        return;
+
+    for (Result const& result : itr->second)
+        _queued.erase(MakeKey(mapId, result.gx, result.gy));
+
+    results.swap(itr->second);
+    itr->second.clear();
+}
+
+void GridMapPreloader::RecordSyncLoad(uint32 time)
+{
+    _syncLoads.fetch_add(1, std::memory_order_relaxed);
+    _syncLoadTime.fetch_add(time, std::memory_order_relaxed);
+}
+
+GridPreloadStats GridMapPreloader::GetStats() const
+{
+    GridPreloadStats stats;
+    stats.requested = _requested.load(std::memory_order_relaxed);
+    stats.used = _used.load(std::memory_order_relaxed);
+    stats.discarded = _discarded.load(std::memory_order_relaxed);
+    stats.preloadTime = _preloadTime.load(std::memory_order_relaxed);
+    stats.syncLoads = _syncLoads.load(std::memory_order_relaxed);
+    stats.syncLoadTime = _syncLoadTime.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void GridMapPreloader::WorkerThread()
+{
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> guard(_lock);
+            while (_jobs.empty() && !_stop)
+                _condition.wait(guard);
+
+            if (_stop)
+                return;
+
+            job = _jobs.front();
+            _jobs.pop_front();
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
+
+        char fileName[32];
+        snprintf(fileName, sizeof(fileName), "maps/%03u%02u%02u.map", job.mapId, job.gx, job.gy);
+        std::string mapFile = _dataPath + fileName;
+
+        GridMap* gridMap = new GridMap();
+        gridMap->loadData(&mapFile[0]);
+
+        // (gx, gy) like Map::LoadVMap and Map::LoadMMap pass them, getTileFileName puts gy first in the vmtile name itself
+        WarmFile(_dataPath + "vmaps/" + VMAP::StaticMapTree::getTileFileName(job.mapId, job.gx, job.gy));
+        snprintf(fileName, sizeof(fileName), "mmaps/%03u%02u%02u.mmtile", job.mapId, job.gx, job.gy);
+        WarmFile(_dataPath + fileName);
+
+        _preloadTime.fetch_add(uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count()), std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> guard(_lock);
+        _finished[job.mapId].push_back({ job.gx, job.gy, gridMap });
+    }
+}
+
+void GridMapPreloader::WarmFile(std::string const& fileName)
+{
+    // only pulls the file into the os cache, the real load happens on the map thread
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if (!file)
+        return;
+
+    char buffer[64 * 1024];
+    while (fread(buffer, 1, sizeof(buffer), file) == sizeof(buffer)) { }
+
+    fclose(file);
+}
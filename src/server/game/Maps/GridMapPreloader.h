@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _GRIDMAPPRELOADER_H
+#define _GRIDMAPPRELOADER_H
+
+#include "Define.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class GridMap;
+
+struct GridPreloadStats
+{
+    uint64 requested;
+    uint64 used;          // grids created from a preloaded terrain file, the map thread did not wait for the disk
+    uint64 discarded;     // finished too late, or expired before a player entered the grid
+    uint64 preloadTime;   // microseconds spent by the preload threads
+    uint64 syncLoads;     // grids players entered before the preloader had their terrain
+    uint64 syncLoadTime;  // milliseconds the map threads spent on them
+};
+
+/*
+ * Loads terrain (.map) files of continent grids on background threads before a player reaches them.
+ * The vmap and mmap tile files of the grid are read as well, so their load on the map thread
+ * does not wait for the disk.
+ *
+ * Finished GridMaps are collected per map and installed by that map's own update (Map::UpdateGridPreload),
+ * grids stay created and object-loaded on the map thread as before.
+ */
+class GridMapPreloader
+{
+public:
+    struct Result
+    {
+        int gx;
+        int gy;
+        GridMap* gridMap;
+    };
+
+    static GridMapPreloader* instance();
+
+    void Start(uint32 threads, std::string const& dataPath);
+    void Stop();
+    [[nodiscard]] bool IsEnabled() const { return !_workerThreads.empty(); }
+
+    // queues the grid, nothing happens if it is already queued or loading
+    void Request(uint32 mapId, int gx, int gy);
+    // moves the finished grids of the map to results
+    void TakeFinished(uint32 mapId, std::vector<Result>& results);
+
+    void RecordUsed() { _used.fetch_add(1, std::memory_order_relaxed); }
+    void RecordDiscarded() { _discarded.fetch_add(1, std::memory_order_relaxed); }
+    // only demand loads the preloader could have avoided, not startup or LoadAllCells
+    void RecordSyncLoad(uint32 time);
+
+    GridPreloadStats GetStats() const;
+
+private:
+    struct Job
+    {
+        uint32 mapId;
+        int gx;
+        int gy;
+    };
+
+    GridMapPreloader();
+    ~GridMapPreloader();
+
+    static uint64 MakeKey(uint32 mapId, int gx, int gy) { return (uint64(mapId) << 16) | (uint32(gx) << 8) | uint32(gy); }
+
+    void WorkerThread();
+    void WarmFile(std::string const& fileName);
+
+    std::string _dataPath;
+    std::vector<std::thread> _workerThreads;
+    bool _stop;
+
+    std::mutex _lock;
+    std::condition_variable _condition;
+    std::deque<Job> _jobs;
+    std::unordered_set<uint64> _queued; // queued, loading or finished but not taken yet
+    std::unordered_map<uint32, std::vector<Result>> _finished;
+
+    std::atomic<uint64> _requested;
+    std::atomic<uint64> _used;
+    std::atomic<uint64> _discarded;
+    std::atomic<uint64> _preloadTime;
+    std::atomic<uint64> _syncLoads;
+    std::atomic<uint64> _syncLoadTime;
+};
+
+#define sGridMapPreloader GridMapPreloader::instance()
+
+#endif
@@ -10,12 +10,14 @@
 #include "DynamicTree.h"
 #include "Geometry.h"
 #include "GridNotifiers.h"
+#include "GridMapPreloader.h"
 #include "GridNotifiersImpl.h"
 #include "Group.h"
 #include "InstanceScript.h"
 #include "LFGMgr.h"
 #include "Map.h"
 #include "MapInstanced.h"
+#include "MapManager.h"
 #include "Object.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
@@ -29,6 +31,18 @@
 #include "LuaEngine.h"
 #endif
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define GRID_PRELOAD_INTERVAL 1000                          // how often the grids ahead of moving players are requested, ms
+#define GRID_PRELOAD_EXPIRE   60000                         // preloaded terrain of a grid nobody entered is freed after this, ms
+
 union u_map_magic
 {
     char asChar[4];
@@ -59,8 +73,11 @@ Map::~Map()
     if (!m_scriptSchedule.empty())
         sScriptMgr->DecreaseScheduledScriptCount(m_scriptSchedule.size());
 
-    //MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(GetId());
-    MMAP::MMapFactory::createOrGetMMapManager()->unloadMapInstance(GetId(), i_InstanceId);
+    // generators outliving the map must not unregister from it anymore
+    std::vector<PathGenerator*> pathRequests;
+    pathRequests.swap(_pathRequests);
+    for (PathGenerator* path : pathRequests)
+        path->CancelPathRequest();
 }
 
 bool Map::ExistMap(uint32 mapid, int gx, int gy)
@@ -207,6 +224,107 @@ void Map::LoadMap(int gx, int gy, bool reload)
     sScriptMgr->OnLoadGridMap(this, GridMaps[gx][gy], gx, gy);
 }
 
+void Map::UpdateGridPreload(uint32 diff)
+{
+    if (i_InstanceId != 0 || Instanceable() || !sGridMapPreloader->IsEnabled())
+        return;
+
+    std::vector<GridMapPreloader::Result> finished;
+    sGridMapPreloader->TakeFinished(GetId(), finished);
+    if (!finished.empty())
+    {
+        ACORE_GUARD(ACE_Thread_Mutex, GridLock);
+        for (GridMapPreloader::Result const& result : finished)
+        {
+            // loaded on the map thread meanwhile
+            if (GridMaps[result.gx][result.gy])
+            {
+                delete result.gridMap;
+                sGridMapPreloader->RecordDiscarded();
+                continue;
+            }
+
+            GridMaps[result.gx][result.gy] = result.gridMap;
+            _preloadedGridMaps[result.gx * MAX_NUMBER_OF_GRIDS + result.gy] = getMSTime();
+            sScriptMgr->OnLoadGridMap(this, result.gridMap, result.gx, result.gy);
+        }
+    }
+
+    if (!_preloadedGridMaps.empty())
+    {
+        // the players turned away, do not keep their terrain until the map unloads
+        // GetGrid creates the grid before it reads the GridMap, so an unclaimed one is referenced only from here
+        uint32 now = getMSTime();
+        ACORE_GUARD(ACE_Thread_Mutex, GridLock);
+        for (auto itr = _preloadedGridMaps.begin(); itr != _preloadedGridMaps.end();)
+        {
+            if (getMSTimeDiff(itr->second, now) < GRID_PRELOAD_EXPIRE)
+            {
+                ++itr;
+                continue;
+            }
+
+            int gx = itr->first / MAX_NUMBER_OF_GRIDS;
+            int gy = itr->first % MAX_NUMBER_OF_GRIDS;
+            sScriptMgr->OnUnloadGridMap(this, GridMaps[gx][gy], gx, gy);
+            GridMaps[gx][gy]->unloadData();
+            delete GridMaps[gx][gy];
+            GridMaps[gx][gy] = nullptr;
+            sGridMapPreloader->RecordDiscarded();
+            itr = _preloadedGridMaps.erase(itr);
+        }
+    }
+
+    if (_gridPreloadTimer > diff)
+    {
+        _gridPreloadTimer -= diff;
+        return;
+    }
+
+    _gridPreloadTimer = GRID_PRELOAD_INTERVAL;
+
+    uint32 lookahead = sWorld->getIntConfig(CONFIG_GRID_PRELOAD_LOOKAHEAD) * IN_MILLISECONDS;
+    for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* player = itr->GetSource();
+        if (!player->IsInWorld())
+            continue;
+
+        if (player->movespline->Initialized() && !player->movespline->Finalized() && !player->movespline->isCyclic())
+        {
+            // taxi flights and other spline movement, every point reached within the lookahead time
+            Movement::MoveSpline::MySpline const& spline = player->movespline->_Spline();
+            int32 until = player->movespline->timePassed() + int32(lookahead);
+            for (int32 i = player->movespline->_currentSplineIdx() + 1; i <= spline.last(); ++i)
+            {
+                G3D::Vector3 const& point = spline.getPoint(i, false);
+                RequestGridPreload(point.x, point.y);
+                if (spline.length(i) > until)
+                    break;
+            }
+        }
+        else if (player->isMoving())
+        {
+            float distance = player->GetSpeed(player->IsFlying() ? MOVE_FLIGHT : MOVE_RUN) * lookahead / IN_MILLISECONDS;
+            float angle = player->GetOrientation();
+            for (float step = SIZE_OF_GRIDS / 2; step < distance + SIZE_OF_GRIDS / 2; step += SIZE_OF_GRIDS / 2)
+                RequestGridPreload(player->GetPositionX() + std::cos(angle) * std::min(step, distance), player->GetPositionY() + std::sin(angle) * std::min(step, distance));
+        }
+    }
+}
+
+void Map::RequestGridPreload(float x, float y)
+{
+    GridCoord p = acore::ComputeGridCoord(x, y);
+    if (!p.IsCoordValid() || getNGrid(p.x_coord, p.y_coord))
+        return;
+
+    int gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+    int gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+    if (!GridMaps[gx][gy])
+        sGridMapPreloader->Request(GetId(), gx, gy);
+}
+
 void Map::LoadMapAndVMap(int gx, int gy)
 {
     LoadMap(gx, gy);
@@ -221,7 +339,9 @@ Map::Map(uint32 id, uint32 InstanceId, uint8 SpawnMode, Map* _parent) :
     i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
     m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
     _instanceResetPeriod(0), m_activeNonPlayersIter(m_activeNonPlayers.end()),
-    _transportsUpdateIter(_transports.end()), i_scriptLock(false), _defaultLight(GetDefaultMapLight(id))
+    _transportsUpdateIter(_transports.end()), i_scriptLock(false), _defaultLight(GetDefaultMapLight(id)),
+    _updateCost(0), _lastUpdateTime(0), _islandUpdate(false), _deferredBalance(false),
+    _pathCache(sWorld->getIntConfig(CONFIG_MMAPS_PATH_CACHE_SIZE)), _gridPreloadTimer(0)
 {
     m_parentMap = (_parent ? _parent : this);
     for (unsigned int idx = 0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
@@ -426,7 +546,19 @@ void Map::EnsureGridCreated_i(const GridCoord& p)
 
         if (!GridMaps[gx][gy])
         {
+            uint32 loadStart = getMSTime();
             LoadMapAndVMap(gx, gy);
+
+            // a player walked into a grid the preloader did not load in time, startup and LoadAllCells do not count
+            if (i_InstanceId == 0 && !Instanceable() && HavePlayers() && sGridMapPreloader->IsEnabled())
+                sGridMapPreloader->RecordSyncLoad(getMSTimeDiff(loadStart, getMSTime()));
+        }
+        else if (_preloadedGridMaps.erase(gx * MAX_NUMBER_OF_GRIDS + gy))
+        {
+            // terrain came from the preloader, vmap and mmap files should be in the os cache by now
+            sGridMapPreloader->RecordUsed();
+            LoadVMap(gx, gy);
+            LoadMMap(gx, gy);
         }
 
         // pussywizard: moved here
@@ -443,6 +575,11 @@ bool Map::EnsureGridLoaded(const Cell& cell)
     ASSERT(grid != nullptr);
     if (!isGridObjectDataLoaded(cell.GridX(), cell.GridY()))
     {
+        // another island may be loading the same grid, check again once we hold the lock
+        auto guard = GuardIslandUpdate();
+        if (isGridObjectDataLoaded(cell.GridX(), cell.GridY()))
+            return false;
+
         //if (!isGridObjectDataLoaded(cell.GridX(), cell.GridY()))
         //{
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
@@ -649,10 +786,9 @@ void Map::VisitNearbyCellsOfPlayer(Player* player, TypeContainerVisitor<acore::O
             // marked cells are those that have been visited
             // don't visit the same cell twice
             uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-            if (isCellMarkedLarge(cell_id))
+            if (!markCellLarge(cell_id))
                 continue;
 
-            markCellLarge(cell_id);
             CellCoord pair(x, y);
             Cell cell(pair);
 
@@ -684,10 +820,9 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<acore::Objec
             // marked cells are those that have been visited
             // don't visit the same cell twice
             uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-            if (isCellMarked(cell_id))
+            if (!markCell(cell_id))
                 continue;
 
-            markCell(cell_id);
             CellCoord pair(x, y);
             Cell cell(pair);
             //cell.SetNoCreate(); // in mmaps this is missing
@@ -695,9 +830,8 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<acore::Objec
             Visit(cell, gridVisitor);
             Visit(cell, worldVisitor);
 
-            if (!isCellMarkedLarge(cell_id))
+            if (markCellLarge(cell_id))
             {
-                markCellLarge(cell_id);
                 Visit(cell, largeGridVisitor);
                 Visit(cell, largeWorldVisitor);
             }
@@ -705,6 +839,47 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<acore::Objec
     }
 }
 
+void Map::VisitNearbyCellsOfPlayerAndTargets(Player* player, std::vector<Creature*>& updateList,
+                                             TypeContainerVisitor<acore::ObjectUpdater, GridTypeMapContainer>& gridVisitor,
+                                             TypeContainerVisitor<acore::ObjectUpdater, WorldTypeMapContainer>& worldVisitor,
+                                             TypeContainerVisitor<acore::ObjectUpdater, GridTypeMapContainer>& largeGridVisitor,
+                                             TypeContainerVisitor<acore::ObjectUpdater, WorldTypeMapContainer>& largeWorldVisitor)
+{
+    VisitNearbyCellsOfPlayer(player, gridVisitor, worldVisitor, largeGridVisitor, largeWorldVisitor);
+
+    // If player is using far sight, visit that object too
+    if (WorldObject* viewPoint = player->GetViewpoint())
+    {
+        if (Creature* viewCreature = viewPoint->ToCreature())
+        {
+            VisitNearbyCellsOf(viewCreature, gridVisitor, worldVisitor, largeGridVisitor, largeWorldVisitor);
+        }
+        else if (DynamicObject* viewObject = viewPoint->ToDynObject())
+        {
+            VisitNearbyCellsOf(viewObject, gridVisitor, worldVisitor, largeGridVisitor, largeWorldVisitor);
+        }
+    }
+
+    // handle updates for creatures in combat with player and are more than X yards away
+    if (player->IsInCombat())
+    {
+        updateList.clear();
+        float rangeSq = player->GetGridActivationRange() - 1.0f;
+        rangeSq = rangeSq * rangeSq;
+        HostileReference* ref = player->getHostileRefManager().getFirst();
+        while (ref)
+        {
+            if (Unit* unit = ref->GetSource()->GetOwner())
+                if (Creature* cre = unit->ToCreature())
+                    if (cre->FindMap() == player->FindMap() && cre->GetExactDist2dSq(player) > rangeSq)
+                        updateList.push_back(cre);
+            ref = ref->next();
+        }
+        for (std::vector<Creature*>::const_iterator itr = updateList.begin(); itr != updateList.end(); ++itr)
+            VisitNearbyCellsOf(*itr, gridVisitor, worldVisitor, largeGridVisitor, largeWorldVisitor);
+    }
+}
+
 void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
 {
     if (t_diff)
@@ -740,6 +915,8 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
         return;
     }
 
+    UpdateGridPreload(t_diff);
+
     /// update active cells around players and active objects
     resetMarkedCells();
     resetMarkedCellsLarge();
@@ -760,62 +937,33 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
     std::vector<Creature*> updateList;
     updateList.reserve(10);
 
-    // non-player active objects, increasing iterator in the loop in case of object removal
-    for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+    if (!UpdateIslands(t_diff, s_diff))
     {
-        WorldObject* obj = *m_activeNonPlayersIter;
-        ++m_activeNonPlayersIter;
-
-        if (!obj || !obj->IsInWorld())
-            continue;
-
-        VisitNearbyCellsOf(obj, grid_object_update, world_object_update, grid_large_object_update, world_large_object_update);
-    }
+        // non-player active objects, increasing iterator in the loop in case of object removal
+        for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+        {
+            WorldObject* obj = *m_activeNonPlayersIter;
+            ++m_activeNonPlayersIter;
 
-    // the player iterator is stored in the map object
-    // to make sure calls to Map::Remove don't invalidate it
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
-    {
-        Player* player = m_mapRefIter->GetSource();
+            if (!obj || !obj->IsInWorld())
+                continue;
 
-        if (!player || !player->IsInWorld())
-            continue;
+            VisitNearbyCellsOf(obj, grid_object_update, world_object_update, grid_large_object_update, world_large_object_update);
+        }
 
-        // update players at tick
-        player->Update(s_diff);
+        // the player iterator is stored in the map object
+        // to make sure calls to Map::Remove don't invalidate it
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+        {
+            Player* player = m_mapRefIter->GetSource();
 
-        VisitNearbyCellsOfPlayer(player, grid_object_update, world_object_update, grid_large_object_update, world_large_object_update);
+            if (!player || !player->IsInWorld())
+                continue;
 
-        // If player is using far sight, visit that object too
-        if (WorldObject* viewPoint = player->GetViewpoint())
-        {
-            if (Creature* viewCreature = viewPoint->ToCreature())
-            {
-                VisitNearbyCellsOf(viewCreature, grid_object_update, world_object_update, grid_large_object_update, world_large_object_update);
-            }
-            else if (DynamicObject* viewObject = viewPoint->ToDynObject())
-            {
-                VisitNearbyCellsOf(viewObject, grid_object_update, world_object_update, grid_large_object_update, world_large_object_update);
-            }
-        }
+            // update players at tick
+            player->Update(s_diff);
 
-        // handle updates for creatures in combat with player and are more than X yards away
-        if (player->IsInCombat())
-        {
-            updateList.clear();
-            float rangeSq = player->GetGridActivationRange() - 1.0f;
-            rangeSq = rangeSq * rangeSq;
-            HostileReference* ref = player->getHostileRefManager().getFirst();
-            while (ref)
-            {
-                if (Unit* unit = ref->GetSource()->GetOwner())
-                    if (Creature* cre = unit->ToCreature())
-                        if (cre->FindMap() == player->FindMap() && cre->GetExactDist2dSq(player) > rangeSq)
-                            updateList.push_back(cre);
-                ref = ref->next();
-            }
-            for (std::vector<Creature*>::const_iterator itr = updateList.begin(); itr != updateList.end(); ++itr)
-                VisitNearbyCellsOf(*itr, grid_object_update, world_object_update, grid_large_object_update, world_large_object_update);
+            VisitNearbyCellsOfPlayerAndTargets(player, updateList, grid_object_update, world_object_update, grid_large_object_update, world_large_object_update);
         }
     }
 
@@ -842,6 +990,8 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
     MoveAllGameObjectsInMoveList();
     MoveAllDynamicObjectsInMoveList();
 
+    ProcessPathRequests();
+
     HandleDelayedVisibility();
 
     sScriptMgr->OnMapUpdate(this, t_diff);
@@ -849,6 +999,292 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
     BuildAndSendUpdateForObjects(); // pussywizard
 }
 
+void MapUpdateIsland::Run()
+{
+    map->UpdateIsland(*this);
+}
+
+void MapPathBatch::Run()
+{
+    for (PathGenerator* const* path = begin; path != end; ++path)
+        (*path)->RunPathRequest();
+}
+
+void Map::AddPathRequest(PathGenerator* path)
+{
+    std::lock_guard<std::mutex> guard(_pathRequestLock);
+    _pathRequests.push_back(path);
+}
+
+void Map::RemovePathRequest(PathGenerator* path)
+{
+    std::lock_guard<std::mutex> guard(_pathRequestLock);
+
+    auto itr = std::find(_pathRequests.begin(), _pathRequests.end(), path);
+    if (itr == _pathRequests.end())
+        return;
+
+    *itr = _pathRequests.back();
+    _pathRequests.pop_back();
+}
+
+void Map::ProcessPathRequests()
+{
+    std::vector<PathGenerator*> requests;
+    {
+        // islands may still add requests
+        std::lock_guard<std::mutex> guard(_pathRequestLock);
+        requests.swap(_pathRequests);
+    }
+
+    if (requests.empty())
+        return;
+
+    // the map is not changed while the batch runs, every worker uses its own navmesh query.
+    // The slices go to the task queue of the pool, idle workers take them but never another map's update,
+    // and this worker sleeps until the slices taken by others are done.
+    size_t const requestsPerTask = 8;
+    MapUpdater* mapUpdater = sMapMgr->GetMapUpdater();
+    if (requests.size() <= requestsPerTask || !mapUpdater->is_worker_thread() || mapUpdater->worker_count() < 2)
+    {
+        for (PathGenerator* path : requests)
+            path->RunPathRequest();
+        return;
+    }
+
+    size_t taskCount = (requests.size() + requestsPerTask - 1) / requestsPerTask;
+    if (_pathBatches.size() < taskCount)
+        _pathBatches.resize(taskCount);
+
+    std::vector<MapUpdateTask*> tasks;
+    for (size_t i = 0; i < taskCount; ++i)
+    {
+        MapPathBatch& batch = _pathBatches[i];
+        batch.begin = requests.data() + i * requestsPerTask;
+        batch.end = requests.data() + std::min(requests.size(), (i + 1) * requestsPerTask);
+        tasks.push_back(&batch);
+    }
+
+    mapUpdater->run_tasks(tasks);
+}
+
+bool Map::UpdateIslands(uint32 t_diff, uint32 s_diff)
+{
+    MapUpdater* mapUpdater = sMapMgr->GetMapUpdater();
+    if (!sWorld->getBoolConfig(CONFIG_MAP_UPDATE_ISLANDS) || Instanceable() || !mapUpdater->is_worker_thread() || m_mapRefManager.getSize() < 2)
+        return false;
+
+    // players are updated here, one after another: zone changes (outdoor PvP, battlefields, weather), groups
+    // and teleports touch state shared by the whole map or by other maps. The islands only update the objects around them.
+    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    {
+        Player* player = m_mapRefIter->GetSource();
+
+        if (!player || !player->IsInWorld())
+            continue;
+
+        // update players at tick
+        player->Update(s_diff);
+    }
+
+    // islands further apart than this can not see nor reach objects of each other during one update
+    float const separation = 2.0f * (MAX_VISIBILITY_DISTANCE + GetVisibilityRange()) + SIZE_OF_GRID_CELL;
+
+    struct IslandPoint
+    {
+        float x;
+        float y;
+        uint32 owner;
+    };
+
+    // owners are players first, then active non-player objects
+    std::vector<Player*> players;
+    std::vector<WorldObject*> activeObjects;
+    std::vector<IslandPoint> points;
+
+    for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* player = itr->GetSource();
+        if (!player || !player->IsInWorld() || !player->IsPositionValid())
+            continue;
+
+        uint32 owner = players.size();
+        players.push_back(player);
+        points.push_back({ player->GetPositionX(), player->GetPositionY(), owner });
+
+        // far sight and far away attackers are updated together with the player
+        if (WorldObject* viewPoint = player->GetViewpoint())
+            if (viewPoint->IsPositionValid())
+                points.push_back({ viewPoint->GetPositionX(), viewPoint->GetPositionY(), owner });
+
+        for (HostileReference* ref = player->getHostileRefManager().getFirst(); ref; ref = ref->next())
+            if (Unit* unit = ref->GetSource()->GetOwner())
+                if (unit->FindMap() == this && unit->IsPositionValid())
+                    points.push_back({ unit->GetPositionX(), unit->GetPositionY(), owner });
+    }
+
+    for (WorldObject* obj : m_activeNonPlayers)
+    {
+        if (!obj || !obj->IsInWorld() || !obj->IsPositionValid() || obj->GetGridActivationRange() <= 0.0f)
+            continue;
+
+        points.push_back({ obj->GetPositionX(), obj->GetPositionY(), uint32(players.size() + activeObjects.size()) });
+        activeObjects.push_back(obj);
+    }
+
+    uint32 ownerCount = players.size() + activeObjects.size();
+    std::vector<uint32> parents(ownerCount);
+    for (uint32 i = 0; i < ownerCount; ++i)
+        parents[i] = i;
+
+    auto findRoot = [&parents](uint32 owner)
+    {
+        while (parents[owner] != owner)
+        {
+            parents[owner] = parents[parents[owner]];
+            owner = parents[owner];
+        }
+        return owner;
+    };
+
+    // bucket points by separation distance, only points in neighbour buckets can belong to the same island
+    auto bucketKey = [](int32 x, int32 y) { return (uint64(uint32(x)) << 32) | uint32(y); };
+    std::unordered_map<uint64, std::vector<uint32>> buckets;
+    for (uint32 i = 0; i < points.size(); ++i)
+        buckets[bucketKey(int32(std::floor(points[i].x / separation)), int32(std::floor(points[i].y / separation)))].push_back(i);
+
+    float const separationSq = separation * separation;
+    for (uint32 i = 0; i < points.size(); ++i)
+    {
+        int32 bucketX = int32(std::floor(points[i].x / separation));
+        int32 bucketY = int32(std::floor(points[i].y / separation));
+        for (int32 x = bucketX - 1; x <= bucketX + 1; ++x)
+        {
+            for (int32 y = bucketY - 1; y <= bucketY + 1; ++y)
+            {
+                auto bucket = buckets.find(bucketKey(x, y));
+                if (bucket == buckets.end())
+                    continue;
+
+                for (uint32 j : bucket->second)
+                {
+                    if (j >= i)
+                        continue;
+
+                    float dx = points[i].x - points[j].x;
+                    float dy = points[i].y - points[j].y;
+                    if (dx * dx + dy * dy <= separationSq)
+                        parents[findRoot(points[i].owner)] = findRoot(points[j].owner);
+                }
+            }
+        }
+    }
+
+    std::unordered_map<uint32, uint32> islandIndexes;
+    for (uint32 i = 0; i < ownerCount; ++i)
+        islandIndexes.emplace(findRoot(i), uint32(islandIndexes.size()));
+
+    // a single island is updated on this worker
+    if (islandIndexes.size() < 2)
+    {
+        MapUpdateIsland island(this);
+        island.t_diff = t_diff;
+        island.players = std::move(players);
+        island.activeObjects = std::move(activeObjects);
+        UpdateIsland(island);
+        return true;
+    }
+
+    if (_updateIslands.size() < islandIndexes.size())
+        _updateIslands.resize(islandIndexes.size(), MapUpdateIsland(this));
+
+    std::vector<MapUpdateTask*> tasks;
+    for (uint32 i = 0; i < islandIndexes.size(); ++i)
+    {
+        MapUpdateIsland& island = _updateIslands[i];
+        island.t_diff = t_diff;
+        island.players.clear();
+        island.activeObjects.clear();
+        tasks.push_back(&island);
+    }
+
+    for (uint32 i = 0; i < players.size(); ++i)
+        _updateIslands[islandIndexes[findRoot(i)]].players.push_back(players[i]);
+
+    for (uint32 i = 0; i < activeObjects.size(); ++i)
+        _updateIslands[islandIndexes[findRoot(players.size() + i)]].activeObjects.push_back(activeObjects[i]);
+
+    // immediate scripts and dynamic tree changes wait for the merge below
+    _islandUpdate = true;
+    i_scriptLock = true;
+
+    mapUpdater->run_tasks(tasks);
+
+    i_scriptLock = false;
+    _islandUpdate = false;
+
+    for (auto const& update : _deferredModelUpdates)
+    {
+        switch (update.second)
+        {
+            case DEFERRED_MODEL_INSERT:
+                if (!_dynamicTree.contains(*update.first))
+                    _dynamicTree.insert(*update.first);
+                break;
+            case DEFERRED_MODEL_REMOVE:
+                if (_dynamicTree.contains(*update.first))
+                    _dynamicTree.remove(*update.first);
+                break;
+            case DEFERRED_MODEL_DELETE:
+                if (_dynamicTree.contains(*update.first))
+                    _dynamicTree.remove(*update.first);
+                delete update.first;
+                break;
+        }
+    }
+
+    _deferredModelUpdates.clear();
+
+    if (_deferredBalance)
+    {
+        _deferredBalance = false;
+        _dynamicTree.balance();
+    }
+
+    return true;
+}
+
+void Map::UpdateIsland(MapUpdateIsland& island)
+{
+    acore::ObjectUpdater updater(island.t_diff, false);
+    TypeContainerVisitor<acore::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+    TypeContainerVisitor<acore::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
+
+    acore::ObjectUpdater largeObjectUpdater(island.t_diff, true);
+    TypeContainerVisitor<acore::ObjectUpdater, GridTypeMapContainer  > grid_large_object_update(largeObjectUpdater);
+    TypeContainerVisitor<acore::ObjectUpdater, WorldTypeMapContainer  > world_large_object_update(largeObjectUpdater);
+
+    std::vector<Creature*> updateList;
+
+    // the updates before may have removed, and even deleted, active objects of this island;
+    // they leave the active list before that, only objects still on it are visited
+    for (WorldObject* obj : island.activeObjects)
+    {
+        {
+            auto guard = GuardIslandUpdate();
+            if (m_activeNonPlayers.find(obj) == m_activeNonPlayers.end() || !obj->IsInWorld())
+                continue;
+        }
+
+        VisitNearbyCellsOf(obj, grid_object_update, world_object_update, grid_large_object_update, world_large_object_update);
+    }
+
+    // players stay on the map while islands run, teleports are delayed to their next update
+    for (Player* player : island.players)
+        if (player->IsInWorld() && player->FindMap() == this)
+            VisitNearbyCellsOfPlayerAndTargets(player, updateList, grid_object_update, world_object_update, grid_large_object_update, world_large_object_update);
+}
+
 void Map::HandleDelayedVisibility()
 {
     if (i_objectsForDelayedVisibility.empty())
@@ -860,18 +1296,19 @@ void Map::HandleDelayedVisibility()
 
 struct ResetNotifier
 {
-    template<class T>inline void resetNotify(GridRefManager<T>& m)
+    template<class T>inline void resetNotify(GridObjectList<T>& m)
     {
-        for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
+        for (typename GridObjectList<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
             iter->GetSource()->ResetAllNotifies();
     }
-    template<class T> void Visit(GridRefManager<T>&) {}
+    template<class T> void Visit(GridObjectList<T>&) {}
     void Visit(CreatureMapType& m) { resetNotify<Creature>(m);}
     void Visit(PlayerMapType& m) { resetNotify<Player>(m);}
 };
 
 void Map::RemovePlayerFromMap(Player* player, bool remove)
 {
+    auto guard = GuardIslandUpdate();
     player->getHostileRefManager().deleteReferences(); // pussywizard: multithreading crashfix
 
     bool inWorld = player->IsInWorld();
@@ -1046,6 +1483,7 @@ void Map::DynamicObjectRelocation(DynamicObject* dynObj, float x, float y, float
 
 void Map::AddCreatureToMoveList(Creature* c)
 {
+    auto guard = GuardIslandUpdate();
     if (c->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _creaturesToMove.push_back(c);
     c->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
@@ -1053,12 +1491,14 @@ void Map::AddCreatureToMoveList(Creature* c)
 
 void Map::RemoveCreatureFromMoveList(Creature* c)
 {
+    auto guard = GuardIslandUpdate();
     if (c->_moveState == MAP_OBJECT_CELL_MOVE_ACTIVE)
         c->_moveState = MAP_OBJECT_CELL_MOVE_INACTIVE;
 }
 
 void Map::AddGameObjectToMoveList(GameObject* go)
 {
+    auto guard = GuardIslandUpdate();
     if (go->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _gameObjectsToMove.push_back(go);
     go->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
@@ -1066,12 +1506,14 @@ void Map::AddGameObjectToMoveList(GameObject* go)
 
 void Map::RemoveGameObjectFromMoveList(GameObject* go)
 {
+    auto guard = GuardIslandUpdate();
     if (go->_moveState == MAP_OBJECT_CELL_MOVE_ACTIVE)
         go->_moveState = MAP_OBJECT_CELL_MOVE_INACTIVE;
 }
 
 void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj)
 {
+    auto guard = GuardIslandUpdate();
     if (dynObj->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _dynamicObjectsToMove.push_back(dynObj);
     dynObj->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
@@ -1079,6 +1521,7 @@ void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj)
 
 void Map::RemoveDynamicObjectFromMoveList(DynamicObject* dynObj)
 {
+    auto guard = GuardIslandUpdate();
     if (dynObj->_moveState == MAP_OBJECT_CELL_MOVE_ACTIVE)
         dynObj->_moveState = MAP_OBJECT_CELL_MOVE_INACTIVE;
 }
@@ -1249,6 +1692,16 @@ void Map::UnloadAll()
         UnloadGrid(grid); // deletes the grid and removes it from the GridRefManager
     }
 
+    // preloaded terrain of grids that were never created
+    for (auto const& preloaded : _preloadedGridMaps)
+    {
+        GridMap*& gridMap = GridMaps[preloaded.first / MAX_NUMBER_OF_GRIDS][preloaded.first % MAX_NUMBER_OF_GRIDS];
+        gridMap->unloadData();
+        delete gridMap;
+        gridMap = nullptr;
+    }
+    _preloadedGridMaps.clear();
+
     // pussywizard: crashfix, some npc can be left on transport (not a default passenger)
     if (!AllTransportsEmpty())
         AllTransportsRemovePassengers();
@@ -1292,6 +1745,9 @@ GridMap::GridMap()
     _liquidEntry = nullptr;
     _liquidFlags = nullptr;
     _liquidMap  = nullptr;
+    // Memory mapped file
+    _mapping = nullptr;
+    _mappingSize = 0;
 }
 
 GridMap::~GridMap()
@@ -1304,6 +1760,10 @@ bool GridMap::loadData(char* filename)
     // Unload old data if exist
     unloadData();
 
+    // a missing file or a failed mapping falls back to reading the file
+    if (sWorld->getBoolConfig(CONFIG_MAP_FILES_MEMORY_MAPPED) && mapFile(filename))
+        return loadMappedData(filename);
+
     map_fileheader header;
     // Not return error if file not found
     FILE* in = fopen(filename, "rb");
@@ -1349,25 +1809,242 @@ bool GridMap::loadData(char* filename)
 
 void GridMap::unloadData()
 {
-    delete[] _areaMap;
-    delete[] m_V9;
-    delete[] m_V8;
-    delete[] _maxHeight;
-    delete[] _minHeight;
-    delete[] _liquidEntry;
-    delete[] _liquidFlags;
-    delete[] _liquidMap;
-    _areaMap = nullptr;
-    m_V9 = nullptr;
-    m_V8 = nullptr;
-    _maxHeight = nullptr;
-    _minHeight = nullptr;
-    _liquidEntry = nullptr;
-    _liquidFlags = nullptr;
-    _liquidMap  = nullptr;
+    freeArray(_areaMap);
+    freeArray(m_V9);
+    freeArray(m_V8);
+    freeArray(_maxHeight);
+    freeArray(_minHeight);
+    freeArray(_liquidEntry);
+    freeArray(_liquidFlags);
+    freeArray(_liquidMap);
+    unmapData();
     _gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
+template<class T>
+void GridMap::freeArray(T*& array)
+{
+    // arrays pointing into the mapped file are released with it
+    uintptr_t address = reinterpret_cast<uintptr_t>(array);
+    uintptr_t mapping = reinterpret_cast<uintptr_t>(_mapping);
+    if (address < mapping || address >= mapping + _mappingSize)
+        delete[] array;
+
+    array = nullptr;
+}
+
+bool GridMap::mapFile(char const* filename)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+        return false;
+
+    // the view keeps the mapping alive
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view)
+        return false;
+
+    _mappingSize = size_t(size.QuadPart);
+#else
+    int file = open(filename, O_RDONLY);
+    if (file < 0)
+        return false;
+
+    struct stat fileStat;
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size <= 0)
+    {
+        close(file);
+        return false;
+    }
+
+    void* view = mmap(nullptr, size_t(fileStat.st_size), PROT_READ, MAP_SHARED, file, 0);
+    close(file);
+    if (view == MAP_FAILED)
+        return false;
+
+    _mappingSize = size_t(fileStat.st_size);
+
+    // start reading the pages in the background, the grid is going to be used soon
+    madvise(view, _mappingSize, MADV_WILLNEED);
+#endif
+
+    _mapping = static_cast<uint8*>(view);
+    return true;
+}
+
+void GridMap::unmapData()
+{
+    if (!_mapping)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(_mapping);
+#else
+    munmap(_mapping, _mappingSize);
+#endif
+
+    _mapping = nullptr;
+    _mappingSize = 0;
+}
+
+template<class T>
+bool GridMap::mapHeader(T& header, uint32 offset) const
+{
+    if (size_t(offset) + sizeof(T) > _mappingSize)
+        return false;
+
+    // headers are copied, the file does not keep them aligned
+    memcpy(&header, _mapping + offset, sizeof(T));
+    return true;
+}
+
+template<class T>
+bool GridMap::mapArray(T*& array, uint32& offset, uint32 count)
+{
+    size_t size = sizeof(T) * count;
+    if (size_t(offset) + size > _mappingSize)
+        return false;
+
+    // the mapping starts at a page boundary, only the offset decides the alignment
+    if (offset % alignof(T) == 0)
+        array = reinterpret_cast<T*>(_mapping + offset);
+    else
+    {
+        array = new T[count];
+        memcpy(array, _mapping + offset, size);
+    }
+
+    offset += size;
+    return true;
+}
+
+bool GridMap::loadMappedData(char const* filename)
+{
+    map_fileheader header;
+    if (!mapHeader(header, 0) || header.mapMagic != MapMagic.asUInt || header.versionMagic != MapVersionMagic.asUInt)
+    {
+        sLog->outError("Map file '%s' is from an incompatible clientversion. Please recreate using the mapextractor.", filename);
+        return false;
+    }
+
+    // loadup area data
+    if (header.areaMapOffset && !mapAreaData(header.areaMapOffset))
+    {
+        sLog->outError("Error loading map area data\n");
+        return false;
+    }
+    // loadup height data
+    if (header.heightMapOffset && !mapHeightData(header.heightMapOffset))
+    {
+        sLog->outError("Error loading map height data\n");
+        return false;
+    }
+    // loadup liquid data
+    if (header.liquidMapOffset && !mapLiquidData(header.liquidMapOffset))
+    {
+        sLog->outError("Error loading map liquids data\n");
+        return false;
+    }
+    return true;
+}
+
+bool GridMap::mapAreaData(uint32 offset)
+{
+    map_areaHeader header;
+    if (!mapHeader(header, offset) || header.fourcc != MapAreaMagic.asUInt)
+        return false;
+
+    offset += sizeof(header);
+
+    _gridArea = header.gridArea;
+    if (!(header.flags & MAP_AREA_NO_AREA))
+        return mapArray(_areaMap, offset, 16 * 16);
+
+    return true;
+}
+
+bool GridMap::mapHeightData(uint32 offset)
+{
+    map_heightHeader header;
+    if (!mapHeader(header, offset) || header.fourcc != MapHeightMagic.asUInt)
+        return false;
+
+    offset += sizeof(header);
+
+    _gridHeight = header.gridHeight;
+    if (!(header.flags & MAP_HEIGHT_NO_HEIGHT))
+    {
+        if ((header.flags & MAP_HEIGHT_AS_INT16))
+        {
+            if (!mapArray(m_uint16_V9, offset, 129 * 129) || !mapArray(m_uint16_V8, offset, 128 * 128))
+                return false;
+            _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
+            _gridGetHeight = &GridMap::getHeightFromUint16;
+        }
+        else if ((header.flags & MAP_HEIGHT_AS_INT8))
+        {
+            if (!mapArray(m_uint8_V9, offset, 129 * 129) || !mapArray(m_uint8_V8, offset, 128 * 128))
+                return false;
+            _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
+            _gridGetHeight = &GridMap::getHeightFromUint8;
+        }
+        else
+        {
+            if (!mapArray(m_V9, offset, 129 * 129) || !mapArray(m_V8, offset, 128 * 128))
+                return false;
+            _gridGetHeight = &GridMap::getHeightFromFloat;
+        }
+    }
+    else
+        _gridGetHeight = &GridMap::getHeightFromFlat;
+
+    if (header.flags & MAP_HEIGHT_HAS_FLIGHT_BOUNDS)
+        if (!mapArray(_maxHeight, offset, 3 * 3) || !mapArray(_minHeight, offset, 3 * 3))
+            return false;
+
+    return true;
+}
+
+bool GridMap::mapLiquidData(uint32 offset)
+{
+    map_liquidHeader header;
+    if (!mapHeader(header, offset) || header.fourcc != MapLiquidMagic.asUInt)
+        return false;
+
+    offset += sizeof(header);
+
+    _liquidType   = header.liquidType;
+    _liquidOffX  = header.offsetX;
+    _liquidOffY  = header.offsetY;
+    _liquidWidth = header.width;
+    _liquidHeight = header.height;
+    _liquidLevel  = header.liquidLevel;
+
+    if (!(header.flags & MAP_LIQUID_NO_TYPE))
+        if (!mapArray(_liquidEntry, offset, 16 * 16) || !mapArray(_liquidFlags, offset, 16 * 16))
+            return false;
+
+    if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
+        if (!mapArray(_liquidMap, offset, uint32(_liquidWidth) * uint32(_liquidHeight)))
+            return false;
+
+    return true;
+}
+
 bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
 {
     map_areaHeader header;
@@ -2255,6 +2932,81 @@ bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, floa
     return true;
 }
 
+void Map::isInLineOfSight(std::vector<VMAP::LineOfSightRay>& rays, LineOfSightChecks checks) const
+{
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
+        VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), rays);
+    else
+        for (VMAP::LineOfSightRay& ray : rays)
+            ray.inLineOfSight = true;
+
+    if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT))
+        for (VMAP::LineOfSightRay& ray : rays)
+            if (ray.inLineOfSight)
+                ray.inLineOfSight = _dynamicTree.isInLineOfSight(ray.x1, ray.y1, ray.z1, ray.x2, ray.y2, ray.z2, ray.phaseMask);
+}
+
+void Map::Balance()
+{
+    if (_islandUpdate)
+    {
+        auto guard = GuardIslandUpdate();
+        _deferredBalance = true;
+        return;
+    }
+
+    _dynamicTree.balance();
+}
+
+void Map::RemoveGameObjectModel(const GameObjectModel& model)
+{
+    if (_islandUpdate)
+    {
+        auto guard = GuardIslandUpdate();
+        _deferredModelUpdates.emplace_back(&model, DEFERRED_MODEL_REMOVE);
+        return;
+    }
+
+    _dynamicTree.remove(model);
+}
+
+void Map::InsertGameObjectModel(const GameObjectModel& model)
+{
+    if (_islandUpdate)
+    {
+        auto guard = GuardIslandUpdate();
+        _deferredModelUpdates.emplace_back(&model, DEFERRED_MODEL_INSERT);
+        return;
+    }
+
+    _dynamicTree.insert(model);
+}
+
+bool Map::ContainsGameObjectModel(const GameObjectModel& model) const
+{
+    if (_islandUpdate)
+    {
+        auto guard = GuardIslandUpdate();
+        for (auto itr = _deferredModelUpdates.rbegin(); itr != _deferredModelUpdates.rend(); ++itr)
+            if (itr->first == &model)
+                return itr->second == DEFERRED_MODEL_INSERT;
+    }
+
+    return _dynamicTree.contains(model);
+}
+
+void Map::DeleteGameObjectModel(GameObjectModel* model)
+{
+    if (_islandUpdate)
+    {
+        auto guard = GuardIslandUpdate();
+        _deferredModelUpdates.emplace_back(model, DEFERRED_MODEL_DELETE);
+        return;
+    }
+
+    delete model;
+}
+
 bool Map::getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist)
 {
     G3D::Vector3 startPos(x1, y1, z1);
@@ -2426,6 +3178,7 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 
     obj->CleanupsBeforeDelete(false);                            // remove or simplify at least cross referenced links
 
+    auto guard = GuardIslandUpdate();
     i_objectsToRemove.insert(obj);
     //sLog->outDebug(LOG_FILTER_MAPS, "Object (GUID: %u TypeId: %u) added to removing list.", obj->GetGUIDLow(), obj->GetTypeId());
 }
@@ -2438,6 +3191,7 @@ void Map::AddObjectToSwitchList(WorldObject* obj, bool on)
     if (obj->GetTypeId() != TYPEID_UNIT && obj->GetTypeId() != TYPEID_GAMEOBJECT)
         return;
 
+    auto guard = GuardIslandUpdate();
     std::map<WorldObject*, bool>::iterator itr = i_objectsToSwitch.find(obj);
     if (itr == i_objectsToSwitch.end())
         i_objectsToSwitch.insert(itr, std::make_pair(obj, on));
@@ -2525,8 +3279,9 @@ uint32 Map::GetPlayersCountExceptGMs() const
 
 void Map::SendToPlayers(WorldPacket const* data) const
 {
+    SharedPacket sharedPacket(data);
     for (MapRefManager::const_iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
-        itr->GetSource()->GetSession()->SendPacket(data);
+        itr->GetSource()->GetSession()->SendPacket(sharedPacket);
 }
 
 template<class T>
@@ -3116,7 +3871,10 @@ void Map::SaveCreatureRespawnTime(uint32 dbGuid, time_t& respawnTime)
     if (GetInstanceResetPeriod() > 0 && respawnTime - now + 5 >= GetInstanceResetPeriod())
         respawnTime = now + YEAR;
 
-    _creatureRespawnTimes[dbGuid] = respawnTime;
+    {
+        auto guard = GuardIslandUpdate();
+        _creatureRespawnTimes[dbGuid] = respawnTime;
+    }
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CREATURE_RESPAWN);
     stmt->setUInt32(0, dbGuid);
@@ -3128,7 +3886,10 @@ void Map::SaveCreatureRespawnTime(uint32 dbGuid, time_t& respawnTime)
 
 void Map::RemoveCreatureRespawnTime(uint32 dbGuid)
 {
-    _creatureRespawnTimes.erase(dbGuid);
+    {
+        auto guard = GuardIslandUpdate();
+        _creatureRespawnTimes.erase(dbGuid);
+    }
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CREATURE_RESPAWN);
     stmt->setUInt32(0, dbGuid);
@@ -3150,7 +3911,10 @@ void Map::SaveGORespawnTime(uint32 dbGuid, time_t& respawnTime)
     if (GetInstanceResetPeriod() > 0 && respawnTime - now + 5 >= GetInstanceResetPeriod())
         respawnTime = now + YEAR;
 
-    _goRespawnTimes[dbGuid] = respawnTime;
+    {
+        auto guard = GuardIslandUpdate();
+        _goRespawnTimes[dbGuid] = respawnTime;
+    }
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_GO_RESPAWN);
     stmt->setUInt32(0, dbGuid);
@@ -3162,7 +3926,10 @@ void Map::SaveGORespawnTime(uint32 dbGuid, time_t& respawnTime)
 
 void Map::RemoveGORespawnTime(uint32 dbGuid)
 {
-    _goRespawnTimes.erase(dbGuid);
+    {
+        auto guard = GuardIslandUpdate();
+        _goRespawnTimes.erase(dbGuid);
+    }
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GO_RESPAWN);
     stmt->setUInt32(0, dbGuid);
@@ -3341,6 +4108,7 @@ time_t Map::GetLinkedRespawnTime(uint64 guid) const
 void Map::SendZoneDynamicInfo(Player* player)
 {
     uint32 zoneId = GetZoneId(player->GetPositionX(), player->GetPositionY(), player->GetPositionZ());
+    auto guard = GuardIslandUpdate();
     ZoneDynamicInfoMap::const_iterator itr = _zoneDynamicInfo.find(zoneId);
     if (itr == _zoneDynamicInfo.end())
         return;
@@ -3388,6 +4156,7 @@ void Map::PlayDirectSoundToMap(uint32 soundId, uint32 zoneId)
 
 void Map::SetZoneMusic(uint32 zoneId, uint32 musicId)
 {
+    auto guard = GuardIslandUpdate();
     if (_zoneDynamicInfo.find(zoneId) == _zoneDynamicInfo.end())
         _zoneDynamicInfo.insert(ZoneDynamicInfoMap::value_type(zoneId, ZoneDynamicInfo()));
 
@@ -3408,6 +4177,7 @@ void Map::SetZoneMusic(uint32 zoneId, uint32 musicId)
 
 void Map::SetZoneWeather(uint32 zoneId, uint32 weatherId, float weatherGrade)
 {
+    auto guard = GuardIslandUpdate();
     if (_zoneDynamicInfo.find(zoneId) == _zoneDynamicInfo.end())
         _zoneDynamicInfo.insert(ZoneDynamicInfoMap::value_type(zoneId, ZoneDynamicInfo()));
 
@@ -3432,6 +4202,7 @@ void Map::SetZoneWeather(uint32 zoneId, uint32 weatherId, float weatherGrade)
 
 void Map::SetZoneOverrideLight(uint32 zoneId, uint32 lightId, uint32 fadeInTime)
 {
+    auto guard = GuardIslandUpdate();
     if (_zoneDynamicInfo.find(zoneId) == _zoneDynamicInfo.end())
         _zoneDynamicInfo.insert(ZoneDynamicInfoMap::value_type(zoneId, ZoneDynamicInfo()));
 
@@ -15,15 +15,19 @@
 #include "GameObjectModel.h"
 #include "GridDefines.h"
 #include "GridRefManager.h"
+#include "IVMapManager.h"
 #include "MapRefManager.h"
+#include "MapUpdater.h"
 #include "ObjectDefines.h"
+#include "PathCache.h"
 #include "PathGenerator.h"
 #include "SharedDefines.h"
 #include "Timer.h"
 #include <ace/RW_Thread_Mutex.h>
 #include <ace/Thread_Mutex.h>
-#include <bitset>
+#include <atomic>
 #include <list>
+#include <mutex>
 
 class Unit;
 class WorldPacket;
@@ -185,10 +189,24 @@ class GridMap
     uint8 _liquidWidth;
     uint8 _liquidHeight;
 
+    // Memory mapped file, the arrays above point into it (see MapFiles.MemoryMapped)
+    uint8* _mapping;
+    size_t _mappingSize;
+
     bool loadAreaData(FILE* in, uint32 offset, uint32 size);
     bool loadHeightData(FILE* in, uint32 offset, uint32 size);
     bool loadLiquidData(FILE* in, uint32 offset, uint32 size);
 
+    bool mapFile(char const* filename);
+    bool loadMappedData(char const* filename);
+    bool mapAreaData(uint32 offset);
+    bool mapHeightData(uint32 offset);
+    bool mapLiquidData(uint32 offset);
+    template<class T> bool mapArray(T*& array, uint32& offset, uint32 count);
+    template<class T> bool mapHeader(T& header, uint32 offset) const;
+    template<class T> void freeArray(T*& array);
+    void unmapData();
+
     // Get height functions and pointers
     typedef float (GridMap::*GetHeightPtr) (float x, float y) const;
     GetHeightPtr _gridGetHeight;
@@ -257,6 +275,50 @@ typedef std::map<uint32/*leaderDBGUID*/, CreatureGroup*>        CreatureGroupHol
 typedef std::unordered_map<uint32 /*zoneId*/, ZoneDynamicInfo> ZoneDynamicInfoMap;
 typedef std::set<MotionTransport*> TransportsContainer;
 
+// Visited cell marks, atomic so the update islands of a map can share them
+template<size_t N>
+class CellMarks
+{
+public:
+    void reset()
+    {
+        for (std::atomic<uint64>& word : _words)
+            word.store(0, std::memory_order_relaxed);
+    }
+
+    // returns false if the cell was already marked
+    bool mark(uint32 cellId)
+    {
+        uint64 bit = uint64(1) << (cellId % 64);
+        return !(_words[cellId / 64].fetch_or(bit, std::memory_order_relaxed) & bit);
+    }
+
+private:
+    std::atomic<uint64> _words[(N + 63) / 64];
+};
+
+// Spatially disjoint part of a continent, updated on its own by a map update worker
+struct MapUpdateIsland : public MapUpdateTask
+{
+    explicit MapUpdateIsland(Map* map) : map(map) { }
+
+    void Run() override;
+
+    Map* map;
+    uint32 t_diff{0};
+    std::vector<Player*> players;
+    std::vector<WorldObject*> activeObjects;
+};
+
+// Slice of the path requests of a map, calculated by a map update worker, see Map::ProcessPathRequests
+struct MapPathBatch : public MapUpdateTask
+{
+    void Run() override;
+
+    PathGenerator* const* begin{nullptr};
+    PathGenerator* const* end{nullptr};
+};
+
 enum EncounterCreditType
 {
     ENCOUNTER_CREDIT_KILL_CREATURE  = 0,
@@ -266,6 +328,7 @@ enum EncounterCreditType
 class Map : public GridRefManager<NGridType>
 {
     friend class MapReference;
+    friend struct MapUpdateIsland;
 public:
     Map(uint32 id, uint32 InstanceId, uint8 SpawnMode, Map* _parent = nullptr);
     ~Map() override;
@@ -302,6 +365,15 @@ public:
 
     virtual void Update(const uint32, const uint32, bool thread = true);
 
+    // Update cost measured by MapUpdater (microseconds), used to schedule the most expensive maps first
+    [[nodiscard]] uint32 GetUpdateCost() const { return _updateCost; }
+    [[nodiscard]] uint32 GetLastUpdateTime() const { return _lastUpdateTime; }
+    void RecordUpdateTime(uint32 updateTime)
+    {
+        _lastUpdateTime = updateTime;
+        _updateCost = (_updateCost * 3 + updateTime) / 4;
+    }
+
     [[nodiscard]] float GetVisibilityRange() const { return m_VisibleDistance; }
     void SetVisibilityRange(float range) { m_VisibleDistance = range; }
     //function for setting up visibility distance for maps on per-type/per-Id basis
@@ -343,6 +415,7 @@ public:
     std::unordered_set<Object*> i_objectsToUpdate;
     void BuildAndSendUpdateForObjects(); // definition in ObjectAccessor.cpp, below ObjectAccessor::Update, because it does the same for a map
     std::unordered_set<Unit*> i_objectsForDelayedVisibility;
+    void AddObjectForDelayedVisibility(Unit* unit) { auto guard = GuardIslandUpdate(); i_objectsForDelayedVisibility.insert(unit); }
     void HandleDelayedVisibility();
 
     // some calls like isInWater should not use vmaps due to processor power
@@ -410,17 +483,15 @@ public:
     void UpdateObjectsVisibilityFor(Player* player, Cell cell, CellCoord cellpair);
 
     void resetMarkedCells() { marked_cells.reset(); }
-    bool isCellMarked(uint32 pCellId) { return marked_cells.test(pCellId); }
-    void markCell(uint32 pCellId) { marked_cells.set(pCellId); }
+    bool markCell(uint32 pCellId) { return marked_cells.mark(pCellId); }
     void resetMarkedCellsLarge() { marked_cells_large.reset(); }
-    bool isCellMarkedLarge(uint32 pCellId) { return marked_cells_large.test(pCellId); }
-    void markCellLarge(uint32 pCellId) { marked_cells_large.set(pCellId); }
+    bool markCellLarge(uint32 pCellId) { return marked_cells_large.mark(pCellId); }
 
     [[nodiscard]] bool HavePlayers() const { return !m_mapRefManager.isEmpty(); }
     [[nodiscard]] uint32 GetPlayersCountExceptGMs() const;
 
-    void AddWorldObject(WorldObject* obj) { i_worldObjects.insert(obj); }
-    void RemoveWorldObject(WorldObject* obj) { i_worldObjects.erase(obj); }
+    void AddWorldObject(WorldObject* obj) { auto guard = GuardIslandUpdate(); i_worldObjects.insert(obj); }
+    void RemoveWorldObject(WorldObject* obj) { auto guard = GuardIslandUpdate(); i_worldObjects.erase(obj); }
 
     void SendToPlayers(WorldPacket const* data) const;
 
@@ -471,14 +542,23 @@ public:
     float GetWaterOrGroundLevel(uint32 phasemask, float x, float y, float z, float* ground = nullptr, bool swim = false, float collisionHeight = DEFAULT_COLLISION_HEIGHT) const;
     [[nodiscard]] float GetHeight(uint32 phasemask, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
     [[nodiscard]] bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks) const;
+    // same checks for many rays at once, see WorldObject::GetLineOfSightRay
+    void isInLineOfSight(std::vector<VMAP::LineOfSightRay>& rays, LineOfSightChecks checks) const;
     bool CanReachPositionAndGetValidCoords(const WorldObject* source, PathGenerator *path, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
+
+    // paths requested during the update are calculated together at its end, see PathGenerator::CalculatePathAsync
+    void AddPathRequest(PathGenerator* path);
+    void RemovePathRequest(PathGenerator* path);
+    // recently calculated paths, see PathGenerator::BuildPolyPath
+    PathCache& GetPathCache() { return _pathCache; }
     bool CanReachPositionAndGetValidCoords(const WorldObject* source, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CanReachPositionAndGetValidCoords(const WorldObject* source, float startX, float startY, float startZ, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CheckCollisionAndGetValidCoords(const WorldObject* source, float startX, float startY, float startZ, float &destX, float &destY, float &destZ, bool failOnCollision = true) const;
-    void Balance() { _dynamicTree.balance(); }
-    void RemoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.remove(model); }
-    void InsertGameObjectModel(const GameObjectModel& model) { _dynamicTree.insert(model); }
-    [[nodiscard]] bool ContainsGameObjectModel(const GameObjectModel& model) const { return _dynamicTree.contains(model);}
+    void Balance();
+    void RemoveGameObjectModel(const GameObjectModel& model);
+    void InsertGameObjectModel(const GameObjectModel& model);
+    [[nodiscard]] bool ContainsGameObjectModel(const GameObjectModel& model) const;
+    void DeleteGameObjectModel(GameObjectModel* model);
     [[nodiscard]] DynamicMapTree const& GetDynamicMapTree() const { return _dynamicTree; }
     bool getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist);
     [[nodiscard]] float GetGameObjectFloor(uint32 phasemask, float x, float y, float z, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const
@@ -491,6 +571,7 @@ public:
     [[nodiscard]] time_t GetLinkedRespawnTime(uint64 guid) const;
     [[nodiscard]] time_t GetCreatureRespawnTime(uint32 dbGuid) const
     {
+        auto guard = GuardIslandUpdate();
         std::unordered_map<uint32 /*dbGUID*/, time_t>::const_iterator itr = _creatureRespawnTimes.find(dbGuid);
         if (itr != _creatureRespawnTimes.end())
             return itr->second;
@@ -500,6 +581,7 @@ public:
 
     [[nodiscard]] time_t GetGORespawnTime(uint32 dbGuid) const
     {
+        auto guard = GuardIslandUpdate();
         std::unordered_map<uint32 /*dbGUID*/, time_t>::const_iterator itr = _goRespawnTimes.find(dbGuid);
         if (itr != _goRespawnTimes.end())
             return itr->second;
@@ -539,6 +621,15 @@ public:
 
     DataMap CustomData;
 
+    // True while the islands of this continent are updated concurrently, see UpdateIslands
+    [[nodiscard]] bool IsUpdatingIslands() const { return _islandUpdate; }
+    // Serializes callers running on different update islands of this map, does nothing otherwise.
+    // Zone scripts (outdoor PvP, battlefields) and other state shared by a whole zone are used under it.
+    [[nodiscard]] std::unique_lock<std::recursive_mutex> GuardIslandUpdate() const
+    {
+        return _islandUpdate ? std::unique_lock<std::recursive_mutex>(_islandLock) : std::unique_lock<std::recursive_mutex>();
+    }
+
 private:
     void LoadMapAndVMap(int gx, int gy);
     void LoadVMap(int gx, int gy);
@@ -547,6 +638,12 @@ private:
     // Load MMap Data
     void LoadMMap(int gx, int gy);
 
+    // installs terrain loaded in the background and requests the grids ahead of moving players, continents only
+    void UpdateGridPreload(uint32 diff);
+    void RequestGridPreload(float x, float y);
+
+    void ProcessPathRequests();
+
     template<class T> void InitializeObject(T* obj);
     void AddCreatureToMoveList(Creature* c);
     void RemoveCreatureFromMoveList(Creature* c);
@@ -579,6 +676,19 @@ private:
 
     void UpdateActiveCells(const float& x, const float& y, const uint32 t_diff);
 
+    // cells around the player, its far sight object and the creatures attacking it from far away
+    void VisitNearbyCellsOfPlayerAndTargets(Player* player, std::vector<Creature*>& updateList,
+                                            TypeContainerVisitor<acore::ObjectUpdater, GridTypeMapContainer>& gridVisitor,
+                                            TypeContainerVisitor<acore::ObjectUpdater, WorldTypeMapContainer>& worldVisitor,
+                                            TypeContainerVisitor<acore::ObjectUpdater, GridTypeMapContainer>& largeGridVisitor,
+                                            TypeContainerVisitor<acore::ObjectUpdater, WorldTypeMapContainer>& largeWorldVisitor);
+
+    // Parallel update of spatially disjoint islands of a continent. Players are updated on the calling worker
+    // before the islands start, the islands only update the objects around them. Objects shared between islands
+    // are only touched through the guarded helpers and the deferred lists processed after all islands finished.
+    bool UpdateIslands(uint32 t_diff, uint32 s_diff);
+    void UpdateIsland(MapUpdateIsland& island);
+
 protected:
     ACE_Thread_Mutex Lock;
     ACE_Thread_Mutex GridLock;
@@ -619,8 +729,8 @@ private:
 
     NGridType* i_grids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
     GridMap* GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
-    std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
-    std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells_large;
+    CellMarks<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
+    CellMarks<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells_large;
 
     bool i_scriptLock;
     std::unordered_set<WorldObject*> i_objectsToRemove;
@@ -639,11 +749,13 @@ private:
 
     void AddToActiveHelper(WorldObject* obj)
     {
+        auto guard = GuardIslandUpdate();
         m_activeNonPlayers.insert(obj);
     }
 
     void RemoveFromActiveHelper(WorldObject* obj)
     {
+        auto guard = GuardIslandUpdate();
         // Map::Update for active object in proccess
         if (m_activeNonPlayersIter != m_activeNonPlayers.end())
         {
@@ -663,6 +775,31 @@ private:
 
     ZoneDynamicInfoMap _zoneDynamicInfo;
     uint32 _defaultLight;
+
+    uint32 _updateCost;
+    uint32 _lastUpdateTime;
+
+    std::atomic<bool> _islandUpdate;
+    mutable std::recursive_mutex _islandLock;
+    std::vector<MapUpdateIsland> _updateIslands;
+    enum DeferredModelUpdate : uint8
+    {
+        DEFERRED_MODEL_INSERT,
+        DEFERRED_MODEL_REMOVE,
+        DEFERRED_MODEL_DELETE
+    };
+
+    // dynamic tree changes made while islands are updated, the tree is read concurrently by LoS and height queries
+    std::vector<std::pair<GameObjectModel const*, DeferredModelUpdate>> _deferredModelUpdates;
+    bool _deferredBalance;
+
+    std::mutex _pathRequestLock; // requests may come from concurrently updated islands
+    std::vector<PathGenerator*> _pathRequests;
+    std::vector<MapPathBatch> _pathBatches;
+    PathCache _pathCache;
+
+    uint32 _gridPreloadTimer;
+    std::unordered_map<uint32 /*gx * MAX_NUMBER_OF_GRIDS + gy*/, uint32 /*install time*/> _preloadedGridMaps; // installed by UpdateGridPreload, grid not created yet
 };
 
 enum InstanceResetMethod
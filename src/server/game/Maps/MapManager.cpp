@@ -11,6 +11,7 @@
 #include "Corpse.h"
 #include "DatabaseEnv.h"
 #include "GridDefines.h"
+#include "GridMapPreloader.h"
 #include "Group.h"
 #include "InstanceSaveMgr.h"
 #include "InstanceScript.h"
@@ -57,6 +58,9 @@ void MapManager::Initialize()
     // Start mtmaps if needed
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    if (uint32 preloadThreads = sWorld->getIntConfig(CONFIG_GRID_PRELOAD_THREADS))
+        sGridMapPreloader->Start(preloadThreads, sWorld->GetDataPath());
 }
 
 void MapManager::InitializeVisibilityDistanceInfo()
@@ -342,6 +346,8 @@ void MapManager::UnloadAll()
 
     if (m_updater.activated())
         m_updater.deactivate();
+
+    sGridMapPreloader->Stop();
 }
 
 void MapManager::GetNumInstances(uint32& dungeons, uint32& battlegrounds, uint32& arenas)
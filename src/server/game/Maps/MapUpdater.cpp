@@ -8,55 +8,17 @@
 #include "LFGMgr.h"
 #include "Map.h"
 #include "MapUpdater.h"
+#include <algorithm>
+#include <chrono>
 
-class UpdateRequest
+namespace
 {
-public:
-    UpdateRequest() = default;
-    virtual ~UpdateRequest() = default;
-
-    virtual void call() = 0;
-};
-
-class MapUpdateRequest : public UpdateRequest
-{
-public:
-    MapUpdateRequest(Map& m, MapUpdater& u, uint32 d, uint32 sd)
-        : m_map(m), m_updater(u), m_diff(d), s_diff(sd)
-    {
-    }
-
-    void call() override
-    {
-        m_map.Update(m_diff, s_diff);
-        m_updater.update_finished();
-    }
-private:
-    Map& m_map;
-    MapUpdater& m_updater;
-    uint32 m_diff;
-    uint32 s_diff;
-};
-
-class LFGUpdateRequest : public UpdateRequest
-{
-public:
-    LFGUpdateRequest(MapUpdater& u, uint32 d) : m_updater(u), m_diff(d) {}
-
-    void call() override
-    {
-        uint32 startTime = getMSTime();
-        sLFGMgr->Update(m_diff, 1);
-        uint32 totalTime = getMSTimeDiff(startTime, getMSTime());
-        lfgDiffTracker.Update(totalTime);
-        m_updater.update_finished();
-    }
-private:
-    MapUpdater& m_updater;
-    uint32 m_diff;
-};
+    // set for map update worker threads, lets requests scheduled from inside an update (MapInstanced) go to the local queue
+    thread_local MapUpdater* t_updater = nullptr;
+    thread_local size_t t_workerIndex = 0;
+}
 
-MapUpdater::MapUpdater(): pending_requests(0)
+MapUpdater::MapUpdater(): _queuedRequests(0), _queuedTasks(0), _cancelationToken(false), pending_requests(0), _lfgUpdateCost(0)
 {
 }
 
@@ -67,9 +29,12 @@ MapUpdater::~MapUpdater()
 
 void MapUpdater::activate(size_t num_threads)
 {
+    for (size_t i = 0; i < num_threads; ++i)
+        _queues.push_back(std::make_unique<WorkerQueue>());
+
     for (size_t i = 0; i < num_threads; ++i)
     {
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
     }
 }
 
@@ -79,68 +44,300 @@ void MapUpdater::deactivate()
 
     wait();
 
-    _queue.Cancel();
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _workCondition.notify_all();
+    }
 
     for (auto& thread : _workerThreads)
     {
         thread.join();
     }
+
+    _workerThreads.clear();
 }
 
 void MapUpdater::wait()
 {
     std::unique_lock<std::mutex> guard(_lock);
 
+    dispatch();
+
     while (pending_requests > 0)
-        _condition.wait(guard);
+        _finishedCondition.wait(guard);
+
+    _lastTickSlowest = _tickSlowest;
+    _tickSlowest = MapUpdateTiming();
 
     guard.unlock();
 }
 
 void MapUpdater::schedule_update(Map& map, uint32 diff, uint32 s_diff)
 {
-    std::lock_guard<std::mutex> guard(_lock);
+    schedule({ &map, diff, s_diff, map.GetUpdateCost() });
+}
 
-    ++pending_requests;
+void MapUpdater::schedule_lfg_update(uint32 diff)
+{
+    schedule({ nullptr, diff, 0, _lfgUpdateCost });
+}
+
+bool MapUpdater::activated()
+{
+    return _workerThreads.size() > 0;
+}
 
-    _queue.Push(new MapUpdateRequest(map, *this, diff, s_diff));
+bool MapUpdater::is_worker_thread()
+{
+    return t_updater == this;
 }
 
-void MapUpdater::schedule_lfg_update(uint32 diff)
+void MapUpdater::run_tasks(std::vector<MapUpdateTask*> const& tasks)
+{
+    ASSERT(is_worker_thread());
+
+    if (tasks.empty())
+        return;
+
+    TaskBatch batch;
+    batch.tasks = &tasks;
+    batch.next = 0;
+    batch.remaining = tasks.size();
+
+    {
+        std::lock_guard<std::mutex> guard(_taskLock);
+        _taskBatches.push_back(&batch);
+        _queuedTasks += tasks.size();
+    }
+
+    {
+        // idle workers check for queued tasks under this lock before they sleep
+        std::lock_guard<std::mutex> guard(_lock);
+        _workCondition.notify_all();
+    }
+
+    TaskBatch* ownBatch = &batch;
+    MapUpdateTask* task;
+    while (pop_task(ownBatch, task))
+        run_task(batch, task);
+
+    // the last tasks may still run on other workers
+    std::unique_lock<std::mutex> guard(_taskLock);
+    while (batch.remaining)
+        batch.finished.wait(guard);
+}
+
+MapUpdateTiming MapUpdater::last_tick_slowest()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _lastTickSlowest;
+}
+
+void MapUpdater::schedule(UpdateRequest const& request)
 {
     std::lock_guard<std::mutex> guard(_lock);
 
     ++pending_requests;
 
-    _queue.Push(new LFGUpdateRequest(*this, diff));
+    // scheduled from the world thread: keep it until wait() so the whole tick can be ordered at once
+    if (t_updater != this)
+    {
+        _staged.push_back(request);
+        return;
+    }
+
+    // scheduled from inside a running update, workers are busy already
+    ++_queuedRequests;
+    push(*_queues[t_workerIndex], request);
+    _workCondition.notify_one();
 }
 
-bool MapUpdater::activated()
+void MapUpdater::dispatch()
 {
-    return _workerThreads.size() > 0;
+    if (_staged.empty())
+        return;
+
+    // longest job first, lfg is always started first so its result is ready early in the tick
+    std::sort(_staged.begin(), _staged.end(), [](UpdateRequest const& left, UpdateRequest const& right)
+    {
+        if (!left.map != !right.map)
+            return !left.map;
+
+        return left.cost > right.cost;
+    });
+
+    for (auto& queue : _queues)
+        queue->assignedCost = 0;
+
+    // greedy assignment to the least loaded worker, stealing evens out mispredictions
+    for (UpdateRequest const& request : _staged)
+    {
+        WorkerQueue* target = _queues.front().get();
+        for (auto& queue : _queues)
+            if (queue->assignedCost < target->assignedCost)
+                target = queue.get();
+
+        target->assignedCost += request.cost + 1;
+
+        ++_queuedRequests;
+        push(*target, request);
+    }
+
+    _staged.clear();
+    _workCondition.notify_all();
 }
 
-void MapUpdater::update_finished()
+void MapUpdater::push(WorkerQueue& queue, UpdateRequest const& request)
+{
+    std::lock_guard<std::mutex> guard(queue.lock);
+
+    auto itr = std::upper_bound(queue.requests.begin() + queue.head, queue.requests.end(), request, [](UpdateRequest const& left, UpdateRequest const& right)
+    {
+        return left.cost > right.cost;
+    });
+
+    queue.requests.insert(itr, request);
+}
+
+bool MapUpdater::pop(size_t workerIndex, UpdateRequest& request)
+{
+    for (size_t i = 0; i < _queues.size(); ++i)
+    {
+        WorkerQueue& queue = *_queues[(workerIndex + i) % _queues.size()];
+        std::lock_guard<std::mutex> guard(queue.lock);
+
+        if (queue.head == queue.requests.size())
+            continue;
+
+        if (i == 0)
+            request = queue.requests[queue.head++];
+        else
+        {
+            request = queue.requests.back();
+            queue.requests.pop_back();
+        }
+
+        // keep capacity, requests are stored by value and the queue is reused every tick
+        if (queue.head == queue.requests.size())
+        {
+            queue.requests.clear();
+            queue.head = 0;
+        }
+
+        --_queuedRequests;
+        return true;
+    }
+
+    return false;
+}
+
+bool MapUpdater::pop_task(TaskBatch*& batch, MapUpdateTask*& task)
+{
+    if (!batch && !_queuedTasks)
+        return false;
+
+    std::lock_guard<std::mutex> guard(_taskLock);
+
+    if (!batch)
+    {
+        if (_taskBatches.empty())
+            return false;
+
+        batch = _taskBatches.front();
+    }
+
+    if (batch->next == batch->tasks->size())
+        return false;
+
+    task = (*batch->tasks)[batch->next++];
+    --_queuedTasks;
+
+    if (batch->next == batch->tasks->size())
+        _taskBatches.erase(std::find(_taskBatches.begin(), _taskBatches.end(), batch));
+
+    return true;
+}
+
+void MapUpdater::run_task(TaskBatch& batch, MapUpdateTask* task)
+{
+    task->Run();
+
+    // the waiting worker destroys the batch once remaining is 0, it is not touched after the lock is released
+    std::lock_guard<std::mutex> guard(_taskLock);
+    if (!--batch.remaining)
+        batch.finished.notify_one();
+}
+
+void MapUpdater::update_finished(UpdateRequest const& request, uint32 updateTime)
 {
     std::lock_guard<std::mutex> lock(_lock);
 
+    if (request.map && updateTime >= _tickSlowest.updateTime)
+    {
+        _tickSlowest.mapId = request.map->GetId();
+        _tickSlowest.instanceId = request.map->GetInstanceId();
+        _tickSlowest.updateTime = updateTime;
+    }
+
     --pending_requests;
 
-    _condition.notify_all();
+    if (!pending_requests)
+        _finishedCondition.notify_all();
 }
 
-void MapUpdater::WorkerThread()
+void MapUpdater::WorkerThread(size_t workerIndex)
 {
+    t_updater = this;
+    t_workerIndex = workerIndex;
+
     while (1)
     {
-        UpdateRequest* request = nullptr;
+        // tasks first, a map update is waiting for them
+        TaskBatch* batch = nullptr;
+        MapUpdateTask* task;
+        if (pop_task(batch, task))
+        {
+            run_task(*batch, task);
+            continue;
+        }
+
+        UpdateRequest request;
+
+        if (!pop(workerIndex, request))
+        {
+            std::unique_lock<std::mutex> guard(_lock);
+
+            while (!_queuedRequests && !_queuedTasks && !_cancelationToken)
+                _workCondition.wait(guard);
+
+            if (_cancelationToken && !_queuedRequests)
+                return;
+
+            continue;
+        }
+
+        run(request);
+    }
+}
+
+void MapUpdater::run(UpdateRequest const& request)
+{
+    auto startTime = std::chrono::steady_clock::now();
 
-        _queue.WaitAndPop(request);
-        if (_cancelationToken)
-            return;
+    if (request.map)
+        request.map->Update(request.diff, request.s_diff);
+    else
+        sLFGMgr->Update(request.diff, 1);
 
-        request->call();
+    uint32 updateTime = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count());
 
-        delete request;
+    if (request.map)
+        request.map->RecordUpdateTime(updateTime);
+    else
+    {
+        lfgDiffTracker.Update(updateTime / 1000);
+        _lfgUpdateCost = (_lfgUpdateCost * 3 + updateTime) / 4;
     }
-}
\ No newline at end of file
+
+    update_finished(request, updateTime);
+}
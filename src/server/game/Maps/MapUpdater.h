@@ -2,13 +2,30 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Define.h"
-#include "PCQueue.h"
+#include <atomic>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 class Map;
-class UpdateRequest;
+
+// Part of a map update that may run concurrently on another worker, see MapUpdater::run_tasks
+class MapUpdateTask
+{
+public:
+    virtual ~MapUpdateTask() = default;
+
+    virtual void Run() = 0;
+};
+
+struct MapUpdateTiming
+{
+    uint32 mapId{0};
+    uint32 instanceId{0};
+    uint32 updateTime{0}; // microseconds
+};
 
 class MapUpdater
 {
@@ -22,19 +39,75 @@ public:
     void activate(size_t num_threads);
     void deactivate();
     bool activated();
-    void update_finished();
+    bool is_worker_thread();
+    [[nodiscard]] size_t worker_count() const { return _workerThreads.size(); }
+
+    // runs the tasks on the pool and returns when all of them are done, the calling worker only helps with its own tasks meanwhile
+    void run_tasks(std::vector<MapUpdateTask*> const& tasks);
+
+    // slowest map update of the last completed tick
+    MapUpdateTiming last_tick_slowest();
 
 private:
-    void WorkerThread();
+    struct UpdateRequest
+    {
+        Map* map;       // nullptr for the lfg update
+        uint32 diff;
+        uint32 s_diff;
+        uint32 cost;    // expected update time, microseconds
+    };
+
+    // Tasks of one run_tasks call. They are kept apart from the update requests, so a worker
+    // waiting for its tasks never starts the update of another map.
+    struct TaskBatch
+    {
+        std::vector<MapUpdateTask*> const* tasks;
+        size_t next;        // first task not taken yet
+        size_t remaining;   // tasks not finished yet
+        std::condition_variable finished;
+    };
+
+    // Per worker queue, ordered by descending cost.
+    // The owner takes the most expensive request from the head, idle workers steal the cheapest from the tail.
+    struct WorkerQueue
+    {
+        std::mutex lock;
+        std::vector<UpdateRequest> requests;
+        size_t head{0};
+        uint64 assignedCost{0};
+    };
 
-    ProducerConsumerQueue<UpdateRequest*> _queue;
+    void schedule(UpdateRequest const& request);
+    void dispatch();
+    void push(WorkerQueue& queue, UpdateRequest const& request);
+    bool pop(size_t workerIndex, UpdateRequest& request);
+    // takes a task of the batch, or of the oldest batch with tasks left if batch is nullptr
+    bool pop_task(TaskBatch*& batch, MapUpdateTask*& task);
+    void run_task(TaskBatch& batch, MapUpdateTask* task);
+    void run(UpdateRequest const& request);
+    void update_finished(UpdateRequest const& request, uint32 updateTime);
+
+    void WorkerThread(size_t workerIndex);
+
+    std::vector<std::unique_ptr<WorkerQueue>> _queues;
+    std::vector<UpdateRequest> _staged;
+    std::atomic<size_t> _queuedRequests;
+
+    std::mutex _taskLock;
+    std::vector<TaskBatch*> _taskBatches;   // batches with tasks not taken yet, oldest first
+    std::atomic<size_t> _queuedTasks;
 
     std::vector<std::thread> _workerThreads;
     std::atomic<bool> _cancelationToken;
 
     std::mutex _lock;
-    std::condition_variable _condition;
+    std::condition_variable _workCondition;
+    std::condition_variable _finishedCondition;
     size_t pending_requests;
+
+    std::atomic<uint32> _lfgUpdateCost;
+    MapUpdateTiming _tickSlowest;
+    MapUpdateTiming _lastTickSlowest;
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
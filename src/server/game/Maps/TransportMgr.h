@@ -88,7 +88,7 @@ typedef std::map<uint32, TransportAnimation> TransportAnimationContainer;
 
 class TransportMgr
 {
-    friend void LoadDBCStores(std::string const&);
+    friend void LoadDBCStores(std::string const&, std::string const&);
 
 public:
     static TransportMgr* instance();
@@ -6,6 +6,28 @@ uint32 SavingSystemMgr::m_savingMaxValueAssigned = 0;
 uint32 SavingSystemMgr::m_savingDiffSum = 0;
 std::list<uint32> SavingSystemMgr::m_savingSkipList;
 ACE_Thread_Mutex SavingSystemMgr::_savingLock;
+std::atomic<uint64> SavingSystemMgr::m_playerSaves(0);
+std::atomic<uint64> SavingSystemMgr::m_playerSaveStatements(0);
+std::atomic<uint64> SavingSystemMgr::m_playerSaveBytes(0);
+std::atomic<uint64> SavingSystemMgr::m_playerSaveUnchangedTables(0);
+
+void SavingSystemMgr::RecordPlayerSave(uint32 statements, uint32 bytes, uint32 unchangedTables)
+{
+    m_playerSaves.fetch_add(1, std::memory_order_relaxed);
+    m_playerSaveStatements.fetch_add(statements, std::memory_order_relaxed);
+    m_playerSaveBytes.fetch_add(bytes, std::memory_order_relaxed);
+    m_playerSaveUnchangedTables.fetch_add(unchangedTables, std::memory_order_relaxed);
+}
+
+PlayerSaveStats SavingSystemMgr::GetPlayerSaveStats()
+{
+    PlayerSaveStats stats;
+    stats.saves = m_playerSaves.load(std::memory_order_relaxed);
+    stats.statements = m_playerSaveStatements.load(std::memory_order_relaxed);
+    stats.bytes = m_playerSaveBytes.load(std::memory_order_relaxed);
+    stats.unchangedTables = m_playerSaveUnchangedTables.load(std::memory_order_relaxed);
+    return stats;
+}
 
 void SavingSystemMgr::Update(uint32 diff)
 {
@@ -2,9 +2,18 @@
 #define __SAVINGSYSTEM_H
 
 #include "Common.h"
+#include <atomic>
 
 // to evenly distribute saving players to db
 
+struct PlayerSaveStats
+{
+    uint64 saves;
+    uint64 statements;
+    uint64 bytes;           // sql text and bound parameters sent to the db
+    uint64 unchangedTables; // tables not rewritten because nothing changed since the last save
+};
+
 class SavingSystemMgr
 {
 public:
@@ -16,12 +25,20 @@ public:
     static uint32 IncreaseSavingMaxValue(uint32 inc)            { ACORE_GUARD(ACE_Thread_Mutex, _savingLock); return (m_savingMaxValueAssigned += inc); }
     static void InsertToSavingSkipListIfNeeded(uint32 id)       { if (id > m_savingCurrentValue) { ACORE_GUARD(ACE_Thread_Mutex, _savingLock); m_savingSkipList.push_back(id); } }
 
+    static void RecordPlayerSave(uint32 statements, uint32 bytes, uint32 unchangedTables); // players are saved from map threads
+    static PlayerSaveStats GetPlayerSaveStats();
+
 protected:
     static uint32 m_savingCurrentValue;
     static uint32 m_savingMaxValueAssigned;
     static uint32 m_savingDiffSum;
     static std::list<uint32> m_savingSkipList;
     static ACE_Thread_Mutex _savingLock;
+
+    static std::atomic<uint64> m_playerSaves;
+    static std::atomic<uint64> m_playerSaveStatements;
+    static std::atomic<uint64> m_playerSaveBytes;
+    static std::atomic<uint64> m_playerSaveUnchangedTables;
 };
 
 #endif
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "PathCache.h"
+
+std::atomic<uint64> PathCache::_hits(0);
+std::atomic<uint64> PathCache::_misses(0);
+std::atomic<uint64> PathCache::_invalidated(0);
+std::atomic<uint64> PathCache::_evicted(0);
+
+bool PathCache::Find(PathCacheKey const& key, dtNavMesh const* navMesh, PathCacheEntry& entry)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    auto itr = _index.find(key);
+    if (itr == _index.end())
+    {
+        _misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    EntryList::iterator entryItr = itr->second;
+    for (dtPolyRef poly : entryItr->second.polys)
+    {
+        if (!navMesh->isValidPolyRef(poly))
+        {
+            _entries.erase(entryItr);
+            _index.erase(itr);
+            _invalidated.fetch_add(1, std::memory_order_relaxed);
+            _misses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    _entries.splice(_entries.begin(), _entries, entryItr);
+    entry = entryItr->second;
+    _hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void PathCache::Store(PathCacheKey const& key, PathCacheEntry&& entry)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    auto itr = _index.find(key);
+    if (itr != _index.end())
+    {
+        itr->second->second = std::move(entry);
+        _entries.splice(_entries.begin(), _entries, itr->second);
+        return;
+    }
+
+    _entries.emplace_front(key, std::move(entry));
+    _index[key] = _entries.begin();
+
+    if (_entries.size() > _maxEntries)
+    {
+        _index.erase(_entries.back().first);
+        _entries.pop_back();
+        _evicted.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+PathCacheStats PathCache::GetStats()
+{
+    PathCacheStats stats;
+    stats.hits = _hits.load(std::memory_order_relaxed);
+    stats.misses = _misses.load(std::memory_order_relaxed);
+    stats.invalidated = _invalidated.load(std::memory_order_relaxed);
+    stats.evicted = _evicted.load(std::memory_order_relaxed);
+    return stats;
+}
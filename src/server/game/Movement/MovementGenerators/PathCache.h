@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PATH_CACHE_H
+#define _PATH_CACHE_H
+
+#include "Define.h"
+#include "DetourNavMesh.h"
+#include "MoveSplineInitArgs.h"
+#include <G3D/Vector3.h>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// size of the cells start and end positions are rounded to, paths between the same cells are shared
+#define PATH_CACHE_CELL_SIZE    1.0f
+
+struct PathCacheStats
+{
+    uint64 hits;
+    uint64 misses;
+    uint64 invalidated; // found, but a tile of the path was unloaded or reloaded meanwhile
+    uint64 evicted;
+};
+
+struct PathCacheKey
+{
+    dtPolyRef startPoly;
+    dtPolyRef endPoly;
+    int32 startCell[3];
+    int32 endCell[3];
+    uint16 includeFlags;
+    uint16 excludeFlags;
+    uint16 options;     // path generator options and movement abilities of the source, see PathGenerator::MakeCacheKey
+    uint16 pointLimit;
+    uint32 phaseMask;
+    // the height of the points is corrected for the source, see WorldObject::UpdateAllowedPositionZ
+    float collisionHeight;
+    float minHeightInWater;
+    float hoverHeight;
+
+    bool operator==(PathCacheKey const& right) const
+    {
+        return startPoly == right.startPoly && endPoly == right.endPoly &&
+            startCell[0] == right.startCell[0] && startCell[1] == right.startCell[1] && startCell[2] == right.startCell[2] &&
+            endCell[0] == right.endCell[0] && endCell[1] == right.endCell[1] && endCell[2] == right.endCell[2] &&
+            includeFlags == right.includeFlags && excludeFlags == right.excludeFlags &&
+            options == right.options && pointLimit == right.pointLimit && phaseMask == right.phaseMask &&
+            collisionHeight == right.collisionHeight && minHeightInWater == right.minHeightInWater && hoverHeight == right.hoverHeight;
+    }
+};
+
+struct PathCacheKeyHash
+{
+    size_t operator()(PathCacheKey const& key) const
+    {
+        size_t hash = std::hash<uint64>()(key.startPoly) ^ (std::hash<uint64>()(key.endPoly) * 31);
+        for (uint8 i = 0; i < 3; ++i)
+            hash = hash * 131 + uint32(key.startCell[i]) * 7 + uint32(key.endCell[i]);
+        // shifted as uint64 and folded, size_t is only 32 bits wide on 32-bit targets
+        uint64 flags = (uint64(key.includeFlags) << 48) ^ (uint64(key.options) << 32) ^ key.pointLimit ^ (uint64(key.phaseMask) << 16);
+        return hash ^ size_t(flags ^ (flags >> 32));
+    }
+};
+
+struct PathCacheEntry
+{
+    std::vector<dtPolyRef> polys;
+    Movement::PointsArray points;
+    G3D::Vector3 end;       // requested destination
+    G3D::Vector3 actualEnd;
+};
+
+/*
+ * Least recently used smoothed paths of one map.
+ *
+ * Entries are keyed by start and end polygon, start and end position cell and everything else the
+ * calculation depends on. The polygon references carry the salt of their tile, so an entry whose path
+ * crosses a tile the MMapManager unloaded or reloaded since is recognized on lookup and dropped.
+ * Lookups may come from several threads of the same map (path batch, islands).
+ */
+class PathCache
+{
+public:
+    explicit PathCache(uint32 maxEntries) : _maxEntries(maxEntries) { }
+
+    [[nodiscard]] bool IsEnabled() const { return _maxEntries != 0; }
+
+    bool Find(PathCacheKey const& key, dtNavMesh const* navMesh, PathCacheEntry& entry);
+    void Store(PathCacheKey const& key, PathCacheEntry&& entry);
+
+    static PathCacheStats GetStats();
+
+private:
+    typedef std::list<std::pair<PathCacheKey, PathCacheEntry>> EntryList;
+
+    std::mutex _lock;
+    EntryList _entries; // most recently used first
+    std::unordered_map<PathCacheKey, EntryList::iterator, PathCacheKeyHash> _index;
+    uint32 _maxEntries;
+
+    static std::atomic<uint64> _hits;
+    static std::atomic<uint64> _misses;
+    static std::atomic<uint64> _invalidated;
+    static std::atomic<uint64> _evicted;
+};
+
+#endif
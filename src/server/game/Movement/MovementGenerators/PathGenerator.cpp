@@ -13,13 +13,15 @@
 #include "MMapFactory.h"
 #include "MMapManager.h"
 #include "PathGenerator.h"
+#include "World.h"
 
  ////////////////// PathGenerator //////////////////
 PathGenerator::PathGenerator(WorldObject const* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false), _forceDestination(false),
     _slopeCheck(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _useRaycast(false),
     _endPosition(G3D::Vector3::zero()), _source(owner), _navMesh(nullptr),
-    _navMeshQuery(nullptr)
+    _navMeshQuery(nullptr), _pendingMap(nullptr), _requestedDestination(G3D::Vector3::zero()),
+    _requestedForceDest(false), _pathResult(false), _hasPathResult(false)
 {
     memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
 
@@ -28,7 +30,6 @@ PathGenerator::PathGenerator(WorldObject const* owner) :
     {
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
         _navMesh = mmap->GetNavMesh(mapId);
-        _navMeshQuery = mmap->GetNavMeshQuery(mapId, _source->GetInstanceId());
     }
 
     CreateFilter();
@@ -36,6 +37,51 @@ PathGenerator::PathGenerator(WorldObject const* owner) :
 
 PathGenerator::~PathGenerator()
 {
+    CancelPathRequest();
+}
+
+void PathGenerator::CalculatePathAsync(float destX, float destY, float destZ, bool forceDest)
+{
+    CancelPathRequest();
+    _hasPathResult = false;
+
+    Map* map = _source->FindMap();
+    if (!map || !_source->IsInWorld() || !sWorld->getBoolConfig(CONFIG_MMAPS_BATCHED_PATHS))
+    {
+        _pathResult = CalculatePath(destX, destY, destZ, forceDest);
+        _hasPathResult = true;
+        return;
+    }
+
+    _requestedDestination = G3D::Vector3(destX, destY, destZ);
+    _requestedForceDest = forceDest;
+    _pendingMap = map;
+    map->AddPathRequest(this);
+}
+
+void PathGenerator::CancelPathRequest()
+{
+    if (!_pendingMap)
+        return;
+
+    _pendingMap->RemovePathRequest(this);
+    _pendingMap = nullptr;
+}
+
+void PathGenerator::RunPathRequest()
+{
+    // removed from the world after the request, its generators are going away
+    if (_source->IsInWorld() && _source->FindMap() == _pendingMap)
+        _pathResult = CalculatePath(_requestedDestination.x, _requestedDestination.y, _requestedDestination.z, _requestedForceDest);
+    else
+    {
+        Clear();
+        _type = PATHFIND_NOPATH;
+        _pathResult = false;
+    }
+
+    _hasPathResult = true;
+    _pendingMap = nullptr;
 }
 
 bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool forceDest)
@@ -59,6 +105,9 @@ bool PathGenerator::CalculatePath(float x, float y, float z, float destX, float
 
     _forceDestination = forceDest;
 
+    // queries are per thread, take the one of the thread calculating this path
+    _navMeshQuery = _navMesh ? MMAP::MMapFactory::createOrGetMMapManager()->GetNavMeshQuery(_source->GetMapId()) : nullptr;
+
     // make sure navMesh works - we can run on map w/o mmap
     // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
     Unit const* _sourceUnit = _source->ToUnit();
@@ -242,6 +291,9 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
 
     // *** poly path generating logic ***
 
+    PathCacheKey cacheKey;
+    bool storeInCache = false;
+
     // start and end are on same polygon
     // handle this case as if they were 2 different polygons, building a line path split in some few points
     if (startPoly == endPoly && !_useRaycast)
@@ -384,6 +436,16 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         // free and invalidate old path data
         Clear();
 
+        // the same path may have been calculated recently, by this or another creature of the map
+        if (!_useRaycast && !startFarFromPoly && !endFarFromPoly && _source->GetMap()->GetPathCache().IsEnabled())
+        {
+            cacheKey = MakeCacheKey(startPoly, endPoly, startPos, endPos);
+            if (LoadCachedPath(cacheKey, startPos, endPos))
+                return;
+
+            storeInCache = true;
+        }
+
         dtStatus dtResult;
         if (_useRaycast)
         {
@@ -499,6 +561,99 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
 
     // generate the point-path out of our up-to-date poly-path
     BuildPointPath(startPoint, endPoint);
+
+    if (storeInCache && _type == PATHFIND_NORMAL)
+        StoreCachedPath(cacheKey);
+}
+
+PathCacheKey PathGenerator::MakeCacheKey(dtPolyRef startPoly, dtPolyRef endPoly, G3D::Vector3 const& startPos, G3D::Vector3 const& endPos) const
+{
+    PathCacheKey key;
+    key.startPoly = startPoly;
+    key.endPoly = endPoly;
+    for (uint8 i = 0; i < 3; ++i)
+    {
+        key.startCell[i] = int32(std::floor(startPos[i] / PATH_CACHE_CELL_SIZE));
+        key.endCell[i] = int32(std::floor(endPos[i] / PATH_CACHE_CELL_SIZE));
+    }
+
+    key.includeFlags = _filter.getIncludeFlags();
+    key.excludeFlags = _filter.getExcludeFlags();
+
+    // everything else changing the points, NormalizePath depends on the movement abilities of the source
+    uint16 options = 0;
+    if (_useStraightPath)
+        options |= 0x01;
+    if (_forceDestination)
+        options |= 0x02;
+    if (_slopeCheck)
+        options |= 0x04;
+    Unit const* unit = _source->ToUnit();
+    if (unit)
+    {
+        if (unit->IsHovering())
+            options |= 0x08;
+        if (unit->IsLevitating())
+            options |= 0x10;
+        if (unit->CanFly())
+            options |= 0x20;
+    }
+    if (Creature const* creature = _source->ToCreature())
+    {
+        if (creature->CanSwim())
+            options |= 0x40;
+    }
+    else
+        options |= 0x40;                                    // UpdateAllowedPositionZ lets everything else swim
+    if (_source->GetTransport())
+        options |= 0x80;
+
+    key.options = options;
+    key.pointLimit = uint16(_pointPathLimit);
+
+    // ground and water level are looked up in the phase of the source, gameobjects may block
+    key.phaseMask = _source->GetPhaseMask();
+    key.collisionHeight = _source->GetCollisionHeight();
+    key.minHeightInWater = _source->GetMinHeightInWater();
+    key.hoverHeight = unit ? unit->GetHoverHeight() : 0.0f;
+    return key;
+}
+
+bool PathGenerator::LoadCachedPath(PathCacheKey const& key, G3D::Vector3 const& startPos, G3D::Vector3 const& endPos)
+{
+    PathCacheEntry entry;
+    if (!_source->GetMap()->GetPathCache().Find(key, _navMesh, entry) || entry.points.size() < 2)
+        return false;
+
+    _polyLength = uint32(entry.polys.size());
+    memcpy(_pathPolyRefs, entry.polys.data(), _polyLength * sizeof(dtPolyRef));
+    _pathPoints = std::move(entry.points);
+
+    // the cached path starts and ends in the same cells, move its ends to the requested positions
+    G3D::Vector3& start = _pathPoints.front();
+    start = startPos;
+    _source->UpdateAllowedPositionZ(start.x, start.y, start.z);
+
+    if (InRange(entry.actualEnd, entry.end, 0.5f, 0.5f))
+    {
+        G3D::Vector3& end = _pathPoints.back();
+        end = endPos;
+        _source->UpdateAllowedPositionZ(end.x, end.y, end.z);
+    }
+
+    SetActualEndPosition(_pathPoints.back());
+    _type = PATHFIND_NORMAL;
+    return true;
+}
+
+void PathGenerator::StoreCachedPath(PathCacheKey const& key)
+{
+    PathCacheEntry entry;
+    entry.polys.assign(_pathPolyRefs, _pathPolyRefs + _polyLength);
+    entry.points = _pathPoints;
+    entry.end = GetEndPosition();
+    entry.actualEnd = GetActualEndPosition();
+    _source->GetMap()->GetPathCache().Store(key, std::move(entry));
 }
 
 void PathGenerator::BuildPointPath(const float* startPoint, const float* endPoint)
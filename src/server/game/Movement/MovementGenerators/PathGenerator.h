@@ -12,9 +12,11 @@
 #include "MMapFactory.h"
 #include "MMapManager.h"
 #include "MoveSplineInitArgs.h"
+#include "PathCache.h"
 #include "SharedDefines.h"
 #include <G3D/Vector3.h>
 
+class Map;
 class Unit;
 class WorldObject;
 
@@ -54,6 +56,18 @@ class PathGenerator
         // return: true if new path was calculated, false otherwise (no change needed)
         bool CalculatePath(float destX, float destY, float destZ, bool forceDest = false);
         bool CalculatePath(float x, float y, float z, float destX, float destY, float destZ, bool forceDest);
+
+        // Same as CalculatePath, but the path is calculated at the end of the update of the owner's map, together
+        // with the other requests of the map and on several map update workers. The result is available from the
+        // next update on (HasPathResult). Calculates right away when the owner is not in a map.
+        void CalculatePathAsync(float destX, float destY, float destZ, bool forceDest = false);
+        [[nodiscard]] bool IsPathPending() const { return _pendingMap != nullptr; }
+        [[nodiscard]] bool HasPathResult() const { return _hasPathResult; }
+        // return value of CalculatePath for the last CalculatePathAsync, the path itself is read with the getters below
+        bool TakePathResult() { _hasPathResult = false; return _pathResult; }
+        void CancelPathRequest();
+        void RunPathRequest(); // called by the map, see Map::ProcessPathRequests
+
         [[nodiscard]] bool IsInvalidDestinationZ(Unit const* target) const;
         [[nodiscard]] bool IsWalkableClimb(float const* v1, float const* v2) const;
         [[nodiscard]] bool IsWalkableClimb(float x, float y, float z, float destX, float destY, float destZ) const;
@@ -129,7 +143,13 @@ class PathGenerator
 
         WorldObject const* const _source;       // the object that is moving
         dtNavMesh const* _navMesh;              // the nav mesh
-        dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query used to find the path
+        dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query used to find the path, belongs to the calculating thread
+
+        Map* _pendingMap;                       // map which calculates the requested path
+        G3D::Vector3 _requestedDestination;
+        bool _requestedForceDest;
+        bool _pathResult;
+        bool _hasPathResult;
 
         dtQueryFilterExt _filter;  // use single filter for all movements, update it when needed
 
@@ -153,6 +173,11 @@ class PathGenerator
         bool HaveTile(G3D::Vector3 const& p) const;
 
         void BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos);
+
+        // see PathCache
+        PathCacheKey MakeCacheKey(dtPolyRef startPoly, dtPolyRef endPoly, G3D::Vector3 const& startPos, G3D::Vector3 const& endPos) const;
+        bool LoadCachedPath(PathCacheKey const& key, G3D::Vector3 const& startPos, G3D::Vector3 const& endPos);
+        void StoreCachedPath(PathCacheKey const& key);
         void BuildPointPath(float const* startPoint, float const* endPoint);
         void BuildShortcut();
 
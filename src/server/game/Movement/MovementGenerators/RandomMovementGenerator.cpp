@@ -36,8 +36,14 @@ void RandomMovementGenerator<Creature>::_setRandomLocation(Creature* creature)
         return;
     }
 
-    uint8 random = urand(0, _validPointsVector[_currentPoint].size() - 1);
-    std::vector<uint8>::iterator randomIter = _validPointsVector[_currentPoint].begin() + random;
+    // keep the point whose path is being calculated
+    std::vector<uint8>::iterator randomIter = std::find(_validPointsVector[_currentPoint].begin(), _validPointsVector[_currentPoint].end(), _pendingPoint);
+    if (randomIter == _validPointsVector[_currentPoint].end())
+    {
+        _pendingPoint = RANDOM_POINTS_NUMBER;
+        uint8 random = urand(0, _validPointsVector[_currentPoint].size() - 1);
+        randomIter = _validPointsVector[_currentPoint].begin() + random;
+    }
     uint8 newPoint = *randomIter;
     uint16 pathIdx = uint16(_currentPoint * RANDOM_POINTS_NUMBER + newPoint);
 
@@ -112,7 +118,18 @@ void RandomMovementGenerator<Creature>::_setRandomLocation(Creature* creature)
         }
         else // ground
         {
-            bool result = _pathGenerator->CalculatePath(x, y, levelZ, false);
+            // the path is calculated at the end of the map update, try again with the next update
+            if (_pendingPoint != newPoint || (!_pathGenerator->IsPathPending() && !_pathGenerator->HasPathResult()))
+            {
+                _pendingPoint = newPoint;
+                _pathGenerator->CalculatePathAsync(x, y, levelZ, false);
+            }
+
+            if (_pathGenerator->IsPathPending())
+                return;
+
+            _pendingPoint = RANDOM_POINTS_NUMBER;
+            bool result = _pathGenerator->TakePathResult();
             if (result && !(_pathGenerator->GetPathType() & PATHFIND_NOPATH))
             {
                 // generated path is too long
@@ -196,6 +213,11 @@ void RandomMovementGenerator<Creature>::_setRandomLocation(Creature* creature)
 template<>
 void RandomMovementGenerator<Creature>::DoInitialize(Creature* creature)
 {
+    // the creature may have moved meanwhile, drop a path calculated from its old position
+    if (_pathGenerator)
+        _pathGenerator->CancelPathRequest();
+    _pendingPoint = RANDOM_POINTS_NUMBER;
+
     if (!creature->IsAlive())
         return;
 
@@ -18,7 +18,7 @@ template<class T>
 class RandomMovementGenerator : public MovementGeneratorMedium< T, RandomMovementGenerator<T> >
 {
 public:
-    RandomMovementGenerator(float wanderDistance = 0.0f) : _nextMoveTime(0), _moveCount(0), _wanderDistance(wanderDistance), _pathGenerator(nullptr), _currentPoint(RANDOM_POINTS_NUMBER)
+    RandomMovementGenerator(float wanderDistance = 0.0f) : _nextMoveTime(0), _moveCount(0), _wanderDistance(wanderDistance), _pathGenerator(nullptr), _currentPoint(RANDOM_POINTS_NUMBER), _pendingPoint(RANDOM_POINTS_NUMBER)
     {
         _initialPosition.Relocate(0.0f, 0.0f, 0.0f, 0.0f);
         _destinationPoints.reserve(RANDOM_POINTS_NUMBER);
@@ -35,6 +35,8 @@ public:
             _validPointsVector[RANDOM_POINTS_NUMBER].push_back(i);
     }
 
+    ~RandomMovementGenerator() { delete _pathGenerator; }
+
     void _setRandomLocation(T*);
     void DoInitialize(T*);
     void DoFinalize(T*);
@@ -51,6 +53,7 @@ private:
     std::vector<G3D::Vector3> _destinationPoints;
     std::vector<uint8> _validPointsVector[RANDOM_POINTS_NUMBER + 1];
     uint8 _currentPoint;
+    uint8 _pendingPoint; // path to it requested from the map's path batch
     std::map<uint16, Movement::PointsArray> _preComputedPaths;
     Position _initialPosition, _currDestPosition;
 };
@@ -48,6 +48,7 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
     // the owner might be unable to move (rooted or casting), or we have lost the target, pause movement
     if (owner->HasUnitState(UNIT_STATE_NOT_MOVE) || HasLostTarget(owner) || (cOwner && cOwner->IsMovementPreventedByCasting()))
     {
+        i_path = nullptr;
         owner->StopMoving();
         _lastTargetPosition.reset();
         if (Creature* cOwner = owner->ToCreature())
@@ -94,6 +95,16 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
         }
     }
 
+    // the path requested by an earlier update is calculated with the map's path batch
+    if (i_path && i_path->IsPathPending())
+        return true;
+
+    if (i_path && i_path->HasPathResult())
+    {
+        LaunchPath(owner, target, maxTarget);
+        return true;
+    }
+
     if (owner->HasUnitState(UNIT_STATE_CHASE_MOVE) && owner->movespline->Finalized())
     {
         i_recalculateTravel = false;
@@ -130,7 +141,7 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
     }
 
     if (!i_path || moveToward != _movingTowards)
-        i_path = new PathGenerator(owner);
+        i_path = std::make_unique<PathGenerator>(owner);
 
     float x, y, z;
     bool shortenPath;
@@ -151,16 +162,29 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
     if (owner->IsHovering())
         owner->UpdateAllowedPositionZ(x, y, z);
 
-    bool success = i_path->CalculatePath(x, y, z, forceDest);
+    _shortenPath = shortenPath;
+    i_path->CalculatePathAsync(x, y, z, forceDest);
+    if (!i_path->IsPathPending())
+        LaunchPath(owner, target, maxTarget);
+
+    return true;
+}
+
+template<class T>
+void ChaseMovementGenerator<T>::LaunchPath(T* owner, Unit* target, float maxTarget)
+{
+    Creature* cOwner = owner->ToCreature();
+
+    bool success = i_path->TakePathResult();
     if (!success || i_path->GetPathType() & PATHFIND_NOPATH)
     {
         if (cOwner)
             cOwner->SetCannotReachTarget(true);
         owner->StopMoving();
-        return true;
+        return;
     }
 
-    if (shortenPath)
+    if (_shortenPath)
         i_path->ShortenPathUntilDist(G3D::Vector3(target->GetPositionX(), target->GetPositionY(), target->GetPositionZ()), maxTarget);
 
     if (cOwner)
@@ -180,14 +204,13 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
     init.SetFacing(target);
     init.SetWalk(walk);
     init.Launch();
-
-    return true;
 }
 
 //-----------------------------------------------//
 template<>
 void ChaseMovementGenerator<Player>::DoInitialize(Player* owner)
 {
+    i_path = nullptr;
     _lastTargetPosition.reset();
     owner->AddUnitState(UNIT_STATE_CHASE);
 }
@@ -195,6 +218,7 @@ void ChaseMovementGenerator<Player>::DoInitialize(Player* owner)
 template<>
 void ChaseMovementGenerator<Creature>::DoInitialize(Creature* owner)
 {
+    i_path = nullptr;
     _lastTargetPosition.reset();
     owner->SetWalk(false);
     owner->AddUnitState(UNIT_STATE_CHASE);
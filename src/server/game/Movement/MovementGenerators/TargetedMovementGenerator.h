@@ -12,6 +12,7 @@
 #include "PathGenerator.h"
 #include "Timer.h"
 #include "Unit.h"
+#include <memory>
 #include <optional>
 
 class TargetedMovementGeneratorBase
@@ -28,7 +29,7 @@ class ChaseMovementGenerator : public MovementGeneratorMedium<T, ChaseMovementGe
 {
 public:
     ChaseMovementGenerator(Unit* target, std::optional<ChaseRange> range = {}, std::optional<ChaseAngle> angle = {})
-        : TargetedMovementGeneratorBase(target), i_path(nullptr), i_recheckDistance(0), i_recalculateTravel(true), _range(range), _angle(angle) {}
+        : TargetedMovementGeneratorBase(target), i_recheckDistance(0), i_recalculateTravel(true), _range(range), _angle(angle) {}
     ~ChaseMovementGenerator() {}
 
     MovementGeneratorType GetMovementGeneratorType() { return CHASE_MOTION_TYPE; }
@@ -48,7 +49,9 @@ public:
     bool HasLostTarget(Unit* unit) const { return unit->GetVictim() != this->GetTarget(); }
 
 private:
-    PathGenerator* i_path;
+    void LaunchPath(T* owner, Unit* target, float maxTarget);
+
+    std::unique_ptr<PathGenerator> i_path; // destroying it cancels a pending path request
     TimeTrackerSmall i_recheckDistance;
     bool i_recalculateTravel;
 
@@ -57,6 +60,7 @@ private:
     std::optional<ChaseAngle> const _angle;
     bool _movingTowards = true;
     bool _mutualChase = true;
+    bool _shortenPath = false; // of the requested path
 };
 
 template<class T>
@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "SharedPacket.h"
+#include <ace/Message_Block.h>
+
+namespace
+{
+    // does not own the data, keeps the payload alive until the socket releases the block
+    class SharedPayloadBlock : public ACE_Message_Block
+    {
+    public:
+        explicit SharedPayloadBlock(std::shared_ptr<WorldPacket const> payload)
+            : ACE_Message_Block(reinterpret_cast<char const*>(payload->contents()), payload->size()), _payload(std::move(payload))
+        {
+            wr_ptr(_payload->size());
+        }
+
+    private:
+        std::shared_ptr<WorldPacket const> _payload;
+    };
+}
+
+ACE_Message_Block* SharedPacket::CreatePayloadBlock()
+{
+    if (!_payload)
+        _payload = std::make_shared<WorldPacket const>(*_packet);
+
+    return new SharedPayloadBlock(_payload);
+}
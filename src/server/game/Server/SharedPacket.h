@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _SHAREDPACKET_H
+#define _SHAREDPACKET_H
+
+#include "WorldPacket.h"
+#include <memory>
+
+class ACE_Message_Block;
+
+/*
+ * A packet sent to many sessions (MessageDistDeliverer, group/map/world broadcasts).
+ * The payload is copied once, by the first socket that takes it by reference, and the
+ * output queues of all sockets refer to that copy. The header is still written and
+ * encrypted per socket. Small payloads are copied as usual, see WorldSocket::SendPacket.
+ * Not thread safe, a SharedPacket lives on the stack of the broadcasting thread.
+ */
+class SharedPacket
+{
+public:
+    explicit SharedPacket(WorldPacket const* packet) : _packet(packet) { }
+
+    WorldPacket const* GetPacket() const { return _packet; }
+
+    /// New block referring to the shared payload, released by the socket once sent.
+    ACE_Message_Block* CreatePayloadBlock();
+
+private:
+    WorldPacket const* _packet;
+    std::shared_ptr<WorldPacket const> _payload;
+};
+
+#endif
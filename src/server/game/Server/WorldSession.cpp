@@ -26,6 +26,7 @@
 #include "Player.h"
 #include "SavingSystem.h"
 #include "ScriptMgr.h"
+#include "SharedPacket.h"
 #include "SocialMgr.h"
 #include "Transport.h"
 #include "Vehicle.h"
@@ -160,11 +161,6 @@ WorldSession::~WorldSession()
         _warden = nullptr;
     }
 
-    ///- empty incoming packet queue
-    WorldPacket* packet = nullptr;
-    while (_recvQueue.next(packet))
-        delete packet;
-
     if (GetShouldSetOfflineInDB())
         LoginDatabase.PExecute("UPDATE account SET online = 0 WHERE id = %u;", GetAccountId());     // One-time query
 }
@@ -193,6 +189,17 @@ uint32 WorldSession::GetGuidLow() const
 
 /// Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const* packet)
+{
+    SendPacket(packet, nullptr);
+}
+
+/// Send a packet that goes to many clients
+void WorldSession::SendPacket(SharedPacket& packet)
+{
+    SendPacket(packet.GetPacket(), &packet);
+}
+
+void WorldSession::SendPacket(WorldPacket const* packet, SharedPacket* shared)
 {
     if (!m_Socket)
         return;
@@ -240,14 +247,14 @@ void WorldSession::SendPacket(WorldPacket const* packet)
         return;
 #endif
 
-    if (m_Socket->SendPacket(*packet) == -1)
+    if (m_Socket->SendPacket(*packet, shared) == -1)
         m_Socket->CloseSocket("m_Socket->SendPacket(*packet) == -1");
 }
 
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
-    _recvQueue.add(new_packet);
+    _recvQueue.Enqueue(new_packet);
 }
 
 /// Update the WorldSession (triggered by World update)
@@ -273,8 +280,11 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     uint32 processedPackets = 0;
     time_t currentTime = time(nullptr);
 
-    while (m_Socket && !m_Socket->IsClosed() && !_recvQueue.empty() && _recvQueue.peek(true) != firstDelayedPacket && _recvQueue.next(packet, updater))
+    // packets the filter doesn't accept stay at the front, the other update of this session takes them
+    while (m_Socket && !m_Socket->IsClosed() && (packet = _recvQueue.Peek()) && packet != firstDelayedPacket && updater.Process(packet))
     {
+        _recvQueue.Dequeue(packet);
+
         if (packet->GetOpcode() >= NUM_MSG_TYPES)
         {
             sLog->outError("WorldSession Packet filter: received non-existent opcode %s (0x%.4X)", LookupOpcodeName(packet->GetOpcode()), packet->GetOpcode());
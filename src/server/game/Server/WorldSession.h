@@ -18,6 +18,7 @@
 #include "Common.h"
 #include "DatabaseEnv.h"
 #include "GossipDef.h"
+#include "MPSCQueue.h"
 #include "Opcodes.h"
 #include "SharedDefines.h"
 #include "World.h"
@@ -37,6 +38,7 @@ class Quest;
 class SpellCastTargets;
 class Unit;
 class Warden;
+class SharedPacket;
 class WorldPacket;
 class WorldSocket;
 class AsynchPetSummon;
@@ -209,6 +211,7 @@ public:
     void WriteMovementInfo(WorldPacket* data, MovementInfo* mi);
 
     void SendPacket(WorldPacket const* packet);
+    void SendPacket(SharedPacket& packet);              // broadcasts, payload shared by the sockets
     void SendNotification(const char* format, ...) ATTR_PRINTF(2, 3);
     void SendNotification(uint32 string_id, ...);
     void SendPetNameInvalid(uint32 error, std::string const& name, DeclinedName* declinedName);
@@ -986,6 +989,8 @@ public:
     END OF CALLBACKS
     ***/
 private:
+    void SendPacket(WorldPacket const* packet, SharedPacket* shared);
+
     // private trade methods
     void moveItems(Item* myItems[], Item* hisItems[]);
 
@@ -1035,7 +1040,7 @@ private:
     AddonsList m_addonsList;
     uint32 recruiterId;
     bool isRecruiter;
-    ACE_Based::LockedQueue<WorldPacket*, ACE_Thread_Mutex> _recvQueue;
+    MPSCQueue<WorldPacket, &WorldPacket::QueueLink> _recvQueue; // filled by the network thread, drained by whoever runs Update()
     uint32 m_currentVendorEntry;
     uint64 m_currentBankerGUID;
     time_t timeWhoCommandAllowed;
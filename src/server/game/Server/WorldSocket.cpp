@@ -17,6 +17,7 @@
 #include "Player.h"
 #include "ScriptMgr.h"
 #include "SharedDefines.h"
+#include "SharedPacket.h"
 #include "Util.h"
 #include "World.h"
 #include "WorldPacket.h"
@@ -30,6 +31,7 @@
 #include <ace/os_include/sys/os_types.h>
 #include <ace/OS_NS_string.h>
 #include <ace/OS_NS_unistd.h>
+#include <ace/OS_NS_sys_socket.h>
 #include <ace/Reactor.h>
 #include <thread>
 
@@ -90,17 +92,27 @@ struct ClientPktHeader
 #pragma pack(pop)
 #endif
 
+// max blocks passed to one sendmsg() call, IOV_MAX is 1024 on linux
+#define WORLDSOCKET_MAX_IOV 64
+
+// smaller payloads of shared packets are copied, cheaper than queueing a block for them
+#define WORLDSOCKET_SHARED_PAYLOAD_MIN_SIZE 256
+
+// queued blocks are at least this big, packets sent while the queue is in use are appended to them
+#define WORLDSOCKET_QUEUE_BLOCK_SIZE 4096
+
 WorldSocket::WorldSocket(void): WorldHandler(),
     m_LastPingTime(SystemTimePoint::min()), m_OverSpeedPings(0), m_Session(0),
     m_RecvWPct(0), m_RecvPct(), m_Header(sizeof (ClientPktHeader)),
-    m_OutBuffer(0), m_OutBufferSize(65536), m_OutActive(false)
+    m_OutBuffer(0), m_OutBufferSize(65536), m_OutActive(false),
+    m_ImmediateFlush(false), m_FlushPending(false)
 {
     acore::Crypto::GetRandomBytes(m_Seed);
 
     reference_counting_policy().value (ACE_Event_Handler::Reference_Counting_Policy::ENABLED);
 
-    msg_queue()->high_water_mark(8 * 1024 * 1024);
-    msg_queue()->low_water_mark(8 * 1024 * 1024);
+    msg_queue()->high_water_mark(QueueWaterMark);
+    msg_queue()->low_water_mark(QueueWaterMark);
 }
 
 WorldSocket::~WorldSocket(void)
@@ -147,7 +159,7 @@ const std::string& WorldSocket::GetRemoteAddress(void) const
     return m_Address;
 }
 
-int WorldSocket::SendPacket(WorldPacket const& pct)
+int WorldSocket::SendPacket(WorldPacket const& pct, SharedPacket* shared)
 {
     ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
 
@@ -163,27 +175,63 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
     if (m_Crypt.IsInitialized())
         m_Crypt.EncryptSend((uint8*)header.header, header.getHeaderLength());
 
-    if (m_OutBuffer->space() >= pct.size() + header.getHeaderLength() && msg_queue()->is_empty())
+    // first packet since the last flush, don't wait for the Update() celling
+    if (m_ImmediateFlush && !m_OutActive && !m_FlushPending && m_OutBuffer->length() == 0 && msg_queue()->is_empty())
     {
-        // Put the packet on the buffer.
-        if (m_OutBuffer->copy((char*) header.header, header.getHeaderLength()) == -1)
+        // zero timeout, if the notification pipe is full Update() flushes it
+        if (reactor()->notify(this, ACE_Event_Handler::WRITE_MASK, (ACE_Time_Value*)&ACE_Time_Value::zero) != -1)
+            m_FlushPending = true;
+    }
+
+    // big broadcast payloads are queued by reference, only the header is copied
+    bool sharePayload = shared && pct.size() >= WORLDSOCKET_SHARED_PAYLOAD_MIN_SIZE;
+    size_t copySize = header.getHeaderLength() + (sharePayload || pct.empty() ? 0 : pct.size());
+
+    auto copyPacket = [&](ACE_Message_Block* mb)
+    {
+        if (mb->copy((char*) header.header, header.getHeaderLength()) == -1)
             ABORT();
 
-        if (!pct.empty())
-            if (m_OutBuffer->copy((char*) pct.contents(), pct.size()) == -1)
+        if (!sharePayload && !pct.empty())
+            if (mb->copy((char*) pct.contents(), pct.size()) == -1)
                 ABORT();
+    };
+
+    if (m_OutBuffer->space() >= copySize && msg_queue()->is_empty())
+    {
+        // Put the packet on the buffer.
+        copyPacket(m_OutBuffer);
     }
     else
     {
-        // Enqueue the packet.
-        ACE_Message_Block* mb;
+        // Append the packet to the last queued block if it has room (never the case for shared payloads)
+        ACE_Message_Block* mb = nullptr;
+        ACE_Message_Queue_Reverse_Iterator<ACE_NULL_SYNCH> itr(*msg_queue());
+
+        if (itr.next(mb) && mb->space() >= copySize)
+        {
+            copyPacket(mb);
+            msg_queue()->message_length(msg_queue()->message_length() + copySize);
+        }
+        else
+        {
+            // Enqueue the packet.
+            ACE_NEW_RETURN(mb, ACE_Message_Block(GetQueueBlockSize(copySize, sharePayload)), -1);
 
-        ACE_NEW_RETURN(mb, ACE_Message_Block(pct.size() + header.getHeaderLength()), -1);
+            copyPacket(mb);
 
-        mb->copy((char*) header.header, header.getHeaderLength());
+            if (msg_queue()->enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+            {
+                sLog->outError("WorldSocket::SendPacket enqueue_tail failed");
+                mb->release();
+                return -1;
+            }
+        }
+    }
 
-        if (!pct.empty())
-            mb->copy((const char*)pct.contents(), pct.size());
+    if (sharePayload)
+    {
+        ACE_Message_Block* mb = shared->CreatePayloadBlock();
 
         if (msg_queue()->enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
         {
@@ -196,6 +244,16 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
     return 0;
 }
 
+size_t WorldSocket::GetQueueBlockSize(size_t copySize, bool sharedPayload)
+{
+    // the queue counts the size of its blocks against the water mark, not the bytes in them,
+    // a header in a 4K block would charge 4K for every shared packet
+    if (sharedPayload)
+        return copySize;
+
+    return std::max<size_t>(copySize, WORLDSOCKET_QUEUE_BLOCK_SIZE);
+}
+
 long WorldSocket::AddReference(void)
 {
     return static_cast<long> (add_reference());
@@ -316,104 +374,101 @@ int WorldSocket::handle_output(ACE_HANDLE)
     if (closing_)
         return -1;
 
-    size_t send_len = m_OutBuffer->length();
+    m_FlushPending = false;
+
+    while (true)
+    {
+        // the buffer is only written while the queue is empty, so its data always goes first
+        iovec iov[WORLDSOCKET_MAX_IOV];
+        int iovcnt = 0;
+        size_t send_len = 0;
+
+        if (m_OutBuffer->length())
+        {
+            iov[iovcnt].iov_base = m_OutBuffer->rd_ptr();
+            iov[iovcnt].iov_len = m_OutBuffer->length();
+            send_len += iov[iovcnt++].iov_len;
+        }
+
+        ACE_Message_Queue_Iterator<ACE_NULL_SYNCH> itr(*msg_queue());
+        for (ACE_Message_Block* mblk; iovcnt < WORLDSOCKET_MAX_IOV && itr.next(mblk); itr.advance())
+        {
+            iov[iovcnt].iov_base = mblk->rd_ptr();
+            iov[iovcnt].iov_len = mblk->length();
+            send_len += iov[iovcnt++].iov_len;
+        }
+
+        if (send_len == 0)
+            return cancel_wakeup_output(Guard);
 
-    if (send_len == 0)
-        return handle_output_queue(Guard);
+        msghdr msg;
+        ACE_OS::memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = iovcnt;
 
 #ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send (m_OutBuffer->rd_ptr(), send_len, MSG_NOSIGNAL);
+        ssize_t n = ACE_OS::sendmsg(get_handle(), &msg, MSG_NOSIGNAL);
 #else
-    ssize_t n = peer().send (m_OutBuffer->rd_ptr(), send_len);
+        ssize_t n = ACE_OS::sendmsg(get_handle(), &msg, 0);
 #endif // MSG_NOSIGNAL
 
-    if (n == 0)
-        return -1;
-    else if (n == -1)
-    {
-        if (errno == EWOULDBLOCK || errno == EAGAIN)
-            return schedule_wakeup_output (Guard);
+        if (n == 0)
+            return -1;
+        else if (n == -1)
+        {
+            if (errno == EWOULDBLOCK || errno == EAGAIN)
+                return schedule_wakeup_output (Guard);
 
-        return -1;
-    }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        m_OutBuffer->rd_ptr (static_cast<size_t> (n));
+            return -1;
+        }
 
-        // move the data to the base of the buffer
-        m_OutBuffer->crunch();
+        consume_output(static_cast<size_t> (n));
 
-        return schedule_wakeup_output (Guard);
-    }
-    else //now n == send_len
-    {
-        m_OutBuffer->reset();
+        // kernel buffer is full, wait for the reactor
+        if (n < (ssize_t)send_len)
+            return schedule_wakeup_output (Guard);
 
-        return handle_output_queue (Guard);
+        // everything gathered was sent, there may be more in the queue
     }
 
     ACE_NOTREACHED (return 0);
 }
 
-int WorldSocket::handle_output_queue(GuardType& g)
+void WorldSocket::consume_output(size_t n)
 {
-    if (msg_queue()->is_empty())
-        return cancel_wakeup_output(g);
-
-    ACE_Message_Block* mblk;
-
-    if (msg_queue()->dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
-    {
-        sLog->outError("WorldSocket::handle_output_queue dequeue_head");
-        return -1;
-    }
-
-    const size_t send_len = mblk->length();
-
-#ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send(mblk->rd_ptr(), send_len, MSG_NOSIGNAL);
-#else
-    ssize_t n = peer().send(mblk->rd_ptr(), send_len);
-#endif // MSG_NOSIGNAL
-
-    if (n == 0)
+    if (size_t len = m_OutBuffer->length())
     {
-        mblk->release();
-
-        return -1;
-    }
-    else if (n == -1)
-    {
-        if (errno == EWOULDBLOCK || errno == EAGAIN)
+        if (n < len)
         {
-            msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero);
-            return schedule_wakeup_output (g);
+            m_OutBuffer->rd_ptr(n);
+
+            // move the data to the base of the buffer
+            m_OutBuffer->crunch();
+            return;
         }
 
-        mblk->release();
-        return -1;
+        m_OutBuffer->reset();
+        n -= len;
     }
-    else if (n < (ssize_t)send_len) //now n > 0
+
+    while (n > 0)
     {
-        mblk->rd_ptr(static_cast<size_t> (n));
+        ACE_Message_Block* mblk;
+        if (msg_queue()->peek_dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+            return;
 
-        if (msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero) == -1)
+        if (n < mblk->length())
         {
-            sLog->outError("WorldSocket::handle_output_queue enqueue_head");
-            mblk->release();
-            return -1;
+            mblk->rd_ptr(n);
+            msg_queue()->message_length(msg_queue()->message_length() - n);
+            return;
         }
 
-        return schedule_wakeup_output (g);
-    }
-    else //now n == send_len
-    {
-        mblk->release();
+        n -= mblk->length();
 
-        return msg_queue()->is_empty() ? cancel_wakeup_output(g) : ACE_Event_Handler::WRITE_MASK;
+        msg_queue()->dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero);
+        mblk->release();
     }
-
-    ACE_NOTREACHED(return -1);
 }
 
 int WorldSocket::handle_close(ACE_HANDLE h, ACE_Reactor_Mask)
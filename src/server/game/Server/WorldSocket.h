@@ -28,6 +28,7 @@
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
 class ACE_Message_Block;
+class SharedPacket;
 class WorldPacket;
 class WorldSession;
 
@@ -54,6 +55,17 @@ typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
  * uses 200ms celling. As result overhead generated by
  * sending packets from "producer" threads is minimal,
  * and doing a lot of writes with small size is tolerated.
+ * With Network.ImmediateFlush the first packet written to
+ * an idle socket posts a notification to the reactor
+ * instead, packets written until it is handled go out
+ * with it.
+ *
+ * The output buffer and the queued packets are written
+ * with one gathering sendmsg() call (up to
+ * WORLDSOCKET_MAX_IOV blocks), so a deep queue doesn't
+ * cost a syscall per packet. Payloads of broadcast
+ * packets (SharedPacket) are queued as blocks shared by
+ * all receiving sockets instead of being copied.
  *
  * The calls to Update() method are managed by WorldSocketMgr
  * and ReactorRunnable.
@@ -93,8 +105,17 @@ public:
 
     /// Send A packet on the socket, this function is reentrant.
     /// @param pct packet to send
+    /// @param shared set when pct is broadcast, its payload may be queued by reference
     /// @return -1 of failure
-    int SendPacket(const WorldPacket& pct);
+    int SendPacket(const WorldPacket& pct, SharedPacket* shared = nullptr);
+
+    /// Output queue limit in bytes of the queued blocks, SendPacket fails once it is reached.
+    static constexpr size_t QueueWaterMark = 8 * 1024 * 1024;
+
+    /// Size of the block a packet is queued in when it does not fit the output buffer.
+    /// @param copySize header and, unless the payload is shared, payload length
+    /// @param sharedPayload the payload is queued in its own block, this one only holds the header
+    static size_t GetQueueBlockSize(size_t copySize, bool sharedPayload);
 
     /// Add reference to this object.
     long AddReference (void);
@@ -134,8 +155,8 @@ private:
     int cancel_wakeup_output (GuardType& g);
     int schedule_wakeup_output (GuardType& g);
 
-    /// Drain the queue if its not empty.
-    int handle_output_queue (GuardType& g);
+    /// Consume n sent bytes from the output buffer and the queue.
+    void consume_output (size_t n);
 
     /// process one incoming packet.
     /// @param new_pct received packet, note that you need to delete it.
@@ -189,6 +210,12 @@ private:
     /// True if the socket is registered with the reactor for output
     bool m_OutActive;
 
+    /// Flush on a reactor notification instead of waiting for Update()
+    bool m_ImmediateFlush;
+
+    /// True if a flush notification is posted and not handled yet
+    bool m_FlushPending;
+
     std::array<uint8, 4> m_Seed;
 };
 
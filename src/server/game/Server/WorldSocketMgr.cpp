@@ -203,6 +203,7 @@ WorldSocketMgr::WorldSocketMgr() :
     m_SockOutKBuff(-1),
     m_SockOutUBuff(65536),
     m_UseNoDelay(true),
+    m_ImmediateFlush(false),
     m_Acceptor (0)
 {
 }
@@ -224,6 +225,8 @@ WorldSocketMgr::StartReactiveIO (uint16 port, const char* address)
 {
     m_UseNoDelay = sConfigMgr->GetOption<bool> ("Network.TcpNodelay", true);
 
+    m_ImmediateFlush = sConfigMgr->GetOption<bool> ("Network.ImmediateFlush", false);
+
     int num_threads = sConfigMgr->GetOption<int32> ("Network.Threads", 1);
 
     if (num_threads <= 0)
@@ -340,6 +343,7 @@ WorldSocketMgr::OnSocketOpen (WorldSocket* sock)
     }
 
     sock->m_OutBufferSize = static_cast<size_t> (m_SockOutUBuff);
+    sock->m_ImmediateFlush = m_ImmediateFlush;
 
     // we skip the Acceptor Thread
     size_t min = 1;
@@ -52,6 +52,7 @@ private:
     int m_SockOutKBuff;
     int m_SockOutUBuff;
     bool m_UseNoDelay;
+    bool m_ImmediateFlush;
 
     class WorldSocketAcceptor* m_Acceptor;
 };
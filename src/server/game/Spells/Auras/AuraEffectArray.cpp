@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "AuraEffectArray.h"
+#include "Errors.h"
+#include "SpellAuraEffects.h"
+#include "Util.h"
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+AuraEffectArray::AuraEffectArray(AuraEffectArray const& right) : AuraEffectArray()
+{
+    // copies only hold the effects still applied
+    Reserve(right._live);
+    for (uint32 i = 0; i < right._size; ++i)
+        if (!right._entries[i].removed)
+            _entries[_size++] = right._entries[i];
+
+    _live = _size;
+}
+
+AuraEffectArray::AuraEffectArray(AuraEffectArray&& right) noexcept : _entries(right._entries), _size(right._size), _capacity(right._capacity),
+    _live(right._live), _totalsValid(right._totalsValid), _totals(right._totals)
+{
+    right._entries = nullptr;
+    right._size = 0;
+    right._capacity = 0;
+    right._live = 0;
+    right._totalsValid = false;
+}
+
+AuraEffectArray& AuraEffectArray::operator=(AuraEffectArray right) noexcept
+{
+    std::swap(_entries, right._entries);
+    std::swap(_size, right._size);
+    std::swap(_capacity, right._capacity);
+    std::swap(_live, right._live);
+    std::swap(_totalsValid, right._totalsValid);
+    std::swap(_totals, right._totals);
+    return *this;
+}
+
+AuraEffectArray::const_iterator AuraEffectArray::begin() const
+{
+    uint32 index = 0;
+    while (index < _size && _entries[index].removed)
+        ++index;
+
+    return const_iterator(this, index);
+}
+
+void AuraEffectArray::push_back(AuraEffect* effect)
+{
+    if (_size == _capacity)
+    {
+        ASSERT(_capacity < std::numeric_limits<uint16>::max());
+        Reserve(_capacity ? std::min<uint32>(_capacity * 2, std::numeric_limits<uint16>::max()) : 4);
+    }
+
+    _entries[_size].effect = effect;
+    _entries[_size].removed = false;
+    ++_size;
+    ++_live;
+    _totalsValid = false;
+}
+
+void AuraEffectArray::remove(AuraEffect* effect)
+{
+    for (uint32 i = 0; i < _size; ++i)
+    {
+        if (_entries[i].removed || _entries[i].effect != effect)
+            continue;
+
+        _entries[i].removed = true;
+        --_live;
+        _totalsValid = false;
+    }
+}
+
+void AuraEffectArray::clear()
+{
+    for (uint32 i = 0; i < _size; ++i)
+        _entries[i].removed = true;
+
+    _live = 0;
+    _totalsValid = false;
+}
+
+void AuraEffectArray::Compact()
+{
+    if (!HasRemoved())
+        return;
+
+    Entry* last = std::remove_if(_entries, _entries + _size, [](Entry const& entry) { return entry.removed; });
+    _size = uint16(last - _entries);
+}
+
+void AuraEffectArray::Reserve(uint32 capacity)
+{
+    if (capacity <= _capacity)
+        return;
+
+    ASSERT(capacity <= std::numeric_limits<uint16>::max());
+
+    Entry* entries = new Entry[capacity];
+    std::copy(_entries, _entries + _size, entries);
+    delete[] _entries;
+
+    _entries = entries;
+    _capacity = uint16(capacity);
+}
+
+AuraEffectTotals const& AuraEffectArray::GetTotals() const
+{
+    if (_totalsValid)
+        return _totals;
+
+    _totals.modifier = 0;
+    _totals.multiplier = 1.0f;
+    _totals.maxPositive = 0;
+    _totals.maxNegative = 0;
+
+    // same order as the separate loops this replaces, the multiplier depends on it
+    for (uint32 i = 0; i < _size; ++i)
+    {
+        if (_entries[i].removed)
+            continue;
+
+        int32 amount = _entries[i].effect->GetAmount();
+        _totals.modifier += amount;
+        AddPct(_totals.multiplier, amount);
+        if (amount > _totals.maxPositive)
+            _totals.maxPositive = amount;
+        if (amount < _totals.maxNegative)
+            _totals.maxNegative = amount;
+    }
+
+    _totalsValid = true;
+    return _totals;
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef ACORE_AURAEFFECTARRAY_H
+#define ACORE_AURAEFFECTARRAY_H
+
+#include "Define.h"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+class AuraEffect;
+
+// sums of the amounts of all effects of one aura type, see AuraEffectArray::GetTotals
+struct AuraEffectTotals
+{
+    int32 modifier;     // Unit::GetTotalAuraModifier
+    float multiplier;   // Unit::GetTotalAuraMultiplier
+    int32 maxPositive;  // Unit::GetMaxPositiveAuraModifier
+    int32 maxNegative;  // Unit::GetMaxNegativeAuraModifier
+};
+
+/*
+ * Aura effects of one aura type applied to a unit (Unit::AuraEffectList), stored contiguously in apply order.
+ *
+ * Like the std::list it replaces, it may be modified while it is iterated (effect handlers and procs
+ * apply and remove auras all the time): iterators are indexes, so appended effects are still visited and
+ * removed effects are only marked and skipped. Marked slots are dropped by Compact(), which the owning
+ * unit calls when no iteration can be in progress (start of Unit::Update).
+ *
+ * The totals of the amounts are computed on demand and kept until an effect is added or removed,
+ * or the amount of a contained effect changes (AuraEffect calls Unit::_InvalidateAuraEffectTotals).
+ */
+class AuraEffectArray
+{
+    struct Entry
+    {
+        AuraEffect* effect;
+        bool removed;
+    };
+
+public:
+    class const_iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef AuraEffect* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef AuraEffect* const* pointer;
+        typedef AuraEffect* const& reference;
+
+        const_iterator() : _array(nullptr), _index(0) { }
+
+        // still the effect it was pointing to if it got removed meanwhile, the aura itself is deleted later
+        reference operator*() const { return _array->_entries[_index].effect; }
+        pointer operator->() const { return &_array->_entries[_index].effect; }
+
+        const_iterator& operator++()
+        {
+            do
+                ++_index;
+            while (_index < _array->_size && _array->_entries[_index].removed);
+            return *this;
+        }
+
+        const_iterator& operator--()
+        {
+            do
+                --_index;
+            while (_index > 0 && _array->_entries[_index].removed);
+            return *this;
+        }
+
+        const_iterator operator++(int) { const_iterator itr = *this; ++(*this); return itr; }
+        const_iterator operator--(int) { const_iterator itr = *this; --(*this); return itr; }
+
+        bool operator==(const_iterator const& right) const { return _index == right._index; }
+        bool operator!=(const_iterator const& right) const { return _index != right._index; }
+
+    private:
+        friend class AuraEffectArray;
+        const_iterator(AuraEffectArray const* array, uint32 index) : _array(array), _index(index) { }
+
+        AuraEffectArray const* _array;
+        uint32 _index;
+    };
+
+    typedef const_iterator iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef const_reverse_iterator reverse_iterator;
+    typedef AuraEffect* value_type;
+    typedef std::size_t size_type;
+
+    AuraEffectArray() : _entries(nullptr), _size(0), _capacity(0), _live(0), _totalsValid(false) { }
+    AuraEffectArray(AuraEffectArray const& right);
+    AuraEffectArray(AuraEffectArray&& right) noexcept;
+    ~AuraEffectArray() { delete[] _entries; }
+
+    AuraEffectArray& operator=(AuraEffectArray right) noexcept;
+
+    // begin and end are evaluated on every call: effects appended during an iteration are part of it
+    [[nodiscard]] const_iterator begin() const;
+    [[nodiscard]] const_iterator end() const { return const_iterator(this, _size); }
+    [[nodiscard]] const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    [[nodiscard]] const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    [[nodiscard]] bool empty() const { return !_live; }
+    [[nodiscard]] size_type size() const { return _live; }
+    [[nodiscard]] AuraEffect* front() const { return *begin(); }
+    [[nodiscard]] AuraEffect* back() const { return *(--end()); }
+
+    void push_back(AuraEffect* effect);
+    // marks all entries of the effect as removed, the slots are kept until Compact()
+    void remove(AuraEffect* effect);
+    void clear();
+
+    // same order as std::list::sort, only meant for local copies (drops removed slots)
+    template<class Predicate>
+    void sort(Predicate pred)
+    {
+        Compact();
+        std::stable_sort(_entries, _entries + _size, [&pred](Entry const& left, Entry const& right) { return pred(left.effect, right.effect); });
+    }
+
+    [[nodiscard]] bool HasRemoved() const { return _live != _size; }
+    // must not be called while the array is iterated
+    void Compact();
+
+    AuraEffectTotals const& GetTotals() const;
+    void InvalidateTotals() { _totalsValid = false; }
+
+private:
+    void Reserve(uint32 capacity);
+
+    Entry* _entries;
+    uint16 _size;       // used slots, including removed ones
+    uint16 _capacity;
+    uint16 _live;       // slots not removed
+    mutable bool _totalsValid;
+    mutable AuraEffectTotals _totals;
+};
+
+#endif
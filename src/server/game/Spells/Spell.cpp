@@ -1284,6 +1284,8 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
             acore::Containers::RandomResizeList(targets, maxTargets);
         }
 
+        PrepareAreaTargetsLOS(targets);
+
         for (std::list<WorldObject*>::iterator itr = targets.begin(); itr != targets.end(); ++itr)
         {
             if (Unit* unitTarget = (*itr)->ToUnit())
@@ -1291,7 +1293,64 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
             else if (GameObject* gObjTarget = (*itr)->ToGameObject())
                 AddGOTarget(gObjTarget, effMask);
         }
+
+        m_areaTargetLOS.clear();
+    }
+}
+
+void Spell::PrepareAreaTargetsLOS(std::list<WorldObject*> const& targets)
+{
+    // same exceptions as in CheckEffectTarget
+    if (targets.size() < 2 || m_spellInfo->HasAttribute(SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS))
+        return;
+
+    if (IsTriggered() && m_triggeredByAuraSpell && (m_triggeredByAuraSpell->HasAttribute(SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS) || DisableMgr::IsDisabledFor(DISABLE_TYPE_SPELL, m_triggeredByAuraSpell->Id, nullptr, SPELL_DISABLE_LOS)))
+        return;
+
+    WorldObject* caster = nullptr;
+    if (IS_GAMEOBJECT_GUID(m_originalCasterGUID))
+        caster = m_caster->GetMap()->GetGameObject(m_originalCasterGUID);
+    if (!caster)
+        caster = m_caster;
+
+    std::vector<Unit const*> units;
+    std::vector<VMAP::LineOfSightRay> rays;
+    units.reserve(targets.size());
+    rays.reserve(targets.size());
+
+    for (WorldObject const* object : targets)
+    {
+        Unit const* target = object->ToUnit();
+        if (!target || target == m_caster)
+            continue;
+
+        // rays the default case of CheckEffectTarget would test, other targets keep the single check
+        VMAP::LineOfSightRay ray;
+        if (m_targets.HasDst())
+        {
+            if (!target->IsInWorld())
+                continue;
+
+            target->GetLineOfSightRay(m_targets.GetDstPos()->GetPositionX(), m_targets.GetDstPos()->GetPositionY(), m_targets.GetDstPos()->GetPositionZ(), ray);
+        }
+        else
+        {
+            if (!target->IsInMap(caster))
+                continue;
+
+            target->GetLineOfSightRay(caster, ray);
+        }
+
+        units.push_back(target);
+        rays.push_back(ray);
     }
+
+    if (rays.size() < 2)
+        return;
+
+    m_caster->GetMap()->isInLineOfSight(rays, LINEOFSIGHT_ALL_CHECKS);
+    for (size_t i = 0; i < units.size(); ++i)
+        m_areaTargetLOS[units[i]] = rays[i].inLineOfSight;
 }
 
 void Spell::SelectImplicitCasterDestTargets(SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType)
@@ -7374,7 +7433,13 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff) const
                 caster = m_caster;
             if (target != m_caster)
             {
-                if (m_targets.HasDst())
+                auto batchedLOS = m_areaTargetLOS.find(target);
+                if (batchedLOS != m_areaTargetLOS.end())
+                {
+                    if (!batchedLOS->second)
+                        return false;
+                }
+                else if (m_targets.HasDst())
                 {
                     float x = m_targets.GetDstPos()->GetPositionX();
                     float y = m_targets.GetDstPos()->GetPositionY();
@@ -396,6 +396,7 @@ public:
     void SelectImplicitNearbyTargets(SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType, uint32 effMask);
     void SelectImplicitConeTargets(SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType, uint32 effMask);
     void SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType, uint32 effMask);
+    void PrepareAreaTargetsLOS(std::list<WorldObject*> const& targets);
     void SelectImplicitCasterDestTargets(SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType);
     void SelectImplicitTargetDestTargets(SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType);
     void SelectImplicitDestDestTargets(SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType);
@@ -626,6 +627,7 @@ protected:
     // *****************************************
     std::list<TargetInfo> m_UniqueTargetInfo;
     uint8 m_channelTargetEffectMask;                        // Mask req. alive targets
+    std::unordered_map<Unit const*, bool> m_areaTargetLOS;  // checked together for the targets of an area, see CheckEffectTarget
 
     struct GOTargetInfo
     {
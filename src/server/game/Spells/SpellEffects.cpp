@@ -1436,7 +1436,10 @@ void Spell::EffectSendEvent(SpellEffIndex effIndex)
 #endif
 
     if (ZoneScript* zoneScript = m_caster->GetZoneScript())
+    {
+        auto guard = m_caster->GetMap()->GuardIslandUpdate();
         zoneScript->ProcessEvent(target, m_spellInfo->Effects[effIndex].MiscValue);
+    }
     else if (InstanceScript* instanceScript = m_caster->GetInstanceScript())    // needed in case Player is the caster
         instanceScript->ProcessEvent(target, m_spellInfo->Effects[effIndex].MiscValue);
 
@@ -12,6 +12,7 @@
 #include "Common.h"
 #include "SharedDefines.h"
 #include "Unit.h"
+#include <atomic>
 
 class SpellInfo;
 class Player;
@@ -652,6 +653,11 @@ public:
 
     // Spell proc table
     [[nodiscard]] SpellProcEntry const* GetSpellProcEntry(uint32 spellId) const;
+
+    // proc flags an aura of the spell reacts to in Unit::ProcDamageAndSpellFor, 0 if it is handled by the spell proc table
+    [[nodiscard]] uint32 GetSpellProcEventFlags(SpellInfo const* spellInfo) const;
+    // changes whenever the proc tables are (re)loaded, units rebuild their proc index then
+    [[nodiscard]] uint32 GetProcDataGeneration() const { return _procDataGeneration.load(std::memory_order_relaxed); }
     bool CanSpellTriggerProcOnEvent(SpellProcEntry const& procEntry, ProcEventInfo& eventInfo) const;
 
     // Spell bonus data table
@@ -734,6 +740,7 @@ private:
     SpellGroupStackMap         mSpellGroupStackMap;
     SpellProcEventMap          mSpellProcEventMap;
     SpellProcMap               mSpellProcMap;
+    std::atomic<uint32>        _procDataGeneration{0};
     SpellBonusMap              mSpellBonusMap;
     SpellThreatMap             mSpellThreatMap;
     SpellMixologyMap           mSpellMixologyMap;
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "StartupLoader.h"
+#include "DatabaseEnv.h"
+#include "Errors.h"
+#include "Log.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <thread>
+
+namespace
+{
+    StartupLoader::TaskId const NoTask = std::numeric_limits<StartupLoader::TaskId>::max();
+}
+
+StartupLoader::StartupLoader() : _lastInOrder(NoTask), _threads(1), _runTime(0), _running(0), _exclusiveRunning(false), _finished(0)
+{
+}
+
+StartupLoader::TaskId StartupLoader::Add(char const* name, std::vector<TaskId> const& after, Task task)
+{
+    std::vector<TaskId> dependencies(after);
+    if (_lastInOrder != NoTask)
+        dependencies.push_back(_lastInOrder);
+
+    _lastInOrder = AddNode(name, dependencies, std::move(task), false);
+    return _lastInOrder;
+}
+
+StartupLoader::TaskId StartupLoader::AddParallel(char const* name, std::vector<TaskId> const& after, Task task)
+{
+    return AddNode(name, after, std::move(task), false);
+}
+
+StartupLoader::TaskId StartupLoader::AddExclusive(char const* name, std::vector<TaskId> const& after, Task task)
+{
+    std::vector<TaskId> dependencies(after);
+    if (_lastInOrder != NoTask)
+        dependencies.push_back(_lastInOrder);
+
+    _lastInOrder = AddNode(name, dependencies, std::move(task), true);
+    return _lastInOrder;
+}
+
+StartupLoader::TaskId StartupLoader::AddNode(char const* name, std::vector<TaskId> const& after, Task task, bool exclusive)
+{
+    TaskId id = TaskId(_nodes.size());
+
+    Node node;
+    node.name = name;
+    node.task = std::move(task);
+    node.pending = 0;
+    node.time = 0;
+    node.exclusive = exclusive;
+    _nodes.push_back(std::move(node));
+
+    for (TaskId dependency : after)
+    {
+        // only earlier loaders, the order they were added in is always a valid order to run them
+        ASSERT(dependency < id);
+        _nodes[dependency].dependents.push_back(id);
+        ++_nodes[id].pending;
+    }
+
+    return id;
+}
+
+void StartupLoader::Run(uint32 threads)
+{
+    auto startTime = std::chrono::steady_clock::now();
+    _threads = std::max<uint32>(threads, 1);
+
+    if (_threads == 1)
+    {
+        for (Node& node : _nodes)
+            RunNode(node);
+    }
+    else
+    {
+        _running = 0;
+        _exclusiveRunning = false;
+        _finished = 0;
+        for (TaskId id = 0; id < _nodes.size(); ++id)
+            if (!_nodes[id].pending)
+                (_nodes[id].exclusive ? _readyExclusive : _ready).insert(id);
+
+        std::vector<std::thread> workerThreads;
+        for (uint32 i = 1; i < _threads; ++i)
+            workerThreads.push_back(std::thread(&StartupLoader::WorkerThread, this));
+
+        RunLoaders(true);
+
+        for (auto& thread : workerThreads)
+            thread.join();
+    }
+
+    _runTime = uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count());
+}
+
+void StartupLoader::RunNode(Node& node)
+{
+    auto startTime = std::chrono::steady_clock::now();
+    node.task();
+    node.time = uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count());
+}
+
+void StartupLoader::RunLoaders(bool callingThread)
+{
+    std::unique_lock<std::mutex> guard(_lock);
+    while (true)
+    {
+        // an exclusive loader waits until every running loader is done, no other one starts meanwhile
+        TaskId id = NoTask;
+        while (_finished < _nodes.size())
+        {
+            if (!_readyExclusive.empty())
+            {
+                if (callingThread && !_running)
+                {
+                    id = *_readyExclusive.begin();
+                    _readyExclusive.erase(_readyExclusive.begin());
+                    break;
+                }
+            }
+            else if (!_ready.empty() && !_exclusiveRunning)
+            {
+                id = *_ready.begin();
+                _ready.erase(_ready.begin());
+                break;
+            }
+
+            _condition.wait(guard);
+        }
+
+        if (id == NoTask)
+            break;
+
+        ++_running;
+        _exclusiveRunning = _nodes[id].exclusive;
+        guard.unlock();
+        RunNode(_nodes[id]);
+        guard.lock();
+        _exclusiveRunning = false;
+        --_running;
+
+        ++_finished;
+        for (TaskId dependent : _nodes[id].dependents)
+            if (!--_nodes[dependent].pending)
+                (_nodes[dependent].exclusive ? _readyExclusive : _ready).insert(dependent);
+
+        _condition.notify_all();
+    }
+}
+
+void StartupLoader::WorkerThread()
+{
+    // queries run on this thread, not only on the connections' own
+    MySQL::Thread_Init();
+
+    RunLoaders(false);
+
+    MySQL::Thread_End();
+}
+
+void StartupLoader::PrintTimings() const
+{
+    uint64 loaderTime = 0;
+    std::vector<Node const*> nodes;
+    for (Node const& node : _nodes)
+    {
+        loaderTime += node.time;
+        nodes.push_back(&node);
+    }
+
+    std::stable_sort(nodes.begin(), nodes.end(), [](Node const* left, Node const* right) { return left->time > right->time; });
+
+    sLog->outString(">> Ran %u startup loaders in %u ms on %u thread(s), %u ms spent in the loaders", uint32(_nodes.size()), uint32(_runTime / 1000), _threads, uint32(loaderTime / 1000));
+    for (Node const* node : nodes)
+        sLog->outString("   %9.1f ms  %s", node->time / 1000.0, node->name.c_str());
+    sLog->outString();
+}
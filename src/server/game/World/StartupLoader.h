@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _STARTUPLOADER_H
+#define _STARTUPLOADER_H
+
+#include "Define.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+/*
+ * Runs the loaders of World::SetInitialWorldSettings as a dependency graph.
+ *
+ * Loaders added with Add keep the startup order: they wait for the loader added with Add before them,
+ * the same as the plain sequence of calls they replace. Loaders added with AddParallel only wait for
+ * the loaders they list, so their data dependencies must all be listed. Independent loaders run
+ * concurrently on the loader threads, each on its own synch connection of the database pools.
+ * Loaders added with AddExclusive keep the startup order as well, but run alone on the calling thread:
+ * they may exit() the process on bad data, which must not happen while another loader thread is busy.
+ *
+ * With one thread everything runs on the calling thread in the order it was added.
+ */
+class StartupLoader
+{
+public:
+    typedef uint32 TaskId;
+    typedef std::function<void()> Task;
+
+    StartupLoader();
+
+    TaskId Add(char const* name, std::vector<TaskId> const& after, Task task);
+    TaskId AddParallel(char const* name, std::vector<TaskId> const& after, Task task);
+    TaskId AddExclusive(char const* name, std::vector<TaskId> const& after, Task task);
+
+    void Run(uint32 threads);
+    // time of every loader, longest first
+    void PrintTimings() const;
+
+private:
+    struct Node
+    {
+        std::string name;
+        Task task;
+        std::vector<TaskId> dependents;
+        uint32 pending;     // dependencies not finished yet
+        uint64 time;        // microseconds
+        bool exclusive;
+    };
+
+    TaskId AddNode(char const* name, std::vector<TaskId> const& after, Task task, bool exclusive);
+    void RunNode(Node& node);
+    // the calling thread of Run takes part as well, only it runs the exclusive loaders
+    void RunLoaders(bool callingThread);
+    void WorkerThread();
+
+    std::vector<Node> _nodes;
+    TaskId _lastInOrder;
+    uint32 _threads;
+    uint64 _runTime;        // microseconds
+
+    std::mutex _lock;
+    std::condition_variable _condition;
+    std::set<TaskId> _ready;    // lowest id first, close to the startup order
+    std::set<TaskId> _readyExclusive;
+    uint32 _running;
+    bool _exclusiveRunning;
+    uint32 _finished;
+};
+
+#endif
@@ -54,13 +54,16 @@
 #include "PetitionMgr.h"
 #include "Player.h"
 #include "PoolMgr.h"
+#include "RayKernels.h"
 #include "SavingSystem.h"
 #include "ScriptMgr.h"
 #include "ServerMotd.h"
+#include "SharedPacket.h"
 #include "SkillDiscovery.h"
 #include "SkillExtraItems.h"
 #include "SmartAI.h"
 #include "SpellMgr.h"
+#include "StartupLoader.h"
 #include "TemporarySummon.h"
 #include "TicketMgr.h"
 #include "Transport.h"
@@ -637,6 +640,8 @@ void World::LoadConfigSettings(bool reload)
         sLog->outError("Compression level (%i) must be in range 1..9. Using default compression level (1).", m_int_configs[CONFIG_COMPRESSION]);
         m_int_configs[CONFIG_COMPRESSION] = 1;
     }
+    m_int_configs[CONFIG_COMPRESSION_MIN_SIZE] = sConfigMgr->GetOption<int32>("Compression.MinSize", 100);
+    m_int_configs[CONFIG_COMPRESSION_ADAPTIVE_DIFF] = sConfigMgr->GetOption<int32>("Compression.AdaptiveDiff", 0);
     m_bool_configs[CONFIG_ADDON_CHANNEL]                   = sConfigMgr->GetOption<bool>("AddonChannel", true);
     m_bool_configs[CONFIG_CLEAN_CHARACTER_DB]              = sConfigMgr->GetOption<bool>("CleanCharacterDB", false);
     m_int_configs[CONFIG_PERSISTENT_CHARACTER_CLEAN_FLAGS] = sConfigMgr->GetOption<int32>("PersistentCharacterCleanFlags", 0);
@@ -1281,6 +1286,7 @@ void World::LoadConfigSettings(bool reload)
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableLineOfSightCalc(enableLOS);
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableHeightCalc(enableHeight);
     sLog->outString("WORLD: VMap support included. LineOfSight:%i, getHeight:%i, indoorCheck:%i PetLOS:%i", enableLOS, enableHeight, enableIndoor, enablePetLOS);
+    sLog->outString("WORLD: VMap ray kernel: %s", VMAP::GetRayKernelName(VMAP::GetRayKernel()));
 
     m_bool_configs[CONFIG_PET_LOS]          = sConfigMgr->GetOption<bool>("vmap.petLOS", true);
     m_bool_configs[CONFIG_START_ALL_SPELLS]   = sConfigMgr->GetOption<bool>("PlayerStart.CustomSpells", false);
@@ -1303,6 +1309,10 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE]         = sConfigMgr->GetOption<int32>("RecordUpdateTimeDiffInterval", 300000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE]              = sConfigMgr->GetOption<int32>("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS]                  = sConfigMgr->GetOption<int32>("MapUpdate.Threads", 1);
+    m_bool_configs[CONFIG_MAP_UPDATE_ISLANDS]         = sConfigMgr->GetOption<bool>("MapUpdate.Islands", false);
+    m_int_configs[CONFIG_GRID_PRELOAD_THREADS]        = sConfigMgr->GetOption<int32>("GridPreload.Threads", 1);
+    m_int_configs[CONFIG_GRID_PRELOAD_LOOKAHEAD]      = sConfigMgr->GetOption<int32>("GridPreload.Lookahead", 10);
+    m_int_configs[CONFIG_STARTUP_LOADER_THREADS]      = sConfigMgr->GetOption<int32>("StartupLoader.Threads", 1);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetOption<int32>("Command.LookupMaxResults", 0);
 
     // chat logging
@@ -1328,6 +1338,7 @@ void World::LoadConfigSettings(bool reload)
 
     // Dungeon finder
     m_int_configs[CONFIG_LFG_OPTIONSMASK] = sConfigMgr->GetOption<int32>("DungeonFinder.OptionsMask", 3);
+    m_int_configs[CONFIG_LFG_MATCH_TIME_BUDGET] = sConfigMgr->GetOption<int32>("DungeonFinder.MatchTimeBudget", 0);
 
     // Max instances per hour
     m_int_configs[CONFIG_MAX_INSTANCES_PER_HOUR] = sConfigMgr->GetOption<int32>("AccountInstancesPerHour", 5);
@@ -1349,6 +1360,8 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_PDUMP_NO_PATHS]     = sConfigMgr->GetOption<bool>("PlayerDump.DisallowPaths", true);
     m_bool_configs[CONFIG_PDUMP_NO_OVERWRITE] = sConfigMgr->GetOption<bool>("PlayerDump.DisallowOverwrite", true);
     m_bool_configs[CONFIG_ENABLE_MMAPS]       = sConfigMgr->GetOption<bool>("MoveMaps.Enable", true);
+    m_bool_configs[CONFIG_MMAPS_BATCHED_PATHS] = sConfigMgr->GetOption<bool>("MoveMaps.BatchedPaths", true);
+    m_int_configs[CONFIG_MMAPS_PATH_CACHE_SIZE] = sConfigMgr->GetOption<int32>("MoveMaps.PathCacheSize", 128);
     MMAP::MMapFactory::InitializeDisabledMaps();
 
     // Wintergrasp
@@ -1383,6 +1396,9 @@ void World::LoadConfigSettings(bool reload)
     // Preload all grids of all non-instanced maps
     m_bool_configs[CONFIG_PRELOAD_ALL_NON_INSTANCED_MAP_GRIDS] = sConfigMgr->GetOption<bool>("PreloadAllNonInstancedMapGrids", false);
 
+    // Map terrain files straight into memory instead of reading them
+    m_bool_configs[CONFIG_MAP_FILES_MEMORY_MAPPED] = sConfigMgr->GetOption<bool>("MapFiles.MemoryMapped", true);
+
     // ICC buff override
     m_int_configs[CONFIG_ICC_BUFF_HORDE] = sConfigMgr->GetOption<int32>("ICC.Buff.Horde", 73822);
     m_int_configs[CONFIG_ICC_BUFF_ALLIANCE] = sConfigMgr->GetOption<int32>("ICC.Buff.Alliance", 73828);
@@ -1510,437 +1526,856 @@ void World::SetInitialWorldSettings()
     ///- Custom Hook for loading DB items
     sScriptMgr->OnLoadCustomDatabaseTable();
 
+    ///- Loaders run as a graph: Add keeps the startup order, AddParallel only waits for the loaders listed (see StartupLoader)
+    StartupLoader loader;
+
     ///- Load the DBC files
-    sLog->outString("Initialize data stores...");
-    LoadDBCStores(m_dataPath);
-    DetectDBCLang();
+    StartupLoader::TaskId dbcStores = loader.AddExclusive("DBC stores", {}, [this]
+    {
+        sLog->outString("Initialize data stores...");
+        LoadDBCStores(m_dataPath, sConfigMgr->GetOption<std::string>("DBC.CacheFile", ""));
+        DetectDBCLang();
 
-    sLog->outString("Loading Game Graveyard...");
-    sGraveyard->LoadGraveyardFromDB();
+        sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());    // Get once for all the locale index of DBC language (console/broadcasts)
+    });
 
-    sLog->outString("Loading spell dbc data corrections...");
-    sSpellMgr->LoadDbcDataCorrections();
+    loader.Add("Game graveyards", {}, []
+    {
+        sLog->outString("Loading Game Graveyard...");
+        sGraveyard->LoadGraveyardFromDB();
+    });
 
-    sLog->outString("Loading SpellInfo store...");
-    sSpellMgr->LoadSpellInfoStore();
+    loader.Add("Spell dbc data corrections", {}, []
+    {
+        sLog->outString("Loading spell dbc data corrections...");
+        sSpellMgr->LoadDbcDataCorrections();
+    });
 
-    sLog->outString("Loading Spell Rank Data...");
-    sSpellMgr->LoadSpellRanks();
+    loader.Add("SpellInfo store", {}, []
+    {
+        sLog->outString("Loading SpellInfo store...");
+        sSpellMgr->LoadSpellInfoStore();
+    });
+
+    loader.Add("Spell ranks", {}, []
+    {
+        sLog->outString("Loading Spell Rank Data...");
+        sSpellMgr->LoadSpellRanks();
+    });
 
-    sLog->outString("Loading Spell Specific And Aura State...");
-    sSpellMgr->LoadSpellSpecificAndAuraState();
+    loader.Add("Spell specific and aura state", {}, []
+    {
+        sLog->outString("Loading Spell Specific And Aura State...");
+        sSpellMgr->LoadSpellSpecificAndAuraState();
+    });
 
-    sLog->outString("Loading SkillLineAbilityMultiMap Data...");
-    sSpellMgr->LoadSkillLineAbilityMap();
+    loader.Add("SkillLineAbility map", {}, []
+    {
+        sLog->outString("Loading SkillLineAbilityMultiMap Data...");
+        sSpellMgr->LoadSkillLineAbilityMap();
+    });
 
-    sLog->outString("Loading spell custom attributes...");
-    sSpellMgr->LoadSpellCustomAttr();
+    // the SpellInfo store is complete, the spell loaders below only fill their own SpellMgr containers
+    StartupLoader::TaskId spellCustomAttr = loader.Add("Spell custom attributes", {}, []
+    {
+        sLog->outString("Loading spell custom attributes...");
+        sSpellMgr->LoadSpellCustomAttr();
+    });
 
-    sLog->outString("Loading GameObject models...");
-    LoadGameObjectModelList();
+    loader.Add("GameObject models", {}, []
+    {
+        sLog->outString("Loading GameObject models...");
+        LoadGameObjectModelList();
+    });
 
-    sLog->outString("Loading Script Names...");
-    sObjectMgr->LoadScriptNames();
+    loader.Add("Script names", {}, []
+    {
+        sLog->outString("Loading Script Names...");
+        sObjectMgr->LoadScriptNames();
+    });
 
-    sLog->outString("Loading Instance Template...");
-    sObjectMgr->LoadInstanceTemplate();
+    loader.Add("Instance templates", {}, []
+    {
+        sLog->outString("Loading Instance Template...");
+        sObjectMgr->LoadInstanceTemplate();
+    });
 
     // xinef: Global Storage, should be loaded asap
-    sLog->outString("Load Global Player Data...");
-    sWorld->LoadGlobalPlayerDataStore();
+    loader.Add("Global player data", {}, []
+    {
+        sLog->outString("Load Global Player Data...");
+        sWorld->LoadGlobalPlayerDataStore();
+    });
 
     // Must be called before `creature_respawn`/`gameobject_respawn` tables
-    sLog->outString("Loading instances...");
-    sInstanceSaveMgr->LoadInstances();
+    loader.Add("Instances", {}, []
+    {
+        sLog->outString("Loading instances...");
+        sInstanceSaveMgr->LoadInstances();
+    });
+
+    loader.Add("Broadcast texts", {}, []
+    {
+        sLog->outString("Loading Broadcast texts...");
+        sObjectMgr->LoadBroadcastTexts();
+        sObjectMgr->LoadBroadcastTextLocales();
+    });
+
+    // locale stores are only read by the game, not by other loaders
+    uint32 localesStartTime = 0;
+    StartupLoader::TaskId localesStart = loader.AddParallel("Localization strings", {}, [&localesStartTime]
+    {
+        sLog->outString("Loading Localization strings...");
+        localesStartTime = getMSTime();
+    });
+
+    std::vector<StartupLoader::TaskId> locales;
+    locales.push_back(loader.AddParallel("Creature locales", { localesStart }, [] { sObjectMgr->LoadCreatureLocales(); }));
+    locales.push_back(loader.AddParallel("GameObject locales", { localesStart }, [] { sObjectMgr->LoadGameObjectLocales(); }));
+    StartupLoader::TaskId itemLocales = loader.AddParallel("Item locales", { localesStart }, [] { sObjectMgr->LoadItemLocales(); });
+    locales.push_back(itemLocales);
+    locales.push_back(loader.AddParallel("Item set name locales", { localesStart }, [] { sObjectMgr->LoadItemSetNameLocales(); }));
+    locales.push_back(loader.AddParallel("Quest locales", { localesStart }, [] { sObjectMgr->LoadQuestLocales(); }));
+    locales.push_back(loader.AddParallel("Quest offer reward locales", { localesStart }, [] { sObjectMgr->LoadQuestOfferRewardLocale(); }));
+    locales.push_back(loader.AddParallel("Quest request items locales", { localesStart }, [] { sObjectMgr->LoadQuestRequestItemsLocale(); }));
+    locales.push_back(loader.AddParallel("NPC text locales", { localesStart }, [] { sObjectMgr->LoadNpcTextLocales(); }));
+    locales.push_back(loader.AddParallel("Page text locales", { localesStart }, [] { sObjectMgr->LoadPageTextLocales(); }));
+    locales.push_back(loader.AddParallel("Gossip menu option locales", { localesStart }, [] { sObjectMgr->LoadGossipMenuItemsLocales(); }));
+    locales.push_back(loader.AddParallel("Points of interest locales", { localesStart }, [] { sObjectMgr->LoadPointOfInterestLocales(); }));
+
+    loader.AddParallel("Localization strings loaded", locales, [&localesStartTime]
+    {
+        sLog->outString(">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(localesStartTime));
+        sLog->outString();
+    });
 
-    sLog->outString("Loading Broadcast texts...");
-    sObjectMgr->LoadBroadcastTexts();
-    sObjectMgr->LoadBroadcastTextLocales();
+    loader.Add("Page texts", {}, []
+    {
+        sLog->outString("Loading Page Texts...");
+        sObjectMgr->LoadPageTexts();
+    });
 
-    sLog->outString("Loading Localization strings...");
-    uint32 oldMSTime = getMSTime();
-    sObjectMgr->LoadCreatureLocales();
-    sObjectMgr->LoadGameObjectLocales();
-    sObjectMgr->LoadItemLocales();
-    sObjectMgr->LoadItemSetNameLocales();
-    sObjectMgr->LoadQuestLocales();
-    sObjectMgr->LoadQuestOfferRewardLocale();
-    sObjectMgr->LoadQuestRequestItemsLocale();
-    sObjectMgr->LoadNpcTextLocales();
-    sObjectMgr->LoadPageTextLocales();
-    sObjectMgr->LoadGossipMenuItemsLocales();
-    sObjectMgr->LoadPointOfInterestLocales();
-
-    sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
-    sLog->outString(">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
-    sLog->outString();
+    StartupLoader::TaskId gameObjectTemplates = loader.Add("GameObject templates", {}, []
+    {
+        sLog->outString("Loading Game Object Templates...");         // must be after LoadPageTexts
+        sObjectMgr->LoadGameObjectTemplate();
+    });
 
-    sLog->outString("Loading Page Texts...");
-    sObjectMgr->LoadPageTexts();
+    loader.Add("GameObject template addons", {}, []
+    {
+        sLog->outString("Loading Game Object template addons...");
+        sObjectMgr->LoadGameObjectTemplateAddons();
+    });
 
-    sLog->outString("Loading Game Object Templates...");         // must be after LoadPageTexts
-    sObjectMgr->LoadGameObjectTemplate();
+    loader.Add("Transport templates", {}, []
+    {
+        sLog->outString("Loading Transport templates...");
+        sTransportMgr->LoadTransportTemplates();
+    });
 
-    sLog->outString("Loading Game Object template addons...");
-    sObjectMgr->LoadGameObjectTemplateAddons();
+    StartupLoader::TaskId spellData = loader.AddParallel("Spell required data", { spellCustomAttr }, []
+    {
+        sLog->outString("Loading Spell Required Data...");
+        sSpellMgr->LoadSpellRequired();
+    });
 
-    sLog->outString("Loading Transport templates...");
-    sTransportMgr->LoadTransportTemplates();
+    spellData = loader.AddParallel("Spell group types", { spellData }, []
+    {
+        sLog->outString("Loading Spell Group types...");
+        sSpellMgr->LoadSpellGroups();
+    });
 
-    sLog->outString("Loading Spell Required Data...");
-    sSpellMgr->LoadSpellRequired();
+    spellData = loader.AddParallel("Spell learn skills", { spellData }, []
+    {
+        sLog->outString("Loading Spell Learn Skills...");
+        sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
+    });
 
-    sLog->outString("Loading Spell Group types...");
-    sSpellMgr->LoadSpellGroups();
+    spellData = loader.AddParallel("Spell proc events", { spellData }, []
+    {
+        sLog->outString("Loading Spell Proc Event conditions...");
+        sSpellMgr->LoadSpellProcEvents();
+    });
 
-    sLog->outString("Loading Spell Learn Skills...");
-    sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
+    spellData = loader.AddParallel("Spell procs", { spellData }, []
+    {
+        sLog->outString("Loading Spell Proc conditions and data...");
+        sSpellMgr->LoadSpellProcs();
+    });
 
-    sLog->outString("Loading Spell Proc Event conditions...");
-    sSpellMgr->LoadSpellProcEvents();
+    spellData = loader.AddParallel("Spell bonus data", { spellData }, []
+    {
+        sLog->outString("Loading Spell Bonus Data...");
+        sSpellMgr->LoadSpellBonusess();
+    });
+
+    spellData = loader.AddParallel("Spell threats", { spellData }, []
+    {
+        sLog->outString("Loading Aggro Spells Definitions...");
+        sSpellMgr->LoadSpellThreats();
+    });
 
-    sLog->outString("Loading Spell Proc conditions and data...");
-    sSpellMgr->LoadSpellProcs();
+    spellData = loader.AddParallel("Spell mixology", { spellData }, []
+    {
+        sLog->outString("Loading Mixology bonuses...");
+        sSpellMgr->LoadSpellMixology();
+    });
 
-    sLog->outString("Loading Spell Bonus Data...");
-    sSpellMgr->LoadSpellBonusess();
+    spellData = loader.AddParallel("Spell group stack rules", { spellData }, []
+    {
+        sLog->outString("Loading Spell Group Stack Rules...");
+        sSpellMgr->LoadSpellGroupStackRules();
+    });
 
-    sLog->outString("Loading Aggro Spells Definitions...");
-    sSpellMgr->LoadSpellThreats();
+    loader.Add("NPC texts", {}, []
+    {
+        sLog->outString("Loading NPC Texts...");
+        sObjectMgr->LoadGossipText();
+    });
 
-    sLog->outString("Loading Mixology bonuses...");
-    sSpellMgr->LoadSpellMixology();
+    spellData = loader.AddParallel("Enchant spell proc data", { spellData }, []
+    {
+        sLog->outString("Loading Enchant Spells Proc datas...");
+        sSpellMgr->LoadSpellEnchantProcData();
+    });
 
-    sLog->outString("Loading Spell Group Stack Rules...");
-    sSpellMgr->LoadSpellGroupStackRules();
+    loader.Add("Item random enchantments", {}, []
+    {
+        sLog->outString("Loading Item Random Enchantments Table...");
+        LoadRandomEnchantmentsTable();
+    });
 
-    sLog->outString("Loading NPC Texts...");
-    sObjectMgr->LoadGossipText();
+    loader.Add("Disables", {}, []
+    {
+        sLog->outString("Loading Disables");
+        DisableMgr::LoadDisables();                                  // must be before loading quests and items
+    });
 
-    sLog->outString("Loading Enchant Spells Proc datas...");
-    sSpellMgr->LoadSpellEnchantProcData();
+    StartupLoader::TaskId itemTemplates = loader.Add("Item templates", {}, []
+    {
+        sLog->outString("Loading Items...");                         // must be after LoadRandomEnchantmentsTable and LoadPageTexts
+        sObjectMgr->LoadItemTemplates();
+    });
 
-    sLog->outString("Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
+    loader.Add("Item set names", {}, []
+    {
+        sLog->outString("Loading Item set names...");                // must be after LoadItemPrototypes
+        sObjectMgr->LoadItemSetNames();
+    });
 
-    sLog->outString("Loading Disables");
-    DisableMgr::LoadDisables();                                  // must be before loading quests and items
+    loader.Add("Creature model info", {}, []
+    {
+        sLog->outString("Loading Creature Model Based Info Data...");
+        sObjectMgr->LoadCreatureModelInfo();
+    });
 
-    sLog->outString("Loading Items...");                         // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr->LoadItemTemplates();
+    StartupLoader::TaskId creatureTemplates = loader.Add("Creature templates", {}, []
+    {
+        sLog->outString("Loading Creature templates...");
+        sObjectMgr->LoadCreatureTemplates();
+    });
 
-    sLog->outString("Loading Item set names...");                // must be after LoadItemPrototypes
-    sObjectMgr->LoadItemSetNames();
+    loader.Add("Equipment templates", {}, []
+    {
+        sLog->outString("Loading Equipment templates...");           // must be after LoadCreatureTemplates
+        sObjectMgr->LoadEquipmentTemplates();
+    });
 
-    sLog->outString("Loading Creature Model Based Info Data...");
-    sObjectMgr->LoadCreatureModelInfo();
+    loader.Add("Creature template addons", {}, []
+    {
+        sLog->outString("Loading Creature template addons...");
+        sObjectMgr->LoadCreatureTemplateAddons();
+    });
 
-    sLog->outString("Loading Creature templates...");
-    sObjectMgr->LoadCreatureTemplates();
+    loader.Add("Reputation reward rates", {}, []
+    {
+        sLog->outString("Loading Reputation Reward Rates...");
+        sObjectMgr->LoadReputationRewardRate();
+    });
 
-    sLog->outString("Loading Equipment templates...");           // must be after LoadCreatureTemplates
-    sObjectMgr->LoadEquipmentTemplates();
+    loader.Add("Reputation on kill", {}, []
+    {
+        sLog->outString("Loading Creature Reputation OnKill Data...");
+        sObjectMgr->LoadReputationOnKill();
+    });
 
-    sLog->outString("Loading Creature template addons...");
-    sObjectMgr->LoadCreatureTemplateAddons();
+    loader.Add("Reputation spillover", {}, []
+    {
+        sLog->outString("Loading Reputation Spillover Data..." );
+        sObjectMgr->LoadReputationSpilloverTemplate();
+    });
 
-    sLog->outString("Loading Reputation Reward Rates...");
-    sObjectMgr->LoadReputationRewardRate();
+    loader.Add("Points of interest", {}, []
+    {
+        sLog->outString("Loading Points Of Interest Data...");
+        sObjectMgr->LoadPointsOfInterest();
+    });
 
-    sLog->outString("Loading Creature Reputation OnKill Data...");
-    sObjectMgr->LoadReputationOnKill();
+    loader.Add("Creature base stats", {}, []
+    {
+        sLog->outString("Loading Creature Base Stats...");
+        sObjectMgr->LoadCreatureClassLevelStats();
+    });
 
-    sLog->outString("Loading Reputation Spillover Data..." );
-    sObjectMgr->LoadReputationSpilloverTemplate();
+    loader.Add("Creatures", {}, []
+    {
+        sLog->outString("Loading Creature Data...");
+        sObjectMgr->LoadCreatures();
+    });
 
-    sLog->outString("Loading Points Of Interest Data...");
-    sObjectMgr->LoadPointsOfInterest();
+    loader.Add("Temporary summons", {}, []
+    {
+        sLog->outString("Loading Temporary Summon Data...");
+        sObjectMgr->LoadTempSummons();                               // must be after LoadCreatureTemplates() and LoadGameObjectTemplates()
+    });
 
-    sLog->outString("Loading Creature Base Stats...");
-    sObjectMgr->LoadCreatureClassLevelStats();
+    spellData = loader.AddParallel("Pet levelup spells", { spellData }, []
+    {
+        sLog->outString("Loading pet levelup spells...");
+        sSpellMgr->LoadPetLevelupSpellMap();
+    });
 
-    sLog->outString("Loading Creature Data...");
-    sObjectMgr->LoadCreatures();
+    spellData = loader.AddParallel("Pet default spells", { spellData, creatureTemplates }, []
+    {
+        sLog->outString("Loading pet default spells additional to levelup spells...");
+        sSpellMgr->LoadPetDefaultSpells();
+    });
 
-    sLog->outString("Loading Temporary Summon Data...");
-    sObjectMgr->LoadTempSummons();                               // must be after LoadCreatureTemplates() and LoadGameObjectTemplates()
+    loader.Add("Creature addons", {}, []
+    {
+        sLog->outString("Loading Creature Addon Data...");
+        sObjectMgr->LoadCreatureAddons();                            // must be after LoadCreatureTemplates() and LoadCreatures()
+    });
 
-    sLog->outString("Loading pet levelup spells...");
-    sSpellMgr->LoadPetLevelupSpellMap();
+    loader.Add("GameObjects", {}, []
+    {
+        sLog->outString("Loading Gameobject Data...");
+        sObjectMgr->LoadGameobjects();
+    });
 
-    sLog->outString("Loading pet default spells additional to levelup spells...");
-    sSpellMgr->LoadPetDefaultSpells();
+    loader.Add("GameObject addons", {}, []
+    {
+        sLog->outString("Loading GameObject Addon Data...");
+        sObjectMgr->LoadGameObjectAddons();                          // must be after LoadGameObjectTemplate() and LoadGameobjects()
+    });
 
-    sLog->outString("Loading Creature Addon Data...");
-    sObjectMgr->LoadCreatureAddons();                            // must be after LoadCreatureTemplates() and LoadCreatures()
+    loader.Add("GameObject quest items", {}, []
+    {
+        sLog->outString("Loading GameObject Quest Items...");
+        sObjectMgr->LoadGameObjectQuestItems();
+    });
 
-    sLog->outString("Loading Gameobject Data...");
-    sObjectMgr->LoadGameobjects();
+    loader.Add("Creature quest items", {}, []
+    {
+        sLog->outString("Loading Creature Quest Items...");
+        sObjectMgr->LoadCreatureQuestItems();
+    });
 
-    sLog->outString("Loading GameObject Addon Data...");
-    sObjectMgr->LoadGameObjectAddons();                          // must be after LoadGameObjectTemplate() and LoadGameobjects()
+    loader.Add("Creature linked respawn", {}, []
+    {
+        sLog->outString("Loading Creature Linked Respawn...");
+        sObjectMgr->LoadLinkedRespawn();                             // must be after LoadCreatures(), LoadGameObjects()
+    });
 
-    sLog->outString("Loading GameObject Quest Items...");
-    sObjectMgr->LoadGameObjectQuestItems();
+    loader.Add("Weather data", {}, []
+    {
+        sLog->outString("Loading Weather Data...");
+        WeatherMgr::LoadWeatherData();
+    });
 
-    sLog->outString("Loading Creature Quest Items...");
-    sObjectMgr->LoadCreatureQuestItems();
+    loader.Add("Quests", {}, []
+    {
+        sLog->outString("Loading Quests...");
+        sObjectMgr->LoadQuests();                                    // must be loaded after DBCs, creature_template, item_template, gameobject tables
+    });
 
-    sLog->outString("Loading Creature Linked Respawn...");
-    sObjectMgr->LoadLinkedRespawn();                             // must be after LoadCreatures(), LoadGameObjects()
+    loader.Add("Quest disables", {}, []
+    {
+        sLog->outString("Checking Quest Disables");
+        DisableMgr::CheckQuestDisables();                           // must be after loading quests
+    });
 
-    sLog->outString("Loading Weather Data...");
-    WeatherMgr::LoadWeatherData();
+    loader.Add("Quest POI", {}, []
+    {
+        sLog->outString("Loading Quest POI");
+        sObjectMgr->LoadQuestPOI();
+    });
 
-    sLog->outString("Loading Quests...");
-    sObjectMgr->LoadQuests();                                    // must be loaded after DBCs, creature_template, item_template, gameobject tables
+    loader.Add("Quest starters and enders", {}, []
+    {
+        sLog->outString("Loading Quests Starters and Enders...");
+        sObjectMgr->LoadQuestStartersAndEnders();                    // must be after quest load
+    });
 
-    sLog->outString("Checking Quest Disables");
-    DisableMgr::CheckQuestDisables();                           // must be after loading quests
+    loader.Add("Pools", {}, []
+    {
+        sLog->outString("Loading Objects Pooling Data...");
+        sPoolMgr->LoadFromDB();
+    });
 
-    sLog->outString("Loading Quest POI");
-    sObjectMgr->LoadQuestPOI();
+    loader.Add("Game events", {}, []
+    {
+        sLog->outString("Loading Game Event Data...");               // must be after loading pools fully
+        sGameEventMgr->LoadHolidayDates();                           // Must be after loading DBC
+        sGameEventMgr->LoadFromDB();                                 // Must be after loading holiday dates
+    });
 
-    sLog->outString("Loading Quests Starters and Enders...");
-    sObjectMgr->LoadQuestStartersAndEnders();                    // must be after quest load
+    loader.Add("Spell click spells", {}, []
+    {
+        sLog->outString("Loading UNIT_NPC_FLAG_SPELLCLICK Data..."); // must be after LoadQuests
+        sObjectMgr->LoadNPCSpellClickSpells();
+    });
 
-    sLog->outString("Loading Objects Pooling Data...");
-    sPoolMgr->LoadFromDB();
+    loader.Add("Vehicle template accessories", {}, []
+    {
+        sLog->outString("Loading Vehicle Template Accessories...");
+        sObjectMgr->LoadVehicleTemplateAccessories();                // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
+    });
 
-    sLog->outString("Loading Game Event Data...");               // must be after loading pools fully
-    sGameEventMgr->LoadHolidayDates();                           // Must be after loading DBC
-    sGameEventMgr->LoadFromDB();                                 // Must be after loading holiday dates
+    loader.Add("Vehicle accessories", {}, []
+    {
+        sLog->outString("Loading Vehicle Accessories...");
+        sObjectMgr->LoadVehicleAccessories();                       // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
+    });
 
-    sLog->outString("Loading UNIT_NPC_FLAG_SPELLCLICK Data..."); // must be after LoadQuests
-    sObjectMgr->LoadNPCSpellClickSpells();
+    spellData = loader.AddParallel("Spell pet auras", { spellData }, []
+    {
+        sLog->outString("Loading spell pet auras...");
+        sSpellMgr->LoadSpellPetAuras();
+    });
 
-    sLog->outString("Loading Vehicle Template Accessories...");
-    sObjectMgr->LoadVehicleTemplateAccessories();                // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
+    spellData = loader.AddParallel("Spell target coordinates", { spellData }, []
+    {
+        sLog->outString("Loading Spell target coordinates...");
+        sSpellMgr->LoadSpellTargetPositions();
+    });
 
-    sLog->outString("Loading Vehicle Accessories...");
-    sObjectMgr->LoadVehicleAccessories();                       // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
+    spellData = loader.AddParallel("Enchant custom attributes", { spellData }, []
+    {
+        sLog->outString("Loading enchant custom attributes...");
+        sSpellMgr->LoadEnchantCustomAttr();
+    });
 
-    sLog->outString("Loading SpellArea Data...");                // must be after quest load
-    sSpellMgr->LoadSpellAreas();
+    spellData = loader.AddParallel("Linked spells", { spellData }, []
+    {
+        sLog->outString("Loading linked spells...");
+        sSpellMgr->LoadSpellLinked();
+    });
 
-    sLog->outString("Loading Area Trigger definitions");
-    sObjectMgr->LoadAreaTriggers();
+    // everything after it sees the complete SpellMgr
+    loader.Add("Spell areas", { spellData }, []
+    {
+        sLog->outString("Loading SpellArea Data...");                // must be after quest load
+        sSpellMgr->LoadSpellAreas();
+    });
 
-    sLog->outString("Loading Area Trigger Teleport definitions...");
-    sObjectMgr->LoadAreaTriggerTeleports();
+    loader.Add("Area triggers", {}, []
+    {
+        sLog->outString("Loading Area Trigger definitions");
+        sObjectMgr->LoadAreaTriggers();
+    });
 
-    sLog->outString("Loading Access Requirements...");
-    sObjectMgr->LoadAccessRequirements();                        // must be after item template load
+    loader.Add("Area trigger teleports", {}, []
+    {
+        sLog->outString("Loading Area Trigger Teleport definitions...");
+        sObjectMgr->LoadAreaTriggerTeleports();
+    });
 
-    sLog->outString("Loading Quest Area Triggers...");
-    sObjectMgr->LoadQuestAreaTriggers();                         // must be after LoadQuests
+    loader.Add("Access requirements", {}, []
+    {
+        sLog->outString("Loading Access Requirements...");
+        sObjectMgr->LoadAccessRequirements();                        // must be after item template load
+    });
 
-    sLog->outString("Loading Tavern Area Triggers...");
-    sObjectMgr->LoadTavernAreaTriggers();
+    loader.Add("Quest area triggers", {}, []
+    {
+        sLog->outString("Loading Quest Area Triggers...");
+        sObjectMgr->LoadQuestAreaTriggers();                         // must be after LoadQuests
+    });
 
-    sLog->outString("Loading AreaTrigger script names...");
-    sObjectMgr->LoadAreaTriggerScripts();
+    loader.Add("Tavern area triggers", {}, []
+    {
+        sLog->outString("Loading Tavern Area Triggers...");
+        sObjectMgr->LoadTavernAreaTriggers();
+    });
 
-    sLog->outString("Loading LFG entrance positions..."); // Must be after areatriggers
-    sLFGMgr->LoadLFGDungeons();
+    loader.Add("Area trigger script names", {}, []
+    {
+        sLog->outString("Loading AreaTrigger script names...");
+        sObjectMgr->LoadAreaTriggerScripts();
+    });
 
-    sLog->outString("Loading Dungeon boss data...");
-    sObjectMgr->LoadInstanceEncounters();
+    loader.Add("LFG dungeons", {}, []
+    {
+        sLog->outString("Loading LFG entrance positions..."); // Must be after areatriggers
+        sLFGMgr->LoadLFGDungeons();
+    });
 
-    sLog->outString("Loading LFG rewards...");
-    sLFGMgr->LoadRewards();
+    loader.Add("Dungeon boss data", {}, []
+    {
+        sLog->outString("Loading Dungeon boss data...");
+        sObjectMgr->LoadInstanceEncounters();
+    });
 
-    sLog->outString("Loading Graveyard-zone links...");
-    sGraveyard->LoadGraveyardZones();
+    loader.Add("LFG rewards", {}, []
+    {
+        sLog->outString("Loading LFG rewards...");
+        sLFGMgr->LoadRewards();
+    });
 
-    sLog->outString("Loading spell pet auras...");
-    sSpellMgr->LoadSpellPetAuras();
+    loader.Add("Graveyard zones", {}, []
+    {
+        sLog->outString("Loading Graveyard-zone links...");
+        sGraveyard->LoadGraveyardZones();
+    });
 
-    sLog->outString("Loading Spell target coordinates...");
-    sSpellMgr->LoadSpellTargetPositions();
+    loader.AddExclusive("Player create data", {}, []
+    {
+        sLog->outString("Loading Player Create Data...");
+        sObjectMgr->LoadPlayerInfo();
+    });
 
-    sLog->outString("Loading enchant custom attributes...");
-    sSpellMgr->LoadEnchantCustomAttr();
+    loader.Add("Exploration base XP", {}, []
+    {
+        sLog->outString("Loading Exploration BaseXP Data...");
+        sObjectMgr->LoadExplorationBaseXP();
+    });
 
-    sLog->outString("Loading linked spells...");
-    sSpellMgr->LoadSpellLinked();
+    loader.Add("Pet name parts", {}, []
+    {
+        sLog->outString("Loading Pet Name Parts...");
+        sObjectMgr->LoadPetNames();
+    });
 
-    sLog->outString("Loading Player Create Data...");
-    sObjectMgr->LoadPlayerInfo();
+    loader.Add("Character database cleanup", {}, []
+    {
+        CharacterDatabaseCleaner::CleanDatabase();
+    });
 
-    sLog->outString("Loading Exploration BaseXP Data...");
-    sObjectMgr->LoadExplorationBaseXP();
+    loader.Add("Max pet number", {}, []
+    {
+        sLog->outString("Loading the max pet number...");
+        sObjectMgr->LoadPetNumber();
+    });
 
-    sLog->outString("Loading Pet Name Parts...");
-    sObjectMgr->LoadPetNames();
+    loader.AddExclusive("Pet level stats", {}, []
+    {
+        sLog->outString("Loading pet level stats...");
+        sObjectMgr->LoadPetLevelInfo();
+    });
 
-    CharacterDatabaseCleaner::CleanDatabase();
+    loader.Add("Player corpses", {}, []
+    {
+        sLog->outString("Loading Player Corpses...");
+        sObjectMgr->LoadCorpses();
+    });
 
-    sLog->outString("Loading the max pet number...");
-    sObjectMgr->LoadPetNumber();
+    loader.Add("Mail level rewards", {}, []
+    {
+        sLog->outString("Loading Player level dependent mail rewards...");
+        sObjectMgr->LoadMailLevelRewards();
+    });
 
-    sLog->outString("Loading pet level stats...");
-    sObjectMgr->LoadPetLevelInfo();
+    // Loot tables, each store only checks the templates it belongs to
+    uint32 lootStartTime = 0;
+    StartupLoader::TaskId lootStart = loader.AddParallel("Loot tables", { itemTemplates, creatureTemplates, gameObjectTemplates }, [&lootStartTime]
+    {
+        sLog->outString("Loading Loot Tables...");
+        lootStartTime = getMSTime();
+    });
 
-    sLog->outString("Loading Player Corpses...");
-    sObjectMgr->LoadCorpses();
+    std::vector<StartupLoader::TaskId> lootStores;
+    std::vector<StartupLoader::TaskId> const lootDependencies = { lootStart };
+    lootStores.push_back(loader.AddParallel("Creature loot", lootDependencies, [] { LoadLootTemplates_Creature(); }));
+    lootStores.push_back(loader.AddParallel("Fishing loot", lootDependencies, [] { LoadLootTemplates_Fishing(); }));
+    lootStores.push_back(loader.AddParallel("GameObject loot", lootDependencies, [] { LoadLootTemplates_Gameobject(); }));
+    lootStores.push_back(loader.AddParallel("Item loot", lootDependencies, [] { LoadLootTemplates_Item(); }));
+    lootStores.push_back(loader.AddParallel("Mail loot", lootDependencies, [] { LoadLootTemplates_Mail(); }));
+    lootStores.push_back(loader.AddParallel("Milling loot", lootDependencies, [] { LoadLootTemplates_Milling(); }));
+    lootStores.push_back(loader.AddParallel("Pickpocketing loot", lootDependencies, [] { LoadLootTemplates_Pickpocketing(); }));
+    lootStores.push_back(loader.AddParallel("Skinning loot", lootDependencies, [] { LoadLootTemplates_Skinning(); }));
+    lootStores.push_back(loader.AddParallel("Disenchant loot", lootDependencies, [] { LoadLootTemplates_Disenchant(); }));
+    lootStores.push_back(loader.AddParallel("Prospecting loot", lootDependencies, [] { LoadLootTemplates_Prospecting(); }));
+    lootStores.push_back(loader.AddParallel("Spell loot", lootDependencies, [] { LoadLootTemplates_Spell(); }));
 
-    sLog->outString("Loading Player level dependent mail rewards...");
-    sObjectMgr->LoadMailLevelRewards();
+    // checks the references of all other stores
+    StartupLoader::TaskId lootReferences = loader.AddParallel("Reference loot", lootStores, [&lootStartTime]
+    {
+        LoadLootTemplates_Reference();
+        sLog->outString(">> Loot Tables loaded in %u ms", GetMSTimeDiffToNow(lootStartTime));
+        sLog->outString();
+    });
 
-    // Loot tables
-    LoadLootTables();
+    loader.Add("Skill discovery", {}, []
+    {
+        sLog->outString("Loading Skill Discovery Table...");
+        LoadSkillDiscoveryTable();
+    });
 
-    sLog->outString("Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
+    loader.Add("Skill extra items", {}, []
+    {
+        sLog->outString("Loading Skill Extra Item Table...");
+        LoadSkillExtraItemTable();
+    });
 
-    sLog->outString("Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
+    loader.Add("Skill perfection items", {}, []
+    {
+        sLog->outString("Loading Skill Perfection Data Table...");
+        LoadSkillPerfectItemTable();
+    });
 
-    sLog->outString("Loading Skill Perfection Data Table...");
-    LoadSkillPerfectItemTable();
+    loader.Add("Fishing base skill levels", {}, []
+    {
+        sLog->outString("Loading Skill Fishing base level requirements...");
+        sObjectMgr->LoadFishingBaseSkillLevel();
+    });
 
-    sLog->outString("Loading Skill Fishing base level requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
+    loader.Add("Achievements", {}, []
+    {
+        sLog->outString("Loading Achievements...");
+        sAchievementMgr->LoadAchievementReferenceList();
+        sLog->outString("Loading Achievement Criteria Lists...");
+        sAchievementMgr->LoadAchievementCriteriaList();
+        sLog->outString("Loading Achievement Criteria Data...");
+        sAchievementMgr->LoadAchievementCriteriaData();
+        sLog->outString("Loading Achievement Rewards...");
+        sAchievementMgr->LoadRewards();
+        sLog->outString("Loading Achievement Reward Locales...");
+        sAchievementMgr->LoadRewardLocales();
+    });
 
-    sLog->outString("Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
-    sLog->outString("Loading Achievement Criteria Lists...");
-    sAchievementMgr->LoadAchievementCriteriaList();
-    sLog->outString("Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
-    sLog->outString("Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
-    sLog->outString("Loading Achievement Reward Locales...");
-    sAchievementMgr->LoadRewardLocales();
-    sLog->outString("Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
+    StartupLoader::TaskId completedAchievements = loader.Add("Completed achievements", {}, []
+    {
+        sLog->outString("Loading Completed Achievements...");
+        sAchievementMgr->LoadCompletedAchievements();
+    });
 
     ///- Load dynamic data tables from the database
-    sLog->outString("Loading Item Auctions...");
-    sAuctionMgr->LoadAuctionItems();
-    sLog->outString("Loading Auctions...");
-    sAuctionMgr->LoadAuctions();
+    // the character database has its own connections, these run next to the world loaders below
+    StartupLoader::TaskId characterData = loader.AddParallel("Auctions", { completedAchievements, itemLocales }, []
+    {
+        sLog->outString("Loading Item Auctions...");
+        sAuctionMgr->LoadAuctionItems();
+        sLog->outString("Loading Auctions...");
+        sAuctionMgr->LoadAuctions();
+    });
 
-    sGuildMgr->LoadGuilds();
+    characterData = loader.AddParallel("Guilds", { characterData }, []
+    {
+        sGuildMgr->LoadGuilds();
+    });
 
-    sLog->outString("Loading ArenaTeams...");
-    sArenaTeamMgr->LoadArenaTeams();
+    characterData = loader.AddParallel("Arena teams", { characterData }, []
+    {
+        sLog->outString("Loading ArenaTeams...");
+        sArenaTeamMgr->LoadArenaTeams();
+    });
 
-    sLog->outString("Loading Groups...");
-    sGroupMgr->LoadGroups();
+    characterData = loader.AddParallel("Groups", { characterData }, []
+    {
+        sLog->outString("Loading Groups...");
+        sGroupMgr->LoadGroups();
+    });
 
-    sLog->outString("Loading ReservedNames...");
-    sObjectMgr->LoadReservedPlayersNames();
+    loader.Add("Reserved names", {}, []
+    {
+        sLog->outString("Loading ReservedNames...");
+        sObjectMgr->LoadReservedPlayersNames();
+    });
 
-    sLog->outString("Loading GameObjects for quests...");
-    sObjectMgr->LoadGameObjectForQuests();
+    loader.Add("GameObjects for quests", { lootReferences }, []
+    {
+        sLog->outString("Loading GameObjects for quests...");
+        sObjectMgr->LoadGameObjectForQuests();
+    });
 
-    sLog->outString("Loading BattleMasters...");
-    sBattlegroundMgr->LoadBattleMastersEntry();
+    loader.Add("Battlemasters", {}, []
+    {
+        sLog->outString("Loading BattleMasters...");
+        sBattlegroundMgr->LoadBattleMastersEntry();
+    });
 
-    sLog->outString("Loading GameTeleports...");
-    sObjectMgr->LoadGameTele();
+    loader.Add("Game teleports", {}, []
+    {
+        sLog->outString("Loading GameTeleports...");
+        sObjectMgr->LoadGameTele();
+    });
 
-    sLog->outString("Loading Gossip menu...");
-    sObjectMgr->LoadGossipMenu();
+    loader.Add("Gossip menus", {}, []
+    {
+        sLog->outString("Loading Gossip menu...");
+        sObjectMgr->LoadGossipMenu();
+    });
 
-    sLog->outString("Loading Gossip menu options...");
-    sObjectMgr->LoadGossipMenuItems();
+    loader.Add("Gossip menu options", {}, []
+    {
+        sLog->outString("Loading Gossip menu options...");
+        sObjectMgr->LoadGossipMenuItems();
+    });
 
-    sLog->outString("Loading Vendors...");
-    sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
+    loader.Add("Vendors", {}, []
+    {
+        sLog->outString("Loading Vendors...");
+        sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
+    });
 
-    sLog->outString("Loading Trainers...");
-    sObjectMgr->LoadTrainerSpell();                              // must be after load CreatureTemplate
+    loader.Add("Trainers", {}, []
+    {
+        sLog->outString("Loading Trainers...");
+        sObjectMgr->LoadTrainerSpell();                              // must be after load CreatureTemplate
+    });
 
-    sLog->outString("Loading Waypoints...");
-    sWaypointMgr->Load();
+    loader.Add("Waypoints", {}, []
+    {
+        sLog->outString("Loading Waypoints...");
+        sWaypointMgr->Load();
+    });
 
-    sLog->outString("Loading SmartAI Waypoints...");
-    sSmartWaypointMgr->LoadFromDB();
+    loader.Add("SmartAI waypoints", {}, []
+    {
+        sLog->outString("Loading SmartAI Waypoints...");
+        sSmartWaypointMgr->LoadFromDB();
+    });
 
-    sLog->outString("Loading Creature Formations...");
-    sFormationMgr->LoadCreatureFormations();
+    loader.Add("Creature formations", {}, []
+    {
+        sLog->outString("Loading Creature Formations...");
+        sFormationMgr->LoadCreatureFormations();
+    });
 
-    sLog->outString("Loading World States...");              // must be loaded before battleground, outdoor PvP and conditions
-    LoadWorldStates();
+    loader.Add("World states", {}, [this]
+    {
+        sLog->outString("Loading World States...");              // must be loaded before battleground, outdoor PvP and conditions
+        LoadWorldStates();
+    });
 
-    sLog->outString("Loading Conditions...");
-    sConditionMgr->LoadConditions();
+    // fills the conditions into the loot templates
+    loader.Add("Conditions", { lootReferences }, []
+    {
+        sLog->outString("Loading Conditions...");
+        sConditionMgr->LoadConditions();
+    });
 
-    sLog->outString("Loading faction change achievement pairs...");
-    sObjectMgr->LoadFactionChangeAchievements();
+    loader.Add("Faction change pairs", {}, []
+    {
+        sLog->outString("Loading faction change achievement pairs...");
+        sObjectMgr->LoadFactionChangeAchievements();
 
-    sLog->outString("Loading faction change spell pairs...");
-    sObjectMgr->LoadFactionChangeSpells();
+        sLog->outString("Loading faction change spell pairs...");
+        sObjectMgr->LoadFactionChangeSpells();
 
-    sLog->outString("Loading faction change item pairs...");
-    sObjectMgr->LoadFactionChangeItems();
+        sLog->outString("Loading faction change item pairs...");
+        sObjectMgr->LoadFactionChangeItems();
 
-    sLog->outString("Loading faction change reputation pairs...");
-    sObjectMgr->LoadFactionChangeReputations();
+        sLog->outString("Loading faction change reputation pairs...");
+        sObjectMgr->LoadFactionChangeReputations();
 
-    sLog->outString("Loading faction change title pairs...");
-    sObjectMgr->LoadFactionChangeTitles();
+        sLog->outString("Loading faction change title pairs...");
+        sObjectMgr->LoadFactionChangeTitles();
 
-    sLog->outString("Loading faction change quest pairs...");
-    sObjectMgr->LoadFactionChangeQuests();
+        sLog->outString("Loading faction change quest pairs...");
+        sObjectMgr->LoadFactionChangeQuests();
+    });
 
-    sLog->outString("Loading GM tickets...");
-    sTicketMgr->LoadTickets();
+    loader.Add("GM tickets", {}, []
+    {
+        sLog->outString("Loading GM tickets...");
+        sTicketMgr->LoadTickets();
 
-    sLog->outString("Loading GM surveys...");
-    sTicketMgr->LoadSurveys();
+        sLog->outString("Loading GM surveys...");
+        sTicketMgr->LoadSurveys();
+    });
 
-    sLog->outString("Loading client addons...");
-    AddonMgr::LoadFromDB();
+    loader.Add("Client addons", {}, []
+    {
+        sLog->outString("Loading client addons...");
+        AddonMgr::LoadFromDB();
+    });
 
+    // auctions, guilds and groups load their items first
     // pussywizard:
-    sLog->outString("Deleting invalid mail items...");
-    sLog->outString();
-    CharacterDatabase.Query("DELETE mi FROM mail_items mi LEFT JOIN item_instance ii ON mi.item_guid = ii.guid WHERE ii.guid IS NULL");
-    CharacterDatabase.Query("DELETE mi FROM mail_items mi LEFT JOIN mail m ON mi.mail_id = m.id WHERE m.id IS NULL");
-    CharacterDatabase.Query("UPDATE mail m LEFT JOIN mail_items mi ON m.id = mi.mail_id SET m.has_items=0 WHERE m.has_items<>0 AND mi.mail_id IS NULL");
+    loader.Add("Invalid mail items", { characterData }, []
+    {
+        sLog->outString("Deleting invalid mail items...");
+        sLog->outString();
+        CharacterDatabase.Query("DELETE mi FROM mail_items mi LEFT JOIN item_instance ii ON mi.item_guid = ii.guid WHERE ii.guid IS NULL");
+        CharacterDatabase.Query("DELETE mi FROM mail_items mi LEFT JOIN mail m ON mi.mail_id = m.id WHERE m.id IS NULL");
+        CharacterDatabase.Query("UPDATE mail m LEFT JOIN mail_items mi ON m.id = mi.mail_id SET m.has_items=0 WHERE m.has_items<>0 AND mi.mail_id IS NULL");
+    });
 
     ///- Handle outdated emails (delete/return)
-    sLog->outString("Returning old mails...");
-    sLog->outString();
-    sObjectMgr->ReturnOrDeleteOldMails(false);
+    loader.Add("Old mails", {}, []
+    {
+        sLog->outString("Returning old mails...");
+        sLog->outString();
+        sObjectMgr->ReturnOrDeleteOldMails(false);
+    });
 
     ///- Load AutoBroadCast
-    sLog->outString("Loading Autobroadcasts...");
-    LoadAutobroadcasts();
+    loader.Add("Autobroadcasts", {}, [this]
+    {
+        sLog->outString("Loading Autobroadcasts...");
+        LoadAutobroadcasts();
+    });
 
     ///- Load and initialize scripts
-    sObjectMgr->LoadSpellScripts();                              // must be after load Creature/Gameobject(Template/Data)
-    sObjectMgr->LoadEventScripts();                              // must be after load Creature/Gameobject(Template/Data)
-    sObjectMgr->LoadWaypointScripts();
+    loader.Add("Spell, event and waypoint scripts", {}, []
+    {
+        sObjectMgr->LoadSpellScripts();                              // must be after load Creature/Gameobject(Template/Data)
+        sObjectMgr->LoadEventScripts();                              // must be after load Creature/Gameobject(Template/Data)
+        sObjectMgr->LoadWaypointScripts();
+    });
 
-    sLog->outString("Loading spell script names...");
-    sObjectMgr->LoadSpellScriptNames();
+    loader.Add("Spell script names", {}, []
+    {
+        sLog->outString("Loading spell script names...");
+        sObjectMgr->LoadSpellScriptNames();
+    });
 
-    sLog->outString("Loading Creature Texts...");
-    sCreatureTextMgr->LoadCreatureTexts();
+    loader.Add("Creature texts", {}, []
+    {
+        sLog->outString("Loading Creature Texts...");
+        sCreatureTextMgr->LoadCreatureTexts();
+    });
 
-    sLog->outString("Loading Creature Text Locales...");
-    sCreatureTextMgr->LoadCreatureTextLocales();
+    loader.Add("Creature text locales", {}, []
+    {
+        sLog->outString("Loading Creature Text Locales...");
+        sCreatureTextMgr->LoadCreatureTextLocales();
+    });
 
-    sLog->outString("Loading Scripts...");
-    sScriptMgr->LoadDatabase();
+    loader.Add("Scripts", {}, []
+    {
+        sLog->outString("Loading Scripts...");
+        sScriptMgr->LoadDatabase();
+    });
 
-    sLog->outString("Validating spell scripts...");
-    sObjectMgr->ValidateSpellScripts();
+    loader.Add("Spell script validation", {}, []
+    {
+        sLog->outString("Validating spell scripts...");
+        sObjectMgr->ValidateSpellScripts();
+    });
 
-    sLog->outString("Loading SmartAI scripts...");
-    sSmartScriptMgr->LoadSmartAIFromDB();
+    loader.Add("SmartAI scripts", {}, []
+    {
+        sLog->outString("Loading SmartAI scripts...");
+        sSmartScriptMgr->LoadSmartAIFromDB();
+    });
 
-    sLog->outString("Loading Calendar data...");
-    sCalendarMgr->LoadFromDB();
+    loader.Add("Calendar", {}, []
+    {
+        sLog->outString("Loading Calendar data...");
+        sCalendarMgr->LoadFromDB();
+    });
 
-    sLog->outString("Initializing SpellInfo precomputed data..."); // must be called after loading items, professions, spells and pretty much anything
-    sLog->outString();
-    sObjectMgr->InitializeSpellInfoPrecomputedData();
+    loader.Add("SpellInfo precomputed data", {}, []
+    {
+        sLog->outString("Initializing SpellInfo precomputed data..."); // must be called after loading items, professions, spells and pretty much anything
+        sLog->outString();
+        sObjectMgr->InitializeSpellInfoPrecomputedData();
+    });
+
+    loader.Run(m_int_configs[CONFIG_STARTUP_LOADER_THREADS]);
 
     ///- Initialize game time and timers
     sLog->outString("Initialize game time and timers");
@@ -2086,6 +2521,8 @@ void World::SetInitialWorldSettings()
         }
     }
 
+    loader.PrintTimings();
+
     uint32 startupDuration = GetMSTimeDiffToNow(startupBegin);
     sLog->outString();
     sLog->outError("WORLD: World initialized in %u minutes %u seconds", (startupDuration / 60000), ((startupDuration % 60000) / 1000)); // outError for red color in console
@@ -2390,6 +2827,7 @@ void World::ForceGameEventUpdate()
 /// Send a packet to all players (except self if mentioned)
 void World::SendGlobalMessage(WorldPacket* packet, WorldSession* self, TeamId teamId)
 {
+    SharedPacket sharedPacket(packet);
     SessionMap::const_iterator itr;
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
@@ -2399,7 +2837,7 @@ void World::SendGlobalMessage(WorldPacket* packet, WorldSession* self, TeamId te
                 itr->second != self &&
                 (teamId == TEAM_NEUTRAL || itr->second->GetPlayer()->GetTeamId() == teamId))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(sharedPacket);
         }
     }
 }
@@ -15,11 +15,18 @@ EndScriptData */
 #include "Chat.h"
 #include "Config.h"
 #include "GitRevision.h"
+#include "GridMapPreloader.h"
 #include "Language.h"
+#include "LFGQueue.h"
+#include "MapManager.h"
 #include "ObjectAccessor.h"
+#include "PacketBufferPool.h"
+#include "PathCache.h"
 #include "Player.h"
+#include "SavingSystem.h"
 #include "ScriptMgr.h"
 #include "ServerMotd.h"
+#include "UpdateData.h"
 
 class server_commandscript : public CommandScript
 {
@@ -112,7 +119,34 @@ public:
         if (handler->GetSession())
             if (Player* p = handler->GetSession()->GetPlayer())
                 if (p->IsDeveloper())
+                {
                     handler->PSendSysMessage("DEV wavg: %ums, nsmax: %ums, nsavg: %ums. LFG avg: %ums, max: %ums.", avgDiffTracker.getTimeWeightedAverage(), devDiffTracker.getMax(), devDiffTracker.getAverage(), lfgDiffTracker.getAverage(), lfgDiffTracker.getMax());
+                    if (sMapMgr->GetMapUpdater()->activated())
+                    {
+                        MapUpdateTiming slowest = sMapMgr->GetMapUpdater()->last_tick_slowest();
+                        handler->PSendSysMessage("DEV slowest map update last tick: map %u, instance %u, %uus.", slowest.mapId, slowest.instanceId, slowest.updateTime);
+                    }
+                    PacketBufferPoolStats poolStats = PacketBufferPool::GetStats();
+                    handler->PSendSysMessage("DEV packet buffer pool: " UI64FMTD " hits, " UI64FMTD " misses, " UI64FMTD " oversized.", poolStats.hits, poolStats.misses, poolStats.oversized);
+                    UpdateCompressionStats compressionStats = UpdateData::GetCompressionStats();
+                    handler->PSendSysMessage("DEV update compression: " UI64FMTD " packets (" UI64FMTD " uncompressed), " UI64FMTD " KB saved, " UI64FMTD " ms spent.",
+                        compressionStats.compressedPackets, compressionStats.uncompressedPackets, (compressionStats.bytesIn - compressionStats.bytesOut) / 1024, compressionStats.compressTime / 1000);
+                    PlayerSaveStats saveStats = SavingSystemMgr::GetPlayerSaveStats();
+                    handler->PSendSysMessage("DEV player saves: " UI64FMTD " saves, " UI64FMTD " bytes/save, " UI64FMTD " statements/save, " UI64FMTD " unchanged tables skipped.",
+                        saveStats.saves, saveStats.saves ? saveStats.bytes / saveStats.saves : 0, saveStats.saves ? saveStats.statements / saveStats.saves : 0, saveStats.unchangedTables);
+                    GridPreloadStats preloadStats = sGridMapPreloader->GetStats();
+                    handler->PSendSysMessage("DEV grid preload: " UI64FMTD " requested, " UI64FMTD " used, " UI64FMTD " discarded, " UI64FMTD " ms loading. Map thread loads: " UI64FMTD ", " UI64FMTD " ms.",
+                        preloadStats.requested, preloadStats.used, preloadStats.discarded, preloadStats.preloadTime / 1000, preloadStats.syncLoads, preloadStats.syncLoadTime);
+                    PathCacheStats pathStats = PathCache::GetStats();
+                    handler->PSendSysMessage("DEV path cache: " UI64FMTD " hits, " UI64FMTD " misses (" UI64FMTD " invalidated), " UI64FMTD " evicted.",
+                        pathStats.hits, pathStats.misses, pathStats.invalidated, pathStats.evicted);
+                    lfg::LfgMatchStats matchStats = lfg::LFGQueue::GetMatchStats();
+                    uint64 matchAvg[lfg::LFG_MATCH_STATS_BUCKETS];
+                    for (uint8 i = 0; i < lfg::LFG_MATCH_STATS_BUCKETS; ++i)
+                        matchAvg[i] = matchStats.matches[i] ? matchStats.time[i] / matchStats.matches[i] : 0;
+                    handler->PSendSysMessage("DEV lfg matching avg by queued groups: <100: " UI64FMTD "us, <250: " UI64FMTD "us, <500: " UI64FMTD "us, <1000: " UI64FMTD "us, more: " UI64FMTD "us. Slowest: %uus with %u queued, %u compatibles. " UI64FMTD " checks.",
+                        matchAvg[0], matchAvg[1], matchAvg[2], matchAvg[3], matchAvg[4], matchStats.maxTime, matchStats.maxTimeQueued, matchStats.maxTimeCompatibles, matchStats.checks);
+                }
 
         //! Can't use sWorld->ShutdownMsg here in case of console command
         if (sWorld->IsShuttingDown())
@@ -0,0 +1,388 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "DBCImage.h"
+#include "DBCFileLoader.h"
+#include "Errors.h"
+#include "Log.h"
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    char const DBCImageMagic[4] = { 'A', 'C', 'D', 'I' };
+    uint32 const DBCImageVersion = 1;
+
+    // far from the heap and the shared libraries, so it is usually free and the image needs no relocation
+    uint64 const DBCImageBaseAddress = sizeof(void*) == 8 ? UI64LIT(0x3E0000000000) : UI64LIT(0x50000000);
+
+    uint64 const FNVOffsetBasis = UI64LIT(14695981039346656037);
+    uint64 const FNVPrime = UI64LIT(1099511628211);
+
+    // offsets of the char* fields in the records of a format
+    std::vector<uint32> GetStringFieldOffsets(char const* format)
+    {
+        std::vector<uint32> offsets;
+        uint32 offset = 0;
+        for (; *format; ++format)
+        {
+            switch (*format)
+            {
+                case FT_FLOAT:
+                case FT_IND:
+                case FT_INT:
+                    offset += sizeof(uint32);
+                    break;
+                case FT_BYTE:
+                    offset += sizeof(uint8);
+                    break;
+                case FT_STRING:
+                    offsets.push_back(offset);
+                    offset += sizeof(char*);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        return offsets;
+    }
+
+    // the payload is a multiple of 8 bytes, hashed a word at a time
+    uint64 GetChecksum(char const* data, size_t size)
+    {
+        uint64 checksum = FNVOffsetBasis;
+        for (size_t i = 0; i + sizeof(uint64) <= size; i += sizeof(uint64))
+        {
+            uint64 word;
+            memcpy(&word, data + i, sizeof(word));
+            checksum = (checksum ^ word) * FNVPrime;
+        }
+
+        return checksum;
+    }
+
+    void MovePointer(char* slot, intptr_t delta)
+    {
+        uintptr_t value;
+        memcpy(&value, slot, sizeof(value));
+        if (!value)
+            return;
+
+        value += delta;
+        memcpy(slot, &value, sizeof(value));
+    }
+}
+
+DBCImageHash::DBCImageHash() : _value(FNVOffsetBasis)
+{
+}
+
+void DBCImageHash::Add(void const* data, size_t size)
+{
+    uint8 const* bytes = static_cast<uint8 const*>(data);
+    for (size_t i = 0; i < size; ++i)
+        _value = (_value ^ bytes[i]) * FNVPrime;
+}
+
+void DBCImageHash::AddFile(std::string const& path)
+{
+    struct stat fileStat;
+    if (stat(path.c_str(), &fileStat) != 0)
+    {
+        Add(uint64(0));
+        return;
+    }
+
+    Add(uint64(1));
+    Add(uint64(fileStat.st_size));
+    Add(uint64(fileStat.st_mtime));
+}
+
+DBCImage::DBCImage() : _mapping(nullptr), _mappingSize(0), _delta(0)
+{
+}
+
+DBCImage::~DBCImage()
+{
+    Close();
+}
+
+bool DBCImage::Open(std::string const& path, uint64 sourceHash)
+{
+    Close();
+
+    void* view = nullptr;
+    size_t size = 0;
+
+    // private copy on write mapping, the stores are fixed up and changed after loading
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || size_t(fileSize.QuadPart) < sizeof(DBCImageHeader))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+        return false;
+
+    // the view keeps the mapping alive
+    view = MapViewOfFileEx(mapping, FILE_MAP_COPY, 0, 0, 0, reinterpret_cast<void*>(uintptr_t(DBCImageBaseAddress)));
+    if (!view)
+        view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+
+    CloseHandle(mapping);
+    if (!view)
+        return false;
+
+    size = size_t(fileSize.QuadPart);
+#else
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        return false;
+
+    struct stat fileStat;
+    if (fstat(file, &fileStat) != 0 || size_t(fileStat.st_size) < sizeof(DBCImageHeader))
+    {
+        close(file);
+        return false;
+    }
+
+    // only a hint, an address in use gets another mapping and the image is relocated
+    view = mmap(reinterpret_cast<void*>(uintptr_t(DBCImageBaseAddress)), size_t(fileStat.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+    close(file);
+    if (view == MAP_FAILED)
+        return false;
+
+    size = size_t(fileStat.st_size);
+#endif
+
+    _mapping = static_cast<char*>(view);
+    _mappingSize = size;
+
+    DBCImageHeader header;
+    memcpy(&header, _mapping, sizeof(header));
+
+    if (memcmp(header.Magic, DBCImageMagic, sizeof(header.Magic)) || header.Version != DBCImageVersion || header.PointerSize != sizeof(char*))
+    {
+        sLog->outString("DBC cache %s was written by another version, rebuilding it.", path.c_str());
+        Close();
+        return false;
+    }
+
+    if (header.SourceHash != sourceHash)
+    {
+        sLog->outString("DBC cache %s is outdated (dbc files or *_dbc tables changed), rebuilding it.", path.c_str());
+        Close();
+        return false;
+    }
+
+    if (header.FileSize != _mappingSize || header.DirectoryOffset + uint64(header.StoreCount) * sizeof(DBCImageStore) > _mappingSize ||
+        header.Checksum != GetChecksum(_mapping + sizeof(DBCImageHeader), _mappingSize - sizeof(DBCImageHeader)))
+    {
+        sLog->outError("DBC cache %s is damaged, rebuilding it.", path.c_str());
+        Close();
+        return false;
+    }
+
+    _delta = intptr_t(reinterpret_cast<uintptr_t>(_mapping) - uintptr_t(header.BaseAddress));
+
+    DBCImageStore const* stores = reinterpret_cast<DBCImageStore const*>(_mapping + header.DirectoryOffset);
+    for (uint32 i = 0; i < header.StoreCount; ++i)
+        _stores[_mapping + stores[i].NameOffset] = &stores[i];
+
+    return true;
+}
+
+void DBCImage::Close()
+{
+    if (!_mapping)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(_mapping);
+#else
+    munmap(_mapping, _mappingSize);
+#endif
+
+    _mapping = nullptr;
+    _mappingSize = 0;
+    _delta = 0;
+    _stores.clear();
+}
+
+char** DBCImage::GetIndexTable(char const* name, char const* format, uint32& indexTableSize, uint32& fieldCount)
+{
+    auto itr = _stores.find(name);
+    if (itr == _stores.end())
+        return nullptr;
+
+    DBCImageStore const& store = *itr->second;
+    if (strcmp(_mapping + store.FormatOffset, format) || store.RecordSize != DBCFileLoader::GetFormatRecordSize(format))
+        return nullptr;
+
+    // every store is handed out once, its pointers are moved only once
+    _stores.erase(itr);
+
+    if (_delta)
+        Relocate(store, format);
+
+    indexTableSize = store.IndexTableSize;
+    fieldCount = store.FieldCount;
+    return reinterpret_cast<char**>(_mapping + store.IndexTableOffset);
+}
+
+void DBCImage::Relocate(DBCImageStore const& store, char const* format)
+{
+    char* indexTable = _mapping + store.IndexTableOffset;
+    for (uint32 i = 0; i < store.IndexTableSize; ++i)
+        MovePointer(indexTable + i * sizeof(char*), _delta);
+
+    std::vector<uint32> stringFields = GetStringFieldOffsets(format);
+    if (stringFields.empty())
+        return;
+
+    char* record = _mapping + store.RecordsOffset;
+    for (uint32 i = 0; i < store.RecordCount; ++i, record += store.RecordSize)
+        for (uint32 offset : stringFields)
+            MovePointer(record + offset, _delta);
+}
+
+DBCImageWriter::DBCImageWriter()
+{
+}
+
+void DBCImageWriter::AddStore(char const* name, char const* format, uint32 fieldCount, char* const* indexTable, uint32 indexTableSize)
+{
+    uint32 recordSize = DBCFileLoader::GetFormatRecordSize(format);
+    std::vector<uint32> stringFields = GetStringFieldOffsets(format);
+
+    // index tables may point to one record more than once, it is stored once
+    std::unordered_map<char const*, uint32> recordIds;
+    std::vector<char const*> records;
+    for (uint32 i = 0; i < indexTableSize; ++i)
+        if (indexTable[i] && recordIds.emplace(indexTable[i], uint32(records.size())).second)
+            records.push_back(indexTable[i]);
+
+    DBCImageStore store;
+    store.NameOffset = AddString(name);
+    store.FormatOffset = AddString(format);
+
+    // strings first, their offsets are written into the records
+    for (char const* record : records)
+    {
+        for (uint32 offset : stringFields)
+        {
+            char const* str;
+            memcpy(&str, record + offset, sizeof(str));
+            if (str)
+                AddString(str);
+        }
+    }
+
+    Align();
+    store.IndexTableOffset = sizeof(DBCImageHeader) + _data.size();
+    store.RecordsOffset = store.IndexTableOffset + uint64(indexTableSize) * sizeof(char*);
+    store.IndexTableSize = indexTableSize;
+    store.RecordCount = uint32(records.size());
+    store.RecordSize = recordSize;
+    store.FieldCount = fieldCount;
+
+    _data.resize(store.RecordsOffset - sizeof(DBCImageHeader) + uint64(records.size()) * recordSize);
+
+    char* indexData = &_data[store.IndexTableOffset - sizeof(DBCImageHeader)];
+    for (uint32 i = 0; i < indexTableSize; ++i)
+    {
+        uintptr_t value = indexTable[i] ? uintptr_t(DBCImageBaseAddress + store.RecordsOffset + uint64(recordIds[indexTable[i]]) * recordSize) : 0;
+        memcpy(indexData + i * sizeof(char*), &value, sizeof(value));
+    }
+
+    char* recordData = &_data[store.RecordsOffset - sizeof(DBCImageHeader)];
+    for (char const* record : records)
+    {
+        memcpy(recordData, record, recordSize);
+        for (uint32 offset : stringFields)
+        {
+            char const* str;
+            memcpy(&str, record + offset, sizeof(str));
+            uintptr_t value = str ? uintptr_t(DBCImageBaseAddress + _strings[str]) : 0;
+            memcpy(recordData + offset, &value, sizeof(value));
+        }
+
+        recordData += recordSize;
+    }
+
+    _stores.push_back(store);
+}
+
+bool DBCImageWriter::Write(std::string const& path, uint64 sourceHash)
+{
+    Align();
+
+    DBCImageHeader header;
+    memcpy(header.Magic, DBCImageMagic, sizeof(header.Magic));
+    header.Version = DBCImageVersion;
+    header.PointerSize = sizeof(char*);
+    header.StoreCount = uint32(_stores.size());
+    header.SourceHash = sourceHash;
+    header.BaseAddress = DBCImageBaseAddress;
+    header.DirectoryOffset = sizeof(DBCImageHeader) + _data.size();
+
+    char const* directory = reinterpret_cast<char const*>(_stores.data());
+    _data.insert(_data.end(), directory, directory + _stores.size() * sizeof(DBCImageStore));
+
+    header.FileSize = sizeof(DBCImageHeader) + _data.size();
+    header.Checksum = GetChecksum(_data.data(), _data.size());
+
+    // written next to the old image and moved over it, a running server never sees half of it
+    std::string tempPath = path + ".tmp";
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if (!file)
+        return false;
+
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(_data.data(), _data.size(), 1, file) == 1;
+    written = fclose(file) == 0 && written;
+
+    remove(path.c_str());
+    if (!written || rename(tempPath.c_str(), path.c_str()) != 0)
+    {
+        remove(tempPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+uint64 DBCImageWriter::AddString(char const* str)
+{
+    auto itr = _strings.find(str);
+    if (itr != _strings.end())
+        return itr->second;
+
+    uint64 offset = sizeof(DBCImageHeader) + _data.size();
+    _data.insert(_data.end(), str, str + strlen(str) + 1);
+    _strings[str] = offset;
+    return offset;
+}
+
+void DBCImageWriter::Align()
+{
+    _data.resize((_data.size() + 7) & ~size_t(7));
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef DBCIMAGE_H
+#define DBCIMAGE_H
+
+#include "Define.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Binary cache of the loaded data stores (DBC files with the locale strings and the *_dbc table overrides merged in).
+ *
+ * The image holds the index table and the records of every store the way DBCStorage uses them in memory, strings
+ * included, with all pointers written for a fixed base address. It is mapped copy-on-write at that address when it
+ * is free, then the stores use it as it is. Otherwise the pointers are moved by the difference once per store, which
+ * is still only a pass over the string fields.
+ *
+ * Images are only used when their source hash matches (see DBCImageHash): it covers the store formats and the size
+ * and modification time of every dbc file, plus the checksums of the override tables.
+ */
+
+// FNV-1a over the sources of an image
+class DBCImageHash
+{
+public:
+    DBCImageHash();
+
+    void Add(void const* data, size_t size);
+    void Add(std::string const& str) { Add(str.c_str(), str.size() + 1); }
+    void Add(uint64 value) { Add(&value, sizeof(value)); }
+    // size and modification time, or only that it is missing
+    void AddFile(std::string const& path);
+
+    [[nodiscard]] uint64 GetValue() const { return _value; }
+
+private:
+    uint64 _value;
+};
+
+struct DBCImageHeader
+{
+    char Magic[4];
+    uint32 Version;
+    uint32 PointerSize;
+    uint32 StoreCount;
+    uint64 SourceHash;
+    uint64 BaseAddress;         // address the pointers were written for
+    uint64 FileSize;
+    uint64 DirectoryOffset;     // StoreCount DBCImageStore entries
+    uint64 Checksum;            // of everything after the header
+};
+
+struct DBCImageStore
+{
+    uint64 NameOffset;          // offsets are from the start of the image
+    uint64 FormatOffset;
+    uint64 IndexTableOffset;
+    uint64 RecordsOffset;
+    uint32 IndexTableSize;
+    uint32 RecordCount;
+    uint32 RecordSize;
+    uint32 FieldCount;
+};
+
+class DBCImage
+{
+public:
+    DBCImage();
+    ~DBCImage();
+
+    // maps the image when it is valid for these sources, the stores keep pointing into it until Close
+    bool Open(std::string const& path, uint64 sourceHash);
+    void Close();
+
+    [[nodiscard]] bool IsOpen() const { return _mapping != nullptr; }
+    [[nodiscard]] bool IsRelocated() const { return _delta != 0; }
+
+    // index table of the store, nullptr if the image has no matching store
+    char** GetIndexTable(char const* name, char const* format, uint32& indexTableSize, uint32& fieldCount);
+
+private:
+    void Relocate(DBCImageStore const& store, char const* format);
+
+    char* _mapping;
+    size_t _mappingSize;
+    intptr_t _delta;            // mapping address - base address of the image
+    std::unordered_map<std::string, DBCImageStore const*> _stores;
+
+    DBCImage(DBCImage const& right) = delete;
+    DBCImage& operator=(DBCImage const& right) = delete;
+};
+
+class DBCImageWriter
+{
+public:
+    DBCImageWriter();
+
+    // copies the store, later changes to the records are not part of the image
+    void AddStore(char const* name, char const* format, uint32 fieldCount, char* const* indexTable, uint32 indexTableSize);
+    bool Write(std::string const& path, uint64 sourceHash);
+
+    [[nodiscard]] uint32 GetStoreCount() const { return uint32(_stores.size()); }
+
+private:
+    uint64 AddString(char const* str);
+    void Align();
+
+    std::vector<char> _data;    // everything after the header
+    std::vector<DBCImageStore> _stores;
+    std::unordered_map<std::string, uint64> _strings;
+};
+
+#endif
@@ -5,9 +5,10 @@
  */
 
 #include "DBCDatabaseLoader.h"
+#include "DBCImage.h"
 #include "DBCStore.h"
 
-DBCStorageBase::DBCStorageBase(char const* fmt) : _fieldCount(0), _fileFormat(fmt), _dataTable(nullptr), _indexTableSize(0)
+DBCStorageBase::DBCStorageBase(char const* fmt) : _fieldCount(0), _fileFormat(fmt), _dataTable(nullptr), _indexTableSize(0), _imageBacked(false)
 {
 }
 
@@ -64,3 +65,16 @@ void DBCStorageBase::LoadFromDB(char const* table, char const* format, char**& i
 {
     _stringPool.push_back(DBCDatabaseLoader(table, format, _stringPool).Load(_indexTableSize, indexTable));
 }
+
+bool DBCStorageBase::LoadFromImage(DBCImage& image, char const* name, char**& indexTable)
+{
+    // records and strings stay in the image, there is nothing to parse or free
+    indexTable = image.GetIndexTable(name, _fileFormat, _indexTableSize, _fieldCount);
+    _imageBacked = indexTable != nullptr;
+    return _imageBacked;
+}
+
+void DBCStorageBase::WriteToImage(DBCImageWriter& writer, char const* name, char* const* indexTable) const
+{
+    writer.AddStore(name, _fileFormat, _fieldCount, indexTable, _indexTableSize);
+}
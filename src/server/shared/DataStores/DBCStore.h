@@ -127,6 +127,9 @@ struct FlyByCamera
     G3D::Vector4 locations;
 };
 
+class DBCImage;
+class DBCImageWriter;
+
 /// Interface class for common access
 class DBCStorageBase
 {
@@ -140,17 +143,22 @@ public:
     virtual bool Load(char const* path) = 0;
     virtual bool LoadStringsFrom(char const* path) = 0;
     virtual void LoadFromDB(char const* table, char const* format) = 0;
+    virtual bool LoadFromImage(DBCImage& image, char const* name) = 0;
+    virtual void WriteToImage(DBCImageWriter& writer, char const* name) const = 0;
 
 protected:
     bool Load(char const* path, char**& indexTable);
     bool LoadStringsFrom(char const* path, char** indexTable);
     void LoadFromDB(char const* table, char const* format, char**& indexTable);
+    bool LoadFromImage(DBCImage& image, char const* name, char**& indexTable);
+    void WriteToImage(DBCImageWriter& writer, char const* name, char* const* indexTable) const;
 
     uint32 _fieldCount;
     char const* _fileFormat;
     char* _dataTable;
     std::vector<char*> _stringPool;
     uint32 _indexTableSize;
+    bool _imageBacked;              // index table and records are in a mapped DBCImage
 };
 
 template <class T>
@@ -166,7 +174,8 @@ public:
 
     ~DBCStorage() override
     {
-        delete[] reinterpret_cast<char*>(_indexTable.AsT);
+        if (!_imageBacked)
+            delete[] reinterpret_cast<char*>(_indexTable.AsT);
     }
 
     [[nodiscard]] T const* LookupEntry(uint32 id) const { return (id >= _indexTableSize) ? nullptr : _indexTable.AsT[id]; }
@@ -183,8 +192,10 @@ public:
             ptr* newArr = new ptr[newSize];
             memset(newArr, 0, newSize * sizeof(ptr));
             memcpy(newArr, _indexTable.AsChar, _indexTableSize * sizeof(ptr));
-            delete[] reinterpret_cast<char*>(_indexTable.AsT);
+            if (!_imageBacked)
+                delete[] reinterpret_cast<char*>(_indexTable.AsT);
             _indexTable.AsChar = newArr;
+            _imageBacked = false;
             _indexTableSize = newSize;
         }
 
@@ -210,6 +221,16 @@ public:
         DBCStorageBase::LoadFromDB(table, format, _indexTable.AsChar);
     }
 
+    bool LoadFromImage(DBCImage& image, char const* name) override
+    {
+        return DBCStorageBase::LoadFromImage(image, name, _indexTable.AsChar);
+    }
+
+    void WriteToImage(DBCImageWriter& writer, char const* name) const override
+    {
+        DBCStorageBase::WriteToImage(writer, name, _indexTable.AsChar);
+    }
+
     iterator begin() { return iterator(_indexTable.AsT, _indexTableSize); }
     iterator end() { return iterator(_indexTable.AsT, _indexTableSize, _indexTableSize); }
 
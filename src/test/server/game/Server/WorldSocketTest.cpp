@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "Opcodes.h"
+#include "SharedPacket.h"
+#include "WorldSocket.h"
+#include "gtest/gtest.h"
+#include <ace/Message_Block.h>
+#include <ace/Message_Queue.h>
+
+TEST(WorldSocketTest, GetQueueBlockSize)
+{
+    EXPECT_EQ(WorldSocket::GetQueueBlockSize(4, true), 4u);
+    EXPECT_EQ(WorldSocket::GetQueueBlockSize(5, true), 5u);
+    EXPECT_EQ(WorldSocket::GetQueueBlockSize(4, false), 4096u);
+    EXPECT_EQ(WorldSocket::GetQueueBlockSize(10000, false), 10000u);
+}
+
+// queued the same way as WorldSocket::SendPacket does it for a shared payload: the header, then the payload block
+TEST(WorldSocketTest, SharedPacketsFitUnderWaterMark)
+{
+    size_t const headerSize = 4;
+    size_t const payloadSize = 1000;
+    size_t const packets = 4000; // 4M of data, 20M if every header took a 4K block
+
+    WorldPacket packet(SMSG_MESSAGECHAT, payloadSize);
+    packet.resize(payloadSize);
+    SharedPacket shared(&packet);
+
+    ACE_Message_Queue<ACE_NULL_SYNCH> queue;
+    queue.high_water_mark(WorldSocket::QueueWaterMark);
+    queue.low_water_mark(WorldSocket::QueueWaterMark);
+
+    char const header[headerSize] = { };
+    for (size_t i = 0; i < packets; ++i)
+    {
+        ACE_Message_Block* mb = new ACE_Message_Block(WorldSocket::GetQueueBlockSize(headerSize, true));
+        ASSERT_EQ(mb->copy(header, headerSize), 0);
+        ASSERT_NE(queue.enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero), -1) << "header of packet " << i;
+
+        mb = shared.CreatePayloadBlock();
+        ASSERT_NE(queue.enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero), -1) << "payload of packet " << i;
+    }
+
+    EXPECT_EQ(queue.message_bytes(), packets * (headerSize + payloadSize));
+    EXPECT_LT(queue.message_bytes(), WorldSocket::QueueWaterMark);
+
+    queue.flush();
+}
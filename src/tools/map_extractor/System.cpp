@@ -6,11 +6,18 @@
 
 #define _CRT_SECURE_NO_DEPRECATE
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <deque>
 #include <set>
 #include <filesystem>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #ifdef _WIN32
 #include "direct.h"
@@ -44,7 +51,7 @@
 #else
 #define OPEN_FLAGS (O_RDONLY | O_BINARY)
 #endif
-extern ArchiveSet gOpenArchives;
+extern thread_local ArchiveSet gOpenArchives;
 
 typedef struct
 {
@@ -81,6 +88,8 @@ float CONF_float_to_int16_limit = 2048.0f;   // Max accuracy = val/65536
 float CONF_flat_height_delta_limit = 0.005f; // If max - min less this value - surface is flat
 float CONF_flat_liquid_delta_limit = 0.001f; // If max - min less this value - liquid surface is flat
 
+unsigned int CONF_threads = std::max(1u, std::thread::hardware_concurrency());
+
 // List MPQ for extract from
 const char* CONF_mpq_list[] =
 {
@@ -144,6 +153,7 @@ void Usage(char* prg)
         "-o set output path\n"\
         "-e extract only MAP(1)/DBC(2)/Camera(4) - standard: all(7)\n"\
         "-f height stored as int (less map size but lost some accuracy) 1 by default\n"\
+        "-t number of threads converting map tiles, standard: number of cpu cores\n"\
         "Example: %s -f 0 -i \"c:\\games\\game\"", prg, prg);
     exit(1);
 }
@@ -157,6 +167,7 @@ void HandleArgs(int argc, char* arg[])
         // e - extract only MAP(1)/DBC(2) - standard both(3)
         // f - use float to int conversion
         // h - limit minimum height
+        // t - map tile threads
         if (arg[c][0] != '-')
         {
             Usage(arg[0]);
@@ -208,6 +219,16 @@ void HandleArgs(int argc, char* arg[])
                     Usage(arg[0]);
                 }
                 break;
+            case 't':
+                if (c + 1 < argc)                           // all ok
+                {
+                    CONF_threads = std::max(1, atoi(arg[(c++) + 1]));
+                }
+                else
+                {
+                    Usage(arg[0]);
+                }
+                break;
         }
     }
 }
@@ -373,32 +394,27 @@ float selectUInt16StepStore(float maxDiff)
 {
     return 65535 / maxDiff;
 }
-// Temporary grid data store
-uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-
-float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint16 uint16_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint8  uint8_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-
-uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float liquid_height[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint16 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-
-int16 flight_box_max[3][3];
-int16 flight_box_min[3][3];
-
-bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int /*cell_y*/, int /*cell_x*/, uint32 build)
+// Temporary grid data store, one per thread converting tiles
+thread_local uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+
+thread_local float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint16 uint16_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint8  uint8_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+
+thread_local uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float liquid_height[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint16 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+
+thread_local int16 flight_box_max[3][3];
+thread_local int16 flight_box_min[3][3];
+
+bool ConvertADT(ADT_file& adt, std::string const& inputPath, std::string const& outputPath, uint32 build)
 {
-    ADT_file adt;
-
-    if (!adt.loadFile(inputPath))
-        return false;
-
     adt_MCIN* cells = adt.a_grid->getMCIN();
     if (!cells)
     {
@@ -959,12 +975,90 @@ bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int
     return true;
 }
 
-void ExtractMapsFromMpq(uint32 build)
+void LoadLocaleMPQFiles(int const locale, bool log = true);
+void LoadCommonMPQFiles(bool log = true);
+void CloseMPQFiles();
+
+// Checksums of the adts the existing .map files were converted from, tiles whose adt did not
+// change since the last run are not converted again (client patches only touch a few of them)
+struct MapTileChecksum
 {
-    std::string mpqFileName;
-    std::string outputFileName;
-    std::string mpqMapName;
+    uint64 checksum;
+    uint64 size;        // of the .map file, catches files truncated by an interrupted run
+};
+
+typedef std::unordered_map<std::string, MapTileChecksum> MapTileChecksumContainer;
+
+std::string GetMapTileChecksumFileName()
+{
+    return acore::StringFormat("%s/maps.checksums", output_path);
+}
+
+// 64 bit FNV-1a of the adt, seeded with everything else the conversion depends on
+uint64 GetMapTileChecksum(uint8 const* data, uint32 size, uint32 build)
+{
+    uint64 hash = 14695981039346656037ULL;
+    auto add = [&hash](uint8 const* bytes, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    uint32 const options[] = { build, *reinterpret_cast<uint32 const*>(MAP_VERSION_MAGIC), uint32(CONF_allow_float_to_int), uint32(CONF_allow_height_limit) };
+    add(reinterpret_cast<uint8 const*>(options), sizeof(options));
+    add(data, size);
+    return hash;
+}
+
+MapTileChecksumContainer LoadMapTileChecksums()
+{
+    MapTileChecksumContainer checksums;
+    FILE* file = fopen(GetMapTileChecksumFileName().c_str(), "r");
+    if (!file)
+        return checksums;
+
+    char name[32];
+    unsigned long long checksum, size;
+    // an interrupted run leaves appended lines, the last one of a tile wins
+    while (fscanf(file, "%31s %llx %llu", name, &checksum, &size) == 3)
+        checksums[name] = { uint64(checksum), uint64(size) };
+
+    fclose(file);
+    return checksums;
+}
+
+void SaveMapTileChecksums(MapTileChecksumContainer const& checksums)
+{
+    std::string fileName = GetMapTileChecksumFileName();
+    std::string tempFileName = fileName + ".tmp";
+    FILE* file = fopen(tempFileName.c_str(), "w");
+    if (!file)
+    {
+        printf("Can't create the output file '%s'\n", tempFileName.c_str());
+        return;
+    }
+
+    for (auto const& checksum : checksums)
+        fprintf(file, "%s %016llx %llu\n", checksum.first.c_str(), (unsigned long long)checksum.second.checksum, (unsigned long long)checksum.second.size);
+
+    fclose(file);
 
+    std::error_code error;
+    std::filesystem::rename(tempFileName, fileName, error);
+}
+
+struct MapTileTask
+{
+    uint32 mapIndex;
+    uint32 x;
+    uint32 y;
+};
+
+void ExtractMapsFromMpq(uint32 build, int locale)
+{
     printf("Extracting maps...\n");
 
     uint32 map_count = ReadMapDBC();
@@ -975,34 +1069,97 @@ void ExtractMapsFromMpq(uint32 build)
     path += "/maps/";
     CreateDir(path);
 
-    printf("Convert map files\n");
+    // the tiles of all maps share one queue, continents would keep single threads busy otherwise
+    std::vector<MapTileTask> tasks;
     for (uint32 z = 0; z < map_count; ++z)
     {
-        printf("Extract %s (%d/%u)                  \n", map_ids[z].name, z + 1, map_count);
         // Loadup map grid data
-        mpqMapName = acore::StringFormat(R"(World\Maps\%s\%s.wdt)", map_ids[z].name, map_ids[z].name);
+        std::string mpqMapName = acore::StringFormat(R"(World\Maps\%s\%s.wdt)", map_ids[z].name, map_ids[z].name);
         WDT_file wdt;
         if (!wdt.loadFile(mpqMapName, false))
-        {
-            //            printf("Error loading %s map wdt data\n", map_ids[z].name);
             continue;
-        }
 
         for (uint32 y = 0; y < WDT_MAP_SIZE; ++y)
-        {
             for (uint32 x = 0; x < WDT_MAP_SIZE; ++x)
+                if (wdt.main->adt_list[y][x].exist)
+                    tasks.push_back({ z, x, y });
+    }
+
+    MapTileChecksumContainer checksums = LoadMapTileChecksums();
+    std::mutex checksumLock;
+    FILE* checksumFile = fopen(GetMapTileChecksumFileName().c_str(), "a");
+    if (!checksumFile)
+        printf("Can't open '%s', tiles converted now will be converted again by the next run\n", GetMapTileChecksumFileName().c_str());
+
+    std::atomic<uint32> nextTask(0);
+    std::atomic<uint32> tasksDone(0);
+    std::atomic<uint32> tasksUpToDate(0);
+
+    auto worker = [&]()
+    {
+        // libmpq is not thread safe, every thread reads through its own archives
+        LoadLocaleMPQFiles(locale, false);
+        LoadCommonMPQFiles(false);
+
+        for (uint32 i = nextTask++; i < tasks.size(); i = nextTask++)
+        {
+            MapTileTask const& task = tasks[i];
+            map_id const& map = map_ids[task.mapIndex];
+            std::string mpqFileName = acore::StringFormat(R"(World\Maps\%s\%s_%u_%u.adt)", map.name, map.name, task.x, task.y);
+            std::string tileName = acore::StringFormat("%03u%02u%02u.map", map.id, task.y, task.x);
+            std::string outputFileName = acore::StringFormat("%s/maps/%s", output_path, tileName.c_str());
+
+            ADT_file adt;
+            if (adt.loadFile(mpqFileName))
             {
-                if (!wdt.main->adt_list[y][x].exist)
-                    continue;
-                mpqFileName = acore::StringFormat(R"(World\Maps\%s\%s_%u_%u.adt)", map_ids[z].name, map_ids[z].name, x, y);
-                outputFileName = acore::StringFormat("%s/maps/%03u%02u%02u.map", output_path, map_ids[z].id, y, x);
-                ConvertADT(mpqFileName, outputFileName, y, x, build);
+                uint64 checksum = GetMapTileChecksum(adt.GetData(), adt.GetDataSize(), build);
+                auto itr = checksums.find(tileName);
+                std::error_code error;
+                if (itr != checksums.end() && itr->second.checksum == checksum && std::filesystem::file_size(outputFileName, error) == itr->second.size && !error)
+                    ++tasksUpToDate;
+                else if (ConvertADT(adt, mpqFileName, outputFileName, build) && checksumFile)
+                {
+                    uint64 size = std::filesystem::file_size(outputFileName, error);
+                    if (!error)
+                    {
+                        std::lock_guard<std::mutex> guard(checksumLock);
+                        fprintf(checksumFile, "%s %016llx %llu\n", tileName.c_str(), (unsigned long long)checksum, (unsigned long long)size);
+                        fflush(checksumFile);
+                    }
+                }
             }
-            // draw progress bar
-            printf("Processing........................%d%%\r", (100 * (y + 1)) / WDT_MAP_SIZE);
+
+            ++tasksDone;
         }
-    }
+
+        CloseMPQFiles();
+    };
+
+    printf("Convert map files (%u tiles, %u threads)\n", uint32(tasks.size()), CONF_threads);
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < CONF_threads; ++i)
+        threads.emplace_back(worker);
+
+    // draw progress bar
+    do
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        printf("Processing........................%u%% (%u up to date)\r", tasks.empty() ? 100 : uint32(tasksDone * 100 / tasks.size()), uint32(tasksUpToDate));
+        fflush(stdout);
+    } while (tasksDone < tasks.size());
+
+    for (std::thread& thread : threads)
+        thread.join();
+
     printf("\n");
+
+    // compact the appended lines of this run into the file
+    if (checksumFile)
+    {
+        fclose(checksumFile);
+        SaveMapTileChecksums(LoadMapTileChecksums());
+    }
+
     delete[] map_ids;
 }
 
@@ -1128,12 +1285,12 @@ void ExtractCameraFiles(int locale, bool basicLocale)
     printf("Extracted %u camera files\n", count);
 }
 
-void LoadLocaleMPQFiles(int const locale)
+void LoadLocaleMPQFiles(int const locale, bool log)
 {
     char filename[512];
 
     sprintf(filename, "%s/Data/%s/locale-%s.MPQ", input_path, langs[locale], langs[locale]);
-    new MPQArchive(filename);
+    new MPQArchive(filename, log);
 
     for (int i = 1; i < 5; ++i)
     {
@@ -1143,11 +1300,11 @@ void LoadLocaleMPQFiles(int const locale)
 
         sprintf(filename, "%s/Data/%s/patch-%s%s.MPQ", input_path, langs[locale], langs[locale], ext);
         if (FileExists(filename))
-            new MPQArchive(filename);
+            new MPQArchive(filename, log);
     }
 }
 
-void LoadCommonMPQFiles()
+void LoadCommonMPQFiles(bool log)
 {
     char filename[512];
     int count = sizeof(CONF_mpq_list) / sizeof(char*);
@@ -1155,11 +1312,11 @@ void LoadCommonMPQFiles()
     {
         sprintf(filename, "%s/Data/%s", input_path, CONF_mpq_list[i]);
         if (FileExists(filename))
-            new MPQArchive(filename);
+            new MPQArchive(filename, log);
     }
 }
 
-inline void CloseMPQFiles()
+void CloseMPQFiles()
 {
     for (auto & gOpenArchive : gOpenArchives) gOpenArchive->close();
     gOpenArchives.clear();
@@ -1238,7 +1395,7 @@ int main(int argc, char* arg[])
         LoadCommonMPQFiles();
 
         // Extract maps
-        ExtractMapsFromMpq(build);
+        ExtractMapsFromMpq(build, FirstLocale);
 
         // Close MPQs
         CloseMPQFiles();
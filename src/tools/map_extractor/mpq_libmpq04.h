@@ -22,7 +22,7 @@ class MPQArchive
 public:
     mpq_archive_s* mpq_a;
 
-    MPQArchive(const char* filename);
+    MPQArchive(const char* filename, bool log = true);
     ~MPQArchive() { close(); }
     void close();
 
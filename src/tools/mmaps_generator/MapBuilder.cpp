@@ -192,27 +192,58 @@ namespace MMAP
     /**************************************************************************/
     void MapBuilder::buildAllMaps(unsigned int threads)
     {
-        printf("Using %u threads to extract mmaps\n", threads);
-
-        for (unsigned int i = 0; i < threads; ++i)
+        if (!threads)
         {
-            _workerThreads.emplace_back(&MapBuilder::WorkerThread, this);
+            for (auto & m_tile : m_tiles)
+                if (!shouldSkipMap(m_tile.m_mapId))
+                    buildMap(m_tile.m_mapId);
+            return;
         }
 
+        printf("Using %u threads to extract mmaps\n", threads);
+
         m_tiles.sort([](MapTiles a, MapTiles b)
         {
             return a.m_tiles->size() > b.m_tiles->size();
         });
 
+        // the .mmap files are written here, each worker builds its own navmesh from the params
         for (auto & m_tile : m_tiles)
         {
             uint32 mapId = m_tile.m_mapId;
-            if (!shouldSkipMap(mapId))
+            if (shouldSkipMap(mapId) || m_tile.m_tiles->empty())
+                continue;
+
+            dtNavMesh* navMesh = nullptr;
+            buildNavMesh(mapId, navMesh);
+            if (!navMesh)
             {
-                if (threads > 0)
-                    _queue.Push(mapId);
-                else
-                    buildMap(mapId);
+                printf("[Map %03i] Failed creating navmesh!\n", mapId);
+                continue;
+            }
+
+            m_navMeshParams[mapId] = *navMesh->getParams();
+            dtFreeNavMesh(navMesh);
+        }
+
+        for (unsigned int i = 0; i < threads; ++i)
+        {
+            _workerThreads.emplace_back(&MapBuilder::WorkerThread, this);
+        }
+
+        // biggest maps first, their tiles are queued in order so workers mostly stay on one map
+        for (auto & m_tile : m_tiles)
+        {
+            uint32 mapId = m_tile.m_mapId;
+            if (m_navMeshParams.find(mapId) == m_navMeshParams.end())
+                continue;
+
+            printf("[Map %03i] We have %u tiles.                          \n", mapId, (unsigned int)m_tile.m_tiles->size());
+            for (uint32 tile : *m_tile.m_tiles)
+            {
+                uint32 tileX, tileY;
+                StaticMapTree::unpackTileID(tile, tileX, tileY);
+                _queue.Push(TileInfo(mapId, tileX, tileY));
             }
         }
 
@@ -378,17 +409,37 @@ namespace MMAP
 
     void MapBuilder::WorkerThread()
     {
+        // dtNavMesh is not thread safe, every worker adds its tiles to its own one
+        dtNavMesh* navMesh = nullptr;
+        uint32 navMeshMapId = 0;
+
         while (true)
         {
-            uint32 mapId = 0;
+            TileInfo tileInfo;
 
-            _queue.WaitAndPop(mapId);
+            _queue.WaitAndPop(tileInfo);
 
             if (_cancelationToken)
-                return;
+                break;
+
+            if (!navMesh || navMeshMapId != tileInfo.m_mapId)
+            {
+                dtFreeNavMesh(navMesh);
+                navMesh = dtAllocNavMesh();
+                navMeshMapId = tileInfo.m_mapId;
+                if (!navMesh->init(&m_navMeshParams.at(navMeshMapId)))
+                {
+                    printf("[Map %03i] Failed creating navmesh!                \n", navMeshMapId);
+                    dtFreeNavMesh(navMesh);
+                    navMesh = nullptr;
+                    continue;
+                }
+            }
 
-            buildMap(mapId);
+            buildTileIfNeeded(tileInfo.m_mapId, tileInfo.m_tileX, tileInfo.m_tileY, navMesh);
         }
+
+        dtFreeNavMesh(navMesh);
     }
 
     /**************************************************************************/
@@ -424,17 +475,12 @@ namespace MMAP
             printf("[Map %03i] We have %u tiles.                          \n", mapID, (unsigned int)tiles->size());
             for (unsigned int tile : *tiles)
             {
-                // percentageDone - increment tiles built
-                m_totalTilesBuilt++;
                 uint32 tileX, tileY;
 
                 // unpack tile coords
                 StaticMapTree::unpackTileID(tile, tileX, tileY);
 
-                if (shouldSkipTile(mapID, tileX, tileY))
-                    continue;
-
-                buildTile(mapID, tileX, tileY, navMesh);
+                buildTileIfNeeded(mapID, tileX, tileY, navMesh);
             }
 
             dtFreeNavMesh(navMesh);
@@ -443,6 +489,18 @@ namespace MMAP
         printf("[Map %03i] Complete!\n", mapID);
     }
 
+    /**************************************************************************/
+    void MapBuilder::buildTileIfNeeded(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
+    {
+        // percentageDone - increment tiles built
+        m_totalTilesBuilt++;
+
+        if (shouldSkipTile(mapID, tileX, tileY))
+            return;
+
+        buildTile(mapID, tileX, tileY, navMesh);
+    }
+
     /**************************************************************************/
     void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
     {
@@ -43,6 +43,17 @@ namespace MMAP
 
     typedef std::list<MapTiles> TileList;
 
+    // one mmtile to build, the unit of work of the worker threads
+    struct TileInfo
+    {
+        TileInfo() : m_mapId(uint32(-1)), m_tileX(0), m_tileY(0) {}
+        TileInfo(uint32 mapId, uint32 tileX, uint32 tileY) : m_mapId(mapId), m_tileX(tileX), m_tileY(tileY) {}
+
+        uint32 m_mapId;
+        uint32 m_tileX;
+        uint32 m_tileY;
+    };
+
     struct Tile
     {
         Tile()  {}
@@ -83,6 +94,7 @@ namespace MMAP
         void buildSingleTile(uint32 mapID, uint32 tileX, uint32 tileY);
 
         // builds list of maps, then builds all of mmap tiles (based on the skip settings)
+        // the tiles of all maps share one queue, so big continents are spread over all threads
         void buildAllMaps(unsigned int threads);
 
         void WorkerThread();
@@ -95,6 +107,8 @@ namespace MMAP
         void buildNavMesh(uint32 mapID, dtNavMesh*& navMesh);
 
         void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
+        // skips tiles already built by a previous run, see shouldSkipTile
+        void buildTileIfNeeded(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
 
         // move map building
         void buildMoveMapTile(uint32 mapID,
@@ -135,8 +149,11 @@ namespace MMAP
         // build performance - not really used for now
         rcContext* m_rcContext{nullptr};
 
+        // navmesh params of the maps queued by buildAllMaps, filled before the worker threads start
+        std::map<uint32, dtNavMeshParams> m_navMeshParams;
+
         std::vector<std::thread> _workerThreads;
-        ProducerConsumerQueue<uint32> _queue;
+        ProducerConsumerQueue<TileInfo> _queue;
         std::atomic<bool> _cancelationToken;
     };
 }
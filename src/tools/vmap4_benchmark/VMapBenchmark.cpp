@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+// Compares the vmap ray kernels (see RayKernels.h) on extracted tiles:
+// line of sight and height queries inside one tile, the per triangle test is the reference.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "IVMapManager.h"
+#include "RayKernels.h"
+#include "VMapManager2.h"
+
+namespace
+{
+    float const GridSize = 533.3333f;
+    int const CenterGrid = 32;
+
+    struct Query
+    {
+        float x1, y1, z1;
+        float x2, y2, z2;
+    };
+
+    struct Result
+    {
+        double losTime;     // ms
+        double heightTime;  // ms
+        uint32 blocked;
+        std::vector<bool> los;
+        std::vector<float> heights;
+    };
+
+    Result Run(VMAP::VMapManager2& manager, uint32 mapId, std::vector<Query> const& queries)
+    {
+        Result result;
+        result.blocked = 0;
+        result.los.reserve(queries.size());
+        result.heights.reserve(queries.size());
+
+        auto start = std::chrono::steady_clock::now();
+        for (Query const& query : queries)
+        {
+            bool los = manager.isInLineOfSight(mapId, query.x1, query.y1, query.z1, query.x2, query.y2, query.z2);
+            result.los.push_back(los);
+            if (!los)
+                ++result.blocked;
+        }
+        result.losTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (Query const& query : queries)
+            result.heights.push_back(manager.getHeight(mapId, query.x1, query.y1, query.z1, 50.0f));
+        result.heightTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        return result;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 5)
+    {
+        std::cout << "usage: " << argv[0] << " <vmaps dir> <map id> <grid x> <grid y> [queries = 100000]" << std::endl;
+        return 1;
+    }
+
+    std::string path = argv[1];
+    uint32 mapId = uint32(atoi(argv[2]));
+    int gx = atoi(argv[3]);
+    int gy = atoi(argv[4]);
+    uint32 count = argc > 5 ? uint32(atoi(argv[5])) : 100000;
+
+    VMAP::VMapManager2 manager;
+    if (manager.loadMap(path.c_str(), mapId, gx, gy) != VMAP::VMAP_LOAD_RESULT_OK)
+    {
+        std::cout << "could not load tile " << gx << ", " << gy << " of map " << mapId << " from " << path << std::endl;
+        return 1;
+    }
+
+    // world coordinates covered by the grid, the same way Map computes grids from positions
+    float const maxX = (CenterGrid - gx) * GridSize;
+    float const maxY = (CenterGrid - gy) * GridSize;
+
+    // queries start and end on the model surfaces of the tile, like units standing on them
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> posX(maxX - GridSize, maxX);
+    std::uniform_real_distribution<float> posY(maxY - GridSize, maxY);
+    std::uniform_real_distribution<float> offset(-40.0f, 40.0f);
+
+    std::vector<Query> queries;
+    queries.reserve(count);
+    uint32 attempts = 0;
+    while (queries.size() < count && attempts++ < count * 20)
+    {
+        Query query;
+        query.x1 = posX(random);
+        query.y1 = posY(random);
+        query.z1 = manager.getHeight(mapId, query.x1, query.y1, 2000.0f, 4000.0f);
+        query.x2 = query.x1 + offset(random);
+        query.y2 = query.y1 + offset(random);
+        query.z2 = manager.getHeight(mapId, query.x2, query.y2, 2000.0f, 4000.0f);
+        if (query.z1 <= VMAP_INVALID_HEIGHT || query.z2 <= VMAP_INVALID_HEIGHT)
+            continue;
+
+        query.z1 += 2.0f;
+        query.z2 += 2.0f;
+        queries.push_back(query);
+    }
+
+    if (queries.empty())
+    {
+        std::cout << "no model surfaces found in tile " << gx << ", " << gy << " of map " << mapId << std::endl;
+        return 1;
+    }
+
+    printf("%u queries on map %u grid %d %d, default kernel: %s\n", uint32(queries.size()), mapId, gx, gy, VMAP::GetRayKernelName(VMAP::GetRayKernel()));
+    printf("%-8s %12s %12s %10s %10s\n", "kernel", "los ms", "height ms", "blocked", "mismatch");
+
+    Result reference;
+    for (uint8 kernel = VMAP::RAY_KERNEL_NONE; kernel < VMAP::MAX_RAY_KERNELS; ++kernel)
+    {
+        if (!VMAP::IsRayKernelSupported(VMAP::RayKernel(kernel)))
+            continue;
+
+        VMAP::SetRayKernel(VMAP::RayKernel(kernel));
+        Result result = Run(manager, mapId, queries);
+        if (kernel == VMAP::RAY_KERNEL_NONE)
+            reference = result;
+
+        uint32 mismatch = 0;
+        for (size_t i = 0; i < queries.size(); ++i)
+            if (result.los[i] != reference.los[i] || std::abs(result.heights[i] - reference.heights[i]) > 0.01f)
+                ++mismatch;
+
+        printf("%-8s %12.2f %12.2f %10u %10u\n", VMAP::GetRayKernelName(VMAP::RayKernel(kernel)), result.losTime, result.heightTime, result.blocked, mismatch);
+    }
+
+    manager.unloadMap(mapId, gx, gy);
+    return 0;
+}
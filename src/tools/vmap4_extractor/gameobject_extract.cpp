@@ -36,14 +36,18 @@ bool ExtractSingleModel(std::string& fname)
     output += "/";
     output += name;
 
+    ExtractionGuard guard(output);
+    if (guard.IsDone())
+        return guard.GetResult();
+
     if (FileExists(output.c_str()))
-        return true;
+        return guard.SetResult(true);
 
     Model mdl(originalName);
     if (!mdl.open())
-        return false;
+        return guard.SetResult(false);
 
-    return mdl.ConvertToVMAPModel(output.c_str());
+    return guard.SetResult(mdl.ConvertToVMAPModel(output.c_str()));
 }
 
 void ExtractGameobjectModels()
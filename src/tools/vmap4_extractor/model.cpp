@@ -125,7 +125,7 @@ Vec3D fixCoordSystem(Vec3D const& v)
     return Vec3D(v.x, v.z, -v.y);
 }
 
-void Doodad::Extract(ADT::MDDF const& doodadDef, char const* ModelInstName, uint32 mapID, uint32 tileX, uint32 tileY, FILE* pDirfile)
+void Doodad::Extract(ADT::MDDF const& doodadDef, char const* ModelInstName, uint32 mapID, uint32 tileX, uint32 tileY, DirFileBuffer& dirfile)
 {
     char tempname[1036];
     sprintf(tempname, "%s/%s", szWorkDirWmo, ModelInstName);
@@ -148,27 +148,26 @@ void Doodad::Extract(ADT::MDDF const& doodadDef, char const* ModelInstName, uint
     Vec3D position = fixCoords(doodadDef.Position);
 
     uint16 nameSet = 0;// not used for models
-    uint32 uniqueId = GenerateUniqueObjectId(doodadDef.UniqueId, 0);
     uint32 tcflags = MOD_M2;
     if (tileX == 65 && tileY == 65)
         tcflags |= MOD_WORLDSPAWN;
 
     //write mapID, tileX, tileY, Flags, NameSet, UniqueId, Pos, Rot, Scale, name
-    fwrite(&mapID, sizeof(uint32), 1, pDirfile);
-    fwrite(&tileX, sizeof(uint32), 1, pDirfile);
-    fwrite(&tileY, sizeof(uint32), 1, pDirfile);
-    fwrite(&tcflags, sizeof(uint32), 1, pDirfile);
-    fwrite(&nameSet, sizeof(uint16), 1, pDirfile);
-    fwrite(&uniqueId, sizeof(uint32), 1, pDirfile);
-    fwrite(&position, sizeof(Vec3D), 1, pDirfile);
-    fwrite(&doodadDef.Rotation, sizeof(Vec3D), 1, pDirfile);
-    fwrite(&sc, sizeof(float), 1, pDirfile);
+    dirfile.Write(&mapID, sizeof(uint32));
+    dirfile.Write(&tileX, sizeof(uint32));
+    dirfile.Write(&tileY, sizeof(uint32));
+    dirfile.Write(&tcflags, sizeof(uint32));
+    dirfile.Write(&nameSet, sizeof(uint16));
+    dirfile.WriteUniqueObjectId(doodadDef.UniqueId, 0);
+    dirfile.Write(&position, sizeof(Vec3D));
+    dirfile.Write(&doodadDef.Rotation, sizeof(Vec3D));
+    dirfile.Write(&sc, sizeof(float));
     uint32 nlen = strlen(ModelInstName);
-    fwrite(&nlen, sizeof(uint32), 1, pDirfile);
-    fwrite(ModelInstName, sizeof(char), nlen, pDirfile);
+    dirfile.Write(&nlen, sizeof(uint32));
+    dirfile.Write(ModelInstName, nlen);
 }
 
-void Doodad::ExtractSet(WMODoodadData const& doodadData, ADT::MODF const& wmo, uint32 mapID, uint32 tileX, uint32 tileY, FILE* pDirfile)
+void Doodad::ExtractSet(WMODoodadData const& doodadData, ADT::MODF const& wmo, uint32 mapID, uint32 tileX, uint32 tileY, DirFileBuffer& dirfile)
 {
     if (wmo.DoodadSet >= doodadData.Sets.size())
         return;
@@ -230,22 +229,21 @@ void Doodad::ExtractSet(WMODoodadData const& doodadData, ADT::MODF const& wmo, u
         rotation.y = G3D::toDegrees(rotation.y);
 
         uint16 nameSet = 0;     // not used for models
-        uint32 uniqueId = GenerateUniqueObjectId(wmo.UniqueId, doodadId);
         uint32 tcflags = MOD_M2;
         if (tileX == 65 && tileY == 65)
             tcflags |= MOD_WORLDSPAWN;
 
         //write mapID, tileX, tileY, Flags, NameSet, UniqueId, Pos, Rot, Scale, name
-        fwrite(&mapID, sizeof(uint32), 1, pDirfile);
-        fwrite(&tileX, sizeof(uint32), 1, pDirfile);
-        fwrite(&tileY, sizeof(uint32), 1, pDirfile);
-        fwrite(&tcflags, sizeof(uint32), 1, pDirfile);
-        fwrite(&nameSet, sizeof(uint16), 1, pDirfile);
-        fwrite(&uniqueId, sizeof(uint32), 1, pDirfile);
-        fwrite(&position, sizeof(Vec3D), 1, pDirfile);
-        fwrite(&rotation, sizeof(Vec3D), 1, pDirfile);
-        fwrite(&doodad.Scale, sizeof(float), 1, pDirfile);
-        fwrite(&nlen, sizeof(uint32), 1, pDirfile);
-        fwrite(ModelInstName, sizeof(char), nlen, pDirfile);
+        dirfile.Write(&mapID, sizeof(uint32));
+        dirfile.Write(&tileX, sizeof(uint32));
+        dirfile.Write(&tileY, sizeof(uint32));
+        dirfile.Write(&tcflags, sizeof(uint32));
+        dirfile.Write(&nameSet, sizeof(uint16));
+        dirfile.WriteUniqueObjectId(wmo.UniqueId, doodadId);
+        dirfile.Write(&position, sizeof(Vec3D));
+        dirfile.Write(&rotation, sizeof(Vec3D));
+        dirfile.Write(&doodad.Scale, sizeof(float));
+        dirfile.Write(&nlen, sizeof(uint32));
+        dirfile.Write(ModelInstName, nlen);
     }
 }
@@ -12,6 +12,7 @@
 #include "modelheaders.h"
 #include <vector>
 
+class DirFileBuffer;
 class MPQFile;
 struct WMODoodadData;
 namespace ADT { struct MDDF; struct MODF; }
@@ -43,9 +44,9 @@ public:
 
 namespace Doodad
 {
-    void Extract(ADT::MDDF const& doodadDef, char const* ModelInstName, uint32 mapID, uint32 tileX, uint32 tileY, FILE* pDirfile);
+    void Extract(ADT::MDDF const& doodadDef, char const* ModelInstName, uint32 mapID, uint32 tileX, uint32 tileY, DirFileBuffer& dirfile);
 
-    void ExtractSet(WMODoodadData const& doodadData, ADT::MODF const& wmo, uint32 mapID, uint32 tileX, uint32 tileY, FILE* pDirfile);
+    void ExtractSet(WMODoodadData const& doodadData, ADT::MODF const& wmo, uint32 mapID, uint32 tileX, uint32 tileY, DirFileBuffer& dirfile);
 }
 
 #endif
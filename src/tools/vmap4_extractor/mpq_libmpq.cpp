@@ -8,12 +8,14 @@
 #include <deque>
 #include <cstdio>
 
-ArchiveSet gOpenArchives;
+// libmpq archive handles must not be shared between threads, every worker thread opens its own set
+thread_local ArchiveSet gOpenArchives;
 
-MPQArchive::MPQArchive(const char* filename)
+MPQArchive::MPQArchive(const char* filename, bool log)
 {
     int result = libmpq__archive_open(&mpq_a, filename, -1);
-    printf("Opening %s\n", filename);
+    if (log)
+        printf("Opening %s\n", filename);
     if (result)
     {
         switch (result)
@@ -22,7 +22,7 @@ class MPQArchive
 public:
     mpq_archive_s* mpq_a;
 
-    MPQArchive(const char* filename);
+    MPQArchive(const char* filename, bool log = true);
     void close();
 
     void GetFileListTo(vector<string>& filelist)
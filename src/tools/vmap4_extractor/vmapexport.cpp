@@ -5,11 +5,17 @@
  */
 
 #define _CRT_SECURE_NO_DEPRECATE
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <iostream>
 #include <list>
 #include <map>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <sys/stat.h>
 
@@ -44,7 +50,7 @@
 
 //-----------------------------------------------------------------------------
 
-extern ArchiveSet gOpenArchives;
+extern thread_local ArchiveSet gOpenArchives;
 
 typedef struct
 {
@@ -58,7 +64,9 @@ char output_path[128] = ".";
 char input_path[1024] = ".";
 bool hasInputPathParam = false;
 bool preciseVectorData = false;
+unsigned int extractThreads = std::max(1u, std::thread::hardware_concurrency());
 std::unordered_map<std::string, WMODoodadData> WmoDoodads;
+std::mutex WmoDoodadsLock;
 
 // Constants
 
@@ -71,6 +79,75 @@ uint32 GenerateUniqueObjectId(uint32 clientId, uint16 clientDoodadId)
     return uniqueObjectIds.emplace(std::make_pair(clientId, clientDoodadId), uint32(uniqueObjectIds.size() + 1)).first->second;
 }
 
+WMODoodadData& GetWmoDoodads(std::string const& name)
+{
+    // references to elements of an unordered_map stay valid on insertion
+    std::lock_guard<std::mutex> guard(WmoDoodadsLock);
+    return WmoDoodads[name];
+}
+
+void DirFileBuffer::Write(void const* data, size_t size)
+{
+    char const* bytes = static_cast<char const*>(data);
+    _data.insert(_data.end(), bytes, bytes + size);
+}
+
+void DirFileBuffer::WriteUniqueObjectId(uint32 clientId, uint16 clientDoodadId)
+{
+    _uniqueObjectIds.push_back({ _data.size(), clientId, clientDoodadId });
+    _data.resize(_data.size() + sizeof(uint32));
+}
+
+void DirFileBuffer::Flush(FILE* dirfile)
+{
+    for (UniqueObjectId const& uniqueObjectId : _uniqueObjectIds)
+    {
+        uint32 uniqueId = GenerateUniqueObjectId(uniqueObjectId.ClientId, uniqueObjectId.ClientDoodadId);
+        memcpy(&_data[uniqueObjectId.Offset], &uniqueId, sizeof(uint32));
+    }
+
+    if (!_data.empty())
+        fwrite(_data.data(), 1, _data.size(), dirfile);
+
+    _data.clear();
+    _uniqueObjectIds.clear();
+}
+
+enum ExtractionState
+{
+    EXTRACTION_IN_PROGRESS,
+    EXTRACTION_SUCCEEDED,
+    EXTRACTION_FAILED
+};
+
+std::mutex ExtractionsLock;
+std::condition_variable ExtractionsChanged;
+std::unordered_map<std::string, ExtractionState> Extractions;
+
+ExtractionGuard::ExtractionGuard(std::string fileName) : _fileName(std::move(fileName)), _done(false), _result(false)
+{
+    std::unique_lock<std::mutex> lock(ExtractionsLock);
+    if (Extractions.emplace(_fileName, EXTRACTION_IN_PROGRESS).second)
+        return;
+
+    ExtractionsChanged.wait(lock, [this]() { return Extractions[_fileName] != EXTRACTION_IN_PROGRESS; });
+    _done = true;
+    _result = Extractions[_fileName] == EXTRACTION_SUCCEEDED;
+}
+
+ExtractionGuard::~ExtractionGuard()
+{
+    if (_done)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(ExtractionsLock);
+        Extractions[_fileName] = _result ? EXTRACTION_SUCCEEDED : EXTRACTION_FAILED;
+    }
+
+    ExtractionsChanged.notify_all();
+}
+
 // Local testing functions
 
 bool FileExists(const char* file)
@@ -103,8 +180,12 @@ bool ExtractSingleWmo(std::string& fname)
     fixname2(plain_name, strlen(plain_name));
     sprintf(szLocalFile, "%s/%s", szWorkDirWmo, plain_name);
 
+    ExtractionGuard guard(szLocalFile);
+    if (guard.IsDone())
+        return guard.GetResult();
+
     if (FileExists(szLocalFile))
-        return true;
+        return guard.SetResult(true);
 
     int p = 0;
     // Select root wmo files
@@ -121,7 +202,7 @@ bool ExtractSingleWmo(std::string& fname)
     }
 
     if (p == 3)
-        return true;
+        return guard.SetResult(true);
 
     bool file_ok = true;
     printf("Extracting %s\n", originalName.c_str());
@@ -129,16 +210,16 @@ bool ExtractSingleWmo(std::string& fname)
     if (!froot.open())
     {
         printf("Couldn't open RootWmo!!!\n");
-        return false;
+        return guard.SetResult(false);
     }
     FILE* output = fopen(szLocalFile, "wb");
     if (!output)
     {
         printf("couldn't open %s for writing!\n", szLocalFile);
-        return false;
+        return guard.SetResult(false);
     }
     froot.ConvertToVMAPRootWmo(output);
-    WMODoodadData& doodads = WmoDoodads[plain_name];
+    WMODoodadData& doodads = GetWmoDoodads(plain_name);
     std::swap(doodads, froot.DoodadData);
     int Wmo_nVertices = 0;
     //printf("root has %d groups\n", froot->nGroups);
@@ -154,7 +235,8 @@ bool ExtractSingleWmo(std::string& fname)
             if (ret < 0)
             {
                 printf("Error when formatting string");
-                return false;
+                fclose(output);
+                return guard.SetResult(false);
             }
             //printf("Trying to open groupfile %s\n",groupFileName);
 
@@ -189,37 +271,114 @@ bool ExtractSingleWmo(std::string& fname)
     // Delete the extracted file in the case of an error
     if (!file_ok)
         remove(szLocalFile);
-    return true;
+    return guard.SetResult(true);
 }
 
-void ParsMapFiles()
+void OpenArchives(std::vector<std::string> const& archiveNames, bool log)
 {
+    for (auto & archiveName : archiveNames)
+    {
+        MPQArchive* archive = new MPQArchive(archiveName.c_str(), log);
+        if (gOpenArchives.empty() || gOpenArchives.front() != archive)
+            delete archive;
+    }
+}
+
+void CloseArchives()
+{
+    for (MPQArchive* archive : gOpenArchives)
+    {
+        archive->close();
+        delete archive;
+    }
+
+    gOpenArchives.clear();
+}
+
+void ParsMapFiles(std::vector<std::string> const& archiveNames)
+{
+    struct MapTile
+    {
+        uint32 MapIndex;
+        uint32 X;
+        uint32 Y;
+    };
+
+    // the global wmos of the maps are extracted here, the tiles of all maps share one queue
+    std::vector<DirFileBuffer> mapDirFiles(map_count);
+    std::vector<MapTile> tiles;
     char fn[512];
-    //char id_filename[64];
     for (unsigned int i = 0; i < map_count; ++i)
     {
         sprintf(fn,"World\\Maps\\%s\\%s.wdt", map_ids[i].name, map_ids[i].name);
         WDTFile WDT(fn,map_ids[i].name);
-        if (WDT.init(map_ids[i].id))
+        if (WDT.init(map_ids[i].id, mapDirFiles[i]))
         {
-            printf("Processing Map %u\n[", map_ids[i].id);
-            for (int x = 0; x < 64; ++x)
-            {
-                for (int y = 0; y < 64; ++y)
-                {
-                    if (ADTFile* ADT = WDT.GetMap(x, y))
-                    {
-                        //sprintf(id_filename,"%02u %02u %03u",x,y,map_ids[i].id);//!!!!!!!!!
-                        ADT->init(map_ids[i].id, x, y);
-                        delete ADT;
-                    }
-                }
-                printf("#");
-                fflush(stdout);
-            }
-            printf("]\n");
+            for (uint32 x = 0; x < 64; ++x)
+                for (uint32 y = 0; y < 64; ++y)
+                    tiles.push_back({ i, x, y });
+        }
+    }
+
+    std::vector<DirFileBuffer> tileDirFiles(tiles.size());
+    std::atomic<uint32> nextTile(0);
+    std::atomic<uint32> tilesDone(0);
+
+    auto worker = [&]()
+    {
+        // libmpq is not thread safe, every thread reads through its own archives
+        OpenArchives(archiveNames, false);
+
+        for (uint32 i = nextTile++; i < tiles.size(); i = nextTile++)
+        {
+            MapTile const& tile = tiles[i];
+            char const* mapName = map_ids[tile.MapIndex].name;
+            char adtName[512];
+            snprintf(adtName, sizeof(adtName), R"(World\Maps\%s\%s_%u_%u.adt)", mapName, mapName, tile.X, tile.Y);
+
+            ADTFile ADT(adtName);
+            ADT.init(map_ids[tile.MapIndex].id, tile.X, tile.Y, tileDirFiles[i]);
+            ++tilesDone;
         }
+
+        CloseArchives();
+    };
+
+    printf("Processing %u maps on %u threads\n", map_count, extractThreads);
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < extractThreads; ++i)
+        threads.emplace_back(worker);
+
+    do
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        printf("Processing tiles %u%%\r", tiles.empty() ? 100 : uint32(tilesDone * 100 / tiles.size()));
+        fflush(stdout);
+    } while (tilesDone < tiles.size());
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    printf("\n");
+
+    // same order as the tiles were processed in by a single thread, the unique object ids depend on it
+    std::string dirname = std::string(szWorkDirWmo) + "/dir_bin";
+    FILE* dirfile = fopen(dirname.c_str(), "ab");
+    if (!dirfile)
+    {
+        printf("Can't open dirfile!'%s'\n", dirname.c_str());
+        return;
+    }
+
+    size_t tile = 0;
+    for (unsigned int i = 0; i < map_count; ++i)
+    {
+        mapDirFiles[i].Flush(dirfile);
+        for (; tile < tiles.size() && tiles[tile].MapIndex == i; ++tile)
+            tileDirFiles[tile].Flush(dirfile);
     }
+
+    fclose(dirfile);
 }
 
 void getGamePath()
@@ -387,6 +546,18 @@ bool processArgv(int argc, char** argv, const char* versionString)
         {
             preciseVectorData = true;
         }
+        else if (strcmp("-t", argv[i]) == 0)
+        {
+            if ((i + 1) < argc)
+            {
+                extractThreads = std::max(1, atoi(argv[i + 1]));
+                ++i;
+            }
+            else
+            {
+                result = false;
+            }
+        }
         else
         {
             result = false;
@@ -396,10 +567,11 @@ bool processArgv(int argc, char** argv, const char* versionString)
     if (!result)
     {
         printf("Extract %s.\n", versionString);
-        printf("%s [-?][-s][-l][-d <path>]\n", argv[0]);
+        printf("%s [-?][-s][-l][-d <path>][-t <threads>]\n", argv[0]);
         printf("   -s : (default) small size (data size optimization), ~500MB less vmap data.\n");
         printf("   -l : large size, ~500MB more vmap data. (might contain more details)\n");
         printf("   -d <path>: Path to the vector data source folder.\n");
+        printf("   -t <threads>: Number of threads extracting map tiles, number of cpu cores by default.\n");
         printf("   -? : This message.\n");
     }
     return result;
@@ -451,12 +623,7 @@ int main(int argc, char** argv)
     // prepare archive name list
     std::vector<std::string> archiveNames;
     fillArchiveNameVector(archiveNames);
-    for (auto & archiveName : archiveNames)
-    {
-        MPQArchive* archive = new MPQArchive(archiveName.c_str());
-        if (gOpenArchives.empty() || gOpenArchives.front() != archive)
-            delete archive;
-    }
+    OpenArchives(archiveNames, true);
 
     if (gOpenArchives.empty())
     {
@@ -496,7 +663,7 @@ int main(int argc, char** argv)
         }
 
         delete dbc;
-        ParsMapFiles();
+        ParsMapFiles(archiveNames);
         //nError = ERROR_SUCCESS;
         // Extract models, listed in DameObjectDisplayInfo.dbc
         ExtractGameobjectModels();
@@ -8,8 +8,10 @@
 #define VMAPEXPORT_H
 
 #include "loadlib/loadlib.h"
+#include <cstdio>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace VMAP
 {
@@ -31,6 +33,50 @@ extern std::unordered_map<std::string, WMODoodadData> WmoDoodads;
 
 uint32 GenerateUniqueObjectId(uint32 clientId, uint16 clientDoodadId);
 
+// thread safe access to WmoDoodads, the data of a wmo is complete once ExtractSingleWmo returned for it
+WMODoodadData& GetWmoDoodads(std::string const& name);
+
+// dir_bin records of one tile. Tiles are extracted in parallel, their records are written in map and tile
+// order once all are done, so the unique object ids are the same as when extracting on a single thread.
+class DirFileBuffer
+{
+public:
+    void Write(void const* data, size_t size);
+    // the id is generated by Flush, in the order the records were written
+    void WriteUniqueObjectId(uint32 clientId, uint16 clientDoodadId);
+    void Flush(FILE* dirfile);
+
+private:
+    struct UniqueObjectId
+    {
+        size_t Offset;
+        uint32 ClientId;
+        uint16 ClientDoodadId;
+    };
+
+    std::vector<char> _data;
+    std::vector<UniqueObjectId> _uniqueObjectIds;
+};
+
+// Models and wmos are shared by many tiles: the first thread needing one extracts it, the others
+// wait until it is done and get the same result (spawns read the vertex count back from the file).
+class ExtractionGuard
+{
+public:
+    explicit ExtractionGuard(std::string fileName);
+    ~ExtractionGuard();
+
+    // the file was handled by another call, nothing to do but returning its result
+    [[nodiscard]] bool IsDone() const { return _done; }
+    [[nodiscard]] bool GetResult() const { return _result; }
+    bool SetResult(bool result) { _result = result; return result; }
+
+private:
+    std::string _fileName;
+    bool _done;
+    bool _result;
+};
+
 bool FileExists(const char* file);
 void strToLower(char* str);
 
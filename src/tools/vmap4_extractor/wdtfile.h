@@ -20,7 +20,7 @@ public:
     WDTFile(char* file_name, char* file_name1);
     ~WDTFile(void);
 
-    bool init(uint32 mapId);
+    bool init(uint32 mapId, DirFileBuffer& dirfile);
     ADTFile* GetMap(int x, int z);
 
     std::vector<std::string> _wmoNames;
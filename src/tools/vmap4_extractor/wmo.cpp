@@ -496,7 +496,7 @@ WMOGroup::~WMOGroup()
     delete [] LiquBytes;
 }
 
-void MapObject::Extract(ADT::MODF const& mapObjDef, char const* WmoInstName, uint32 mapID, uint32 tileX, uint32 tileY, FILE* pDirfile)
+void MapObject::Extract(ADT::MODF const& mapObjDef, char const* WmoInstName, uint32 mapID, uint32 tileX, uint32 tileY, DirFileBuffer& dirfile)
 {
     // destructible wmo, do not dump. we can handle the vmap for these
     // in dynamic tree (gameobject vmaps)
@@ -540,22 +540,21 @@ void MapObject::Extract(ADT::MODF const& mapObjDef, char const* WmoInstName, uin
     bounds.max = fixCoords(mapObjDef.Bounds.max);
 
     float scale = 1.0f;
-    uint32 uniqueId = GenerateUniqueObjectId(mapObjDef.UniqueId, 0);
     uint32 flags = MOD_HAS_BOUND;
     if (tileX == 65 && tileY == 65) flags |= MOD_WORLDSPAWN;
     //write mapID, tileX, tileY, Flags, NameSet, UniqueId, Pos, Rot, Scale, Bound_lo, Bound_hi, name
-    fwrite(&mapID, sizeof(uint32), 1, pDirfile);
-    fwrite(&tileX, sizeof(uint32), 1, pDirfile);
-    fwrite(&tileY, sizeof(uint32), 1, pDirfile);
-    fwrite(&flags, sizeof(uint32), 1, pDirfile);
-    fwrite(&mapObjDef.NameSet, sizeof(uint16), 1, pDirfile);
-    fwrite(&uniqueId, sizeof(uint32), 1, pDirfile);
-    fwrite(&position, sizeof(Vec3D), 1, pDirfile);
-    fwrite(&mapObjDef.Rotation, sizeof(Vec3D), 1, pDirfile);
-    fwrite(&scale, sizeof(float), 1, pDirfile);
-    fwrite(&bounds, sizeof(AaBox3D), 1, pDirfile);
+    dirfile.Write(&mapID, sizeof(uint32));
+    dirfile.Write(&tileX, sizeof(uint32));
+    dirfile.Write(&tileY, sizeof(uint32));
+    dirfile.Write(&flags, sizeof(uint32));
+    dirfile.Write(&mapObjDef.NameSet, sizeof(uint16));
+    dirfile.WriteUniqueObjectId(mapObjDef.UniqueId, 0);
+    dirfile.Write(&position, sizeof(Vec3D));
+    dirfile.Write(&mapObjDef.Rotation, sizeof(Vec3D));
+    dirfile.Write(&scale, sizeof(float));
+    dirfile.Write(&bounds, sizeof(AaBox3D));
     uint32 nlen = strlen(WmoInstName);
-    fwrite(&nlen, sizeof(uint32), 1, pDirfile);
-    fwrite(WmoInstName, sizeof(char), nlen, pDirfile);
+    dirfile.Write(&nlen, sizeof(uint32));
+    dirfile.Write(WmoInstName, nlen);
 
 }
@@ -33,6 +33,7 @@ enum MopyFlags
 
 class WMOInstance;
 class WMOManager;
+class DirFileBuffer;
 class MPQFile;
 namespace ADT { struct MODF; }
 
@@ -149,7 +150,7 @@ public:
 
 namespace MapObject
 {
-    void Extract(ADT::MODF const& mapObjDef, char const* WmoInstName, uint32 mapID, uint32 tileX, uint32 tileY, FILE* pDirfile);
+    void Extract(ADT::MODF const& mapObjDef, char const* WmoInstName, uint32 mapID, uint32 tileX, uint32 tileY, DirFileBuffer& dirfile);
 }
 
 #endif